@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define PIXEL_CONVERSION_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PIXEL_CONVERSION_TARGET(x)
+#else
+#include <immintrin.h>
+#define PIXEL_CONVERSION_TARGET(x) __attribute__((target(x)))
+#endif
+#else
+#define PIXEL_CONVERSION_X86 0
+#endif
+
+/**
+ * \brief A module providing pixel format conversions with SIMD kernels and scalar fallbacks.
+ * \remarks 24-bit pixels are tightly packed. Functions taking a byte order argument treat the first byte of each pixel
+ * as red if it's <c>ByteOrder::RGB</c> and as blue if it's <c>ByteOrder::BGR</c>. Buffers mustn't overlap unless noted.
+ */
+namespace PixelConversion
+{
+/**
+ * \brief The order of the color channels in a 24-bit pixel.
+ */
+enum class ByteOrder
+{
+    RGB,
+    BGR,
+};
+
+/**
+ * \brief The instruction set level used by the conversion kernels.
+ */
+enum class Level
+{
+    Scalar,
+    SSSE3,
+    AVX2,
+};
+
+namespace Detail
+{
+inline Level detect_level()
+{
+#if PIXEL_CONVERSION_X86
+#if defined(_MSC_VER)
+    int info[4]{};
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    const bool ssse3 = info[2] & (1 << 9);
+    const bool osxsave = info[2] & (1 << 27);
+    const bool avx = info[2] & (1 << 28);
+
+    bool avx2 = false;
+    if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = info[1] & (1 << 5);
+    }
+
+    return avx2 ? Level::AVX2 : ssse3 ? Level::SSSE3 : Level::Scalar;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2")    ? Level::AVX2
+           : __builtin_cpu_supports("ssse3") ? Level::SSSE3
+                                             : Level::Scalar;
+#endif
+#else
+    return Level::Scalar;
+#endif
+}
+
+inline Level &level_override()
+{
+    static Level level = detect_level();
+    return level;
+}
+
+inline void rgb24_to_rgba32_scalar(const uint8_t *src, uint8_t *dst, const size_t pixels, const uint8_t alpha)
+{
+    for (size_t i = 0; i < pixels; ++i)
+    {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = alpha;
+        src += 3;
+        dst += 4;
+    }
+}
+
+inline void rgba32_to_rgb24_scalar(const uint8_t *src, uint8_t *dst, const size_t pixels)
+{
+    for (size_t i = 0; i < pixels; ++i)
+    {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        src += 4;
+        dst += 3;
+    }
+}
+
+inline void swap_rb24_scalar(const uint8_t *src, uint8_t *dst, const size_t pixels)
+{
+    for (size_t i = 0; i < pixels; ++i)
+    {
+        const uint8_t first = src[0];
+        dst[1] = src[1];
+        dst[0] = src[2];
+        dst[2] = first;
+        src += 3;
+        dst += 3;
+    }
+}
+
+#if PIXEL_CONVERSION_X86
+// Spreads 4 packed 24-bit pixels in the low 12 bytes over 4 32-bit pixels, zeroing the 4th byte.
+#define PIXEL_CONVERSION_RGB24_TO_RGBA32_MASK 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1
+
+// Packs 4 32-bit pixels into the low 12 bytes, zeroing the rest.
+#define PIXEL_CONVERSION_RGBA32_TO_RGB24_MASK 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1
+
+// Swaps the 1st and 3rd byte of 4 packed 24-bit pixels in the low 12 bytes, keeping the rest.
+#define PIXEL_CONVERSION_SWAP_RB24_MASK 2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15
+
+PIXEL_CONVERSION_TARGET("ssse3")
+inline size_t rgb24_to_rgba32_ssse3(const uint8_t *src, uint8_t *dst, const size_t pixels, const uint8_t alpha)
+{
+    const __m128i mask = _mm_setr_epi8(PIXEL_CONVERSION_RGB24_TO_RGBA32_MASK);
+    const __m128i alpha_mask = _mm_set1_epi32((int)((uint32_t)alpha << 24));
+
+    // Each iteration loads 16 bytes but only consumes 12, so stop early enough not to read past the source.
+    size_t i = 0;
+    for (; i + 6 <= pixels; i += 4)
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4),
+                         _mm_or_si128(_mm_shuffle_epi8(in, mask), alpha_mask));
+    }
+    return i;
+}
+
+PIXEL_CONVERSION_TARGET("avx2")
+inline size_t rgb24_to_rgba32_avx2(const uint8_t *src, uint8_t *dst, const size_t pixels, const uint8_t alpha)
+{
+    const __m256i mask =
+        _mm256_setr_epi8(PIXEL_CONVERSION_RGB24_TO_RGBA32_MASK, PIXEL_CONVERSION_RGB24_TO_RGBA32_MASK);
+    const __m256i alpha_mask = _mm256_set1_epi32((int)((uint32_t)alpha << 24));
+
+    // The high lane's load ends 28 bytes into the 24 consumed, so keep 2 pixels of headroom.
+    size_t i = 0;
+    for (; i + 10 <= pixels; i += 8)
+    {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3 + 12));
+        const __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4),
+                            _mm256_or_si256(_mm256_shuffle_epi8(in, mask), alpha_mask));
+    }
+    return i;
+}
+
+PIXEL_CONVERSION_TARGET("ssse3")
+inline size_t rgba32_to_rgb24_ssse3(const uint8_t *src, uint8_t *dst, const size_t pixels)
+{
+    const __m128i mask = _mm_setr_epi8(PIXEL_CONVERSION_RGBA32_TO_RGB24_MASK);
+
+    // Each iteration stores 16 bytes but only produces 12, so stop early enough not to write past the destination.
+    size_t i = 0;
+    for (; i + 6 <= pixels; i += 4)
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 3), _mm_shuffle_epi8(in, mask));
+    }
+    return i;
+}
+
+PIXEL_CONVERSION_TARGET("ssse3")
+inline size_t swap_rb24_ssse3(const uint8_t *src, uint8_t *dst, const size_t pixels)
+{
+    const __m128i mask = _mm_setr_epi8(PIXEL_CONVERSION_SWAP_RB24_MASK);
+
+    // The 4 trailing bytes are stored unchanged and rewritten by the next iteration, which also makes this safe to run
+    // in-place.
+    size_t i = 0;
+    for (; i + 6 <= pixels; i += 4)
+    {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 3), _mm_shuffle_epi8(in, mask));
+    }
+    return i;
+}
+
+PIXEL_CONVERSION_TARGET("avx2")
+inline size_t swap_rb24_avx2(const uint8_t *src, uint8_t *dst, const size_t pixels)
+{
+    const __m256i mask = _mm256_setr_epi8(PIXEL_CONVERSION_SWAP_RB24_MASK, PIXEL_CONVERSION_SWAP_RB24_MASK);
+
+    // Both lanes are loaded before either is stored, and the high lane's 4 trailing bytes are stored unchanged, so
+    // this is safe to run in-place as well.
+    size_t i = 0;
+    for (; i + 10 <= pixels; i += 8)
+    {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3 + 12));
+        const __m256i out = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 3), _mm256_castsi256_si128(out));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 3 + 12), _mm256_extracti128_si256(out, 1));
+    }
+    return i;
+}
+
+#undef PIXEL_CONVERSION_RGB24_TO_RGBA32_MASK
+#undef PIXEL_CONVERSION_RGBA32_TO_RGB24_MASK
+#undef PIXEL_CONVERSION_SWAP_RB24_MASK
+#endif
+
+// BT.601 limited range coefficients in 8.8 fixed point.
+inline uint8_t rgb_to_y(const int r, const int g, const int b)
+{
+    return (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+inline uint8_t rgb_to_u(const int r, const int g, const int b)
+{
+    return (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+inline uint8_t rgb_to_v(const int r, const int g, const int b)
+{
+    return (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+/**
+ * \brief Converts a 24-bit image to planar YUV 4:2:0. Chroma is written through a callback so I420 and NV12 can share
+ * the same loop.
+ */
+template <typename TChromaWriter>
+void rgb24_to_yuv420(const uint8_t *src, const size_t width, const size_t height, const ByteOrder order,
+                     const bool bottom_up, uint8_t *y, const TChromaWriter &write_chroma)
+{
+    const size_t r_index = order == ByteOrder::RGB ? 0 : 2;
+    const size_t b_index = 2 - r_index;
+    const size_t stride = width * 3;
+
+    // Bottom-up sources are walked from their last row, which flips them while converting.
+    const auto src_row = [&](const size_t row) { return src + (bottom_up ? height - 1 - row : row) * stride; };
+
+    for (size_t row = 0; row < height; row += 2)
+    {
+        // Edge pixels are replicated for odd sizes, and only the real ones get a Y sample.
+        const bool has_next_row = row + 1 < height;
+        const uint8_t *src0 = src_row(row);
+        const uint8_t *src1 = has_next_row ? src_row(row + 1) : src0;
+        uint8_t *y0 = y + row * width;
+        uint8_t *y1 = y0 + width;
+
+        for (size_t col = 0; col < width; col += 2)
+        {
+            const bool has_next_col = col + 1 < width;
+            const uint8_t *px[4] = {
+                src0 + col * 3,
+                src0 + (has_next_col ? col + 1 : col) * 3,
+                src1 + col * 3,
+                src1 + (has_next_col ? col + 1 : col) * 3,
+            };
+
+            int r_sum = 0, g_sum = 0, b_sum = 0;
+            uint8_t luma[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                const int r = px[i][r_index];
+                const int g = px[i][1];
+                const int b = px[i][b_index];
+                r_sum += r;
+                g_sum += g;
+                b_sum += b;
+                luma[i] = rgb_to_y(r, g, b);
+            }
+
+            y0[col] = luma[0];
+            if (has_next_col) y0[col + 1] = luma[1];
+            if (has_next_row)
+            {
+                y1[col] = luma[2];
+                if (has_next_col) y1[col + 1] = luma[3];
+            }
+
+            const int r = (r_sum + 2) >> 2;
+            const int g = (g_sum + 2) >> 2;
+            const int b = (b_sum + 2) >> 2;
+            write_chroma(row / 2, col / 2, rgb_to_u(r, g, b), rgb_to_v(r, g, b));
+        }
+    }
+}
+} // namespace Detail
+
+/**
+ * \brief Gets the instruction set level the conversion kernels use.
+ */
+inline Level get_level()
+{
+    return Detail::level_override();
+}
+
+/**
+ * \brief Overrides the instruction set level the conversion kernels use. Meant for tests and benchmarks.
+ * \param level The level to use. Levels the CPU doesn't support are clamped to the detected level.
+ */
+inline void set_level(const Level level)
+{
+    const auto detected = Detail::detect_level();
+    Detail::level_override() = level > detected ? detected : level;
+}
+
+/**
+ * \brief Expands packed 24-bit pixels to 32-bit pixels, keeping the channel order.
+ * \param src The source pixels.
+ * \param dst The destination pixels.
+ * \param pixels The amount of pixels to convert.
+ * \param alpha The value of the 4th byte of each destination pixel.
+ */
+inline void rgb24_to_rgba32(const uint8_t *src, uint8_t *dst, const size_t pixels, const uint8_t alpha = 0xFF)
+{
+    size_t done = 0;
+#if PIXEL_CONVERSION_X86
+    switch (get_level())
+    {
+    case Level::AVX2:
+        done = Detail::rgb24_to_rgba32_avx2(src, dst, pixels, alpha);
+        break;
+    case Level::SSSE3:
+        done = Detail::rgb24_to_rgba32_ssse3(src, dst, pixels, alpha);
+        break;
+    default:
+        break;
+    }
+#endif
+    Detail::rgb24_to_rgba32_scalar(src + done * 3, dst + done * 4, pixels - done, alpha);
+}
+
+/**
+ * \brief Packs 32-bit pixels to 24-bit pixels, keeping the channel order and discarding the 4th byte.
+ * \param src The source pixels.
+ * \param dst The destination pixels.
+ * \param pixels The amount of pixels to convert.
+ */
+inline void rgba32_to_rgb24(const uint8_t *src, uint8_t *dst, const size_t pixels)
+{
+    size_t done = 0;
+#if PIXEL_CONVERSION_X86
+    if (get_level() != Level::Scalar)
+    {
+        done = Detail::rgba32_to_rgb24_ssse3(src, dst, pixels);
+    }
+#endif
+    Detail::rgba32_to_rgb24_scalar(src + done * 4, dst + done * 3, pixels - done);
+}
+
+/**
+ * \brief Swaps the 1st and 3rd channel of packed 24-bit pixels, converting between RGB and BGR.
+ * \param src The source pixels.
+ * \param dst The destination pixels. May be the same as the source.
+ * \param pixels The amount of pixels to convert.
+ */
+inline void swap_rb24(const uint8_t *src, uint8_t *dst, const size_t pixels)
+{
+    size_t done = 0;
+#if PIXEL_CONVERSION_X86
+    switch (get_level())
+    {
+    case Level::AVX2:
+        done = Detail::swap_rb24_avx2(src, dst, pixels);
+        break;
+    case Level::SSSE3:
+        done = Detail::swap_rb24_ssse3(src, dst, pixels);
+        break;
+    default:
+        break;
+    }
+#endif
+    Detail::swap_rb24_scalar(src + done * 3, dst + done * 3, pixels - done);
+}
+
+/**
+ * \brief Flips an image vertically in-place.
+ * \param buffer The image.
+ * \param stride The size of a row in bytes.
+ * \param height The amount of rows.
+ */
+inline void flip_vertical(uint8_t *buffer, const size_t stride, const size_t height)
+{
+    if (height < 2)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> row(stride);
+    for (size_t top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+    {
+        memcpy(row.data(), buffer + top * stride, stride);
+        memcpy(buffer + top * stride, buffer + bottom * stride, stride);
+        memcpy(buffer + bottom * stride, row.data(), stride);
+    }
+}
+
+/**
+ * \brief Converts a 24-bit image to I420, which is a Y plane followed by quarter-size U and V planes.
+ * \param src The source image.
+ * \param width The image's width.
+ * \param height The image's height.
+ * \param order The source's channel order.
+ * \param bottom_up Whether the source's rows are stored bottom-up, as in DIBs. The output is always top-down.
+ * \param y The Y plane, <c>width * height</c> bytes.
+ * \param u The U plane, <c>((width + 1) / 2) * ((height + 1) / 2)</c> bytes.
+ * \param v The V plane, <c>((width + 1) / 2) * ((height + 1) / 2)</c> bytes.
+ */
+inline void rgb24_to_i420(const uint8_t *src, const size_t width, const size_t height, const ByteOrder order,
+                          const bool bottom_up, uint8_t *y, uint8_t *u, uint8_t *v)
+{
+    const size_t chroma_width = (width + 1) / 2;
+    Detail::rgb24_to_yuv420(src, width, height, order, bottom_up, y,
+                            [&](const size_t row, const size_t col, const uint8_t cu, const uint8_t cv) {
+                                u[row * chroma_width + col] = cu;
+                                v[row * chroma_width + col] = cv;
+                            });
+}
+
+/**
+ * \brief Converts a 24-bit image to NV12, which is a Y plane followed by a quarter-size interleaved UV plane.
+ * \param src The source image.
+ * \param width The image's width.
+ * \param height The image's height.
+ * \param order The source's channel order.
+ * \param bottom_up Whether the source's rows are stored bottom-up, as in DIBs. The output is always top-down.
+ * \param y The Y plane, <c>width * height</c> bytes.
+ * \param uv The UV plane, <c>((width + 1) / 2) * ((height + 1) / 2) * 2</c> bytes.
+ */
+inline void rgb24_to_nv12(const uint8_t *src, const size_t width, const size_t height, const ByteOrder order,
+                          const bool bottom_up, uint8_t *y, uint8_t *uv)
+{
+    const size_t chroma_width = (width + 1) / 2;
+    Detail::rgb24_to_yuv420(src, width, height, order, bottom_up, y,
+                            [&](const size_t row, const size_t col, const uint8_t cu, const uint8_t cv) {
+                                uv[(row * chroma_width + col) * 2] = cu;
+                                uv[(row * chroma_width + col) * 2 + 1] = cv;
+                            });
+}
+} // namespace PixelConversion
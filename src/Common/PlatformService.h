@@ -8,6 +8,7 @@
 
 #define NOMINMAX
 #include <Windows.h>
+#include "XXH64Stream.h"
 
 /**
  * \brief A service providing platform-specific functionality.
@@ -15,6 +16,11 @@
 class PlatformService
 {
   public:
+    /**
+     * \brief The chunk size used when streaming files for comparison or hashing.
+     */
+    static constexpr size_t FILE_CHUNK_SIZE = 256 * 1024;
+
     virtual ~PlatformService() = default;
 
     virtual std::vector<uint8_t> read_file_buffer(const std::filesystem::path &path)
@@ -75,45 +81,107 @@ class PlatformService
 #endif
     }
 
-    virtual bool files_are_equal(const std::filesystem::path &first, const std::filesystem::path &second)
+    /**
+     * \brief Finds the offset of the first byte at which two files differ. Both files are streamed in fixed-size chunks,
+     * so memory usage doesn't depend on the file sizes.
+     * \param first The first file.
+     * \param second The second file.
+     * \return The offset of the first differing byte, or std::nullopt if the files are equal. If one file is a prefix
+     * of the other, the shorter file's size is returned. If either file can't be opened, 0 is returned.
+     */
+    virtual std::optional<uint64_t> find_first_difference(const std::filesystem::path &first,
+                                                          const std::filesystem::path &second)
     {
-        bool different = false;
-
         FILE *fp1 = nullptr;
         FILE *fp2 = nullptr;
-        if (_wfopen_s(&fp1, first.wstring().c_str(), L"rb") || _wfopen_s(&fp2, second.wstring().c_str(), L"rb"))
+        if (_wfopen_s(&fp1, first.wstring().c_str(), L"rb"))
         {
-            return false;
+            return 0;
         }
-        fseek(fp1, 0, SEEK_END);
-        fseek(fp2, 0, SEEK_END);
-
-        const auto len1 = ftell(fp1);
-        const auto len2 = ftell(fp2);
-
-        if (len1 != len2)
+        if (_wfopen_s(&fp2, second.wstring().c_str(), L"rb"))
         {
-            different = true;
-            goto cleanup;
+            fclose(fp1);
+            return 0;
         }
 
-        fseek(fp1, 0, SEEK_SET);
-        fseek(fp2, 0, SEEK_SET);
+        std::vector<uint8_t> buf1(FILE_CHUNK_SIZE);
+        std::vector<uint8_t> buf2(FILE_CHUNK_SIZE);
 
-        int ch1, ch2;
-        while ((ch1 = fgetc(fp1)) != EOF && (ch2 = fgetc(fp2)) != EOF)
+        std::optional<uint64_t> difference{};
+        uint64_t offset = 0;
+        while (true)
         {
-            if (ch1 != ch2)
+            const size_t len1 = fread(buf1.data(), 1, buf1.size(), fp1);
+            const size_t len2 = fread(buf2.data(), 1, buf2.size(), fp2);
+            const size_t common = std::min(len1, len2);
+
+            if (memcmp(buf1.data(), buf2.data(), common) != 0)
+            {
+                const auto mismatch = std::mismatch(buf1.begin(), buf1.begin() + common, buf2.begin());
+                difference = offset + (mismatch.first - buf1.begin());
+                break;
+            }
+
+            offset += common;
+
+            if (len1 != len2)
+            {
+                difference = offset;
+                break;
+            }
+
+            if (len1 < buf1.size())
             {
-                different = true;
                 break;
             }
         }
 
-    cleanup:
         fclose(fp1);
         fclose(fp2);
-        return !different;
+        return difference;
+    }
+
+    /**
+     * \brief Gets whether two files have identical contents.
+     */
+    virtual bool files_are_equal(const std::filesystem::path &first, const std::filesystem::path &second)
+    {
+        return !find_first_difference(first, second).has_value();
+    }
+
+    /**
+     * \brief Computes the XXH64 hash of a file's contents, streaming it in fixed-size chunks. The result equals
+     * xxh64::hash over the whole file.
+     * \param path The file to hash.
+     * \param seed The hash seed.
+     * \return The hash, or std::nullopt if the file couldn't be read.
+     */
+    virtual std::optional<uint64_t> hash_file(const std::filesystem::path &path, const uint64_t seed = 0)
+    {
+        FILE *fp = nullptr;
+        if (_wfopen_s(&fp, path.wstring().c_str(), L"rb"))
+        {
+            return std::nullopt;
+        }
+
+        std::vector<uint8_t> buf(FILE_CHUNK_SIZE);
+        XXH64Stream hasher(seed);
+
+        size_t len;
+        while ((len = fread(buf.data(), 1, buf.size(), fp)) > 0)
+        {
+            hasher.update(buf.data(), len);
+        }
+
+        const bool failed = ferror(fp);
+        fclose(fp);
+
+        if (failed)
+        {
+            return std::nullopt;
+        }
+
+        return hasher.digest();
     }
 
     virtual std::vector<std::wstring> get_files_with_extension_in_directory(std::wstring directory,
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * \brief An incremental XXH64 hasher. Feeding data in arbitrary pieces produces the same digest as a single-shot
+ * xxh64::hash over the concatenated data, while only buffering up to one 32-byte stripe.
+ */
+class XXH64Stream
+{
+  public:
+    explicit XXH64Stream(const uint64_t seed = 0)
+    {
+        reset(seed);
+    }
+
+    /**
+     * \brief Resets the hasher to its initial state.
+     * \param seed The seed to hash with.
+     */
+    void reset(const uint64_t seed = 0)
+    {
+        m_seed = seed;
+        m_v[0] = seed + PRIME1 + PRIME2;
+        m_v[1] = seed + PRIME2;
+        m_v[2] = seed;
+        m_v[3] = seed - PRIME1;
+        m_total_len = 0;
+        m_buffer_size = 0;
+    }
+
+    /**
+     * \brief Feeds data into the hasher.
+     * \param data The data to hash.
+     * \param len The length of the data in bytes.
+     */
+    void update(const void *data, size_t len)
+    {
+        auto p = static_cast<const uint8_t *>(data);
+        m_total_len += len;
+
+        if (m_buffer_size + len < STRIPE_SIZE)
+        {
+            std::memcpy(m_buffer + m_buffer_size, p, len);
+            m_buffer_size += len;
+            return;
+        }
+
+        if (m_buffer_size > 0)
+        {
+            const size_t fill = STRIPE_SIZE - m_buffer_size;
+            std::memcpy(m_buffer + m_buffer_size, p, fill);
+            consume_stripe(m_buffer);
+            p += fill;
+            len -= fill;
+            m_buffer_size = 0;
+        }
+
+        while (len >= STRIPE_SIZE)
+        {
+            consume_stripe(p);
+            p += STRIPE_SIZE;
+            len -= STRIPE_SIZE;
+        }
+
+        std::memcpy(m_buffer, p, len);
+        m_buffer_size = len;
+    }
+
+    /**
+     * \brief Computes the digest of all data fed so far. The hasher can keep receiving data afterwards.
+     */
+    [[nodiscard]] uint64_t digest() const
+    {
+        uint64_t h;
+        if (m_total_len >= STRIPE_SIZE)
+        {
+            h = rotl(m_v[0], 1) + rotl(m_v[1], 7) + rotl(m_v[2], 12) + rotl(m_v[3], 18);
+            for (const auto v : m_v)
+            {
+                h = (h ^ round(0, v)) * PRIME1 + PRIME4;
+            }
+        }
+        else
+        {
+            h = m_seed + PRIME5;
+        }
+
+        h += m_total_len;
+
+        const uint8_t *p = m_buffer;
+        size_t len = m_buffer_size;
+        while (len >= 8)
+        {
+            h = rotl(h ^ round(0, read64(p)), 27) * PRIME1 + PRIME4;
+            p += 8;
+            len -= 8;
+        }
+        if (len >= 4)
+        {
+            h = rotl(h ^ (read32(p) * PRIME1), 23) * PRIME2 + PRIME3;
+            p += 4;
+            len -= 4;
+        }
+        while (len > 0)
+        {
+            h = rotl(h ^ (*p * PRIME5), 11) * PRIME1;
+            ++p;
+            --len;
+        }
+
+        h = (h ^ (h >> 33)) * PRIME2;
+        h = (h ^ (h >> 29)) * PRIME3;
+        return h ^ (h >> 32);
+    }
+
+  private:
+    static constexpr size_t STRIPE_SIZE = 32;
+    static constexpr uint64_t PRIME1 = 11400714785074694791ULL;
+    static constexpr uint64_t PRIME2 = 14029467366897019727ULL;
+    static constexpr uint64_t PRIME3 = 1609587929392839161ULL;
+    static constexpr uint64_t PRIME4 = 9650029242287828579ULL;
+    static constexpr uint64_t PRIME5 = 2870177450012600261ULL;
+
+    static uint64_t rotl(const uint64_t x, const int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static uint64_t round(const uint64_t acc, const uint64_t input)
+    {
+        return rotl(acc + input * PRIME2, 31) * PRIME1;
+    }
+
+    // Little-endian reads, matching xxh64::hash on the hosts we target.
+    static uint64_t read64(const uint8_t *p)
+    {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint64_t read32(const uint8_t *p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    void consume_stripe(const uint8_t *p)
+    {
+        m_v[0] = round(m_v[0], read64(p));
+        m_v[1] = round(m_v[1], read64(p + 8));
+        m_v[2] = round(m_v[2], read64(p + 16));
+        m_v[3] = round(m_v[3], read64(p + 24));
+    }
+
+    uint64_t m_seed{};
+    uint64_t m_v[4]{};
+    uint64_t m_total_len{};
+    uint8_t m_buffer[STRIPE_SIZE]{};
+    size_t m_buffer_size{};
+};
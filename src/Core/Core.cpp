@@ -13,6 +13,7 @@
 #include <r4300/disasm.h>
 #include <r4300/r4300.h>
 #include <r4300/rom.h>
+#include <r4300/synclog.h>
 #include <r4300/timers.h>
 #include <r4300/tracelog.h>
 #include <r4300/vcr.h>
@@ -126,9 +127,21 @@ EXPORT core_result CALL core_create(core_params *params, core_ctx **ctx)
     g_ctx.tl_active = tl_active;
     g_ctx.tl_start = tl_start;
     g_ctx.tl_stop = tl_stop;
+    g_ctx.sl_active = sl_active;
+    g_ctx.sl_start = sl_start;
+    g_ctx.sl_stop = sl_stop;
+    g_ctx.sl_get_log = sl_get_log;
+    g_ctx.sl_set_reference = sl_set_reference;
+    g_ctx.sl_get_divergence = sl_get_divergence;
+    g_ctx.sl_save = sl_save;
+    g_ctx.sl_load = sl_load;
+    g_ctx.sl_find_divergence = sl_find_divergence;
+    g_ctx.sl_get_section_name = sl_get_section_name;
     g_ctx.st_do_file = st_do_file;
     g_ctx.st_do_memory = st_do_memory;
-    g_ctx.st_get_undo_savestate = st_get_undo_savestate;
+    g_ctx.st_undo = st_undo;
+    g_ctx.st_get_undo_count = st_get_undo_count;
+    g_ctx.st_get_undo_memory_usage = st_get_undo_memory_usage;
     g_ctx.dbg_get_resumed = dbg_get_resumed;
     g_ctx.dbg_set_is_resumed = dbg_set_is_resumed;
     g_ctx.dbg_step = dbg_step;
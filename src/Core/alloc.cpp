@@ -9,21 +9,187 @@
 
 #ifdef WIN32
 #include <Windows.h>
+#else
+#include <sys/mman.h>
 #endif
 
-// https://github.com/mupen64plus/mupen64plus-core/blob/e170c409fb006aa38fd02031b5eefab6886ec125/src/device/r4300/recomp.c#L995
+// Code buffers are carved out of a single reserved arena, so compiled blocks stay close together. Buffers are rounded
+// up to a power-of-two number of pages, which lets most reallocations happen in place, and freed buffers are kept on
+// per-size free lists for reuse. During emulation, buffers are only freed when a block outgrows its buffer, as
+// invalidated blocks recompile into the buffer they already own. The arena is reset once its last buffer is freed,
+// which happens when the core stops. Buffers which don't fit into the arena fall back to dedicated mappings.
+//
+// The free lists are linked through a side table rather than through the buffers themselves, since freed buffers
+// may not be writable on platforms enforcing W^X.
 
-void *malloc_exec(size_t size)
+constexpr size_t EXEC_PAGE_SHIFT = 12;
+constexpr size_t EXEC_PAGE_SIZE = 1 << EXEC_PAGE_SHIFT;
+constexpr size_t EXEC_ARENA_SIZE = 64 * 1024 * 1024;
+constexpr size_t EXEC_CLASS_COUNT = 8;
+
+static uint8_t *arena;
+static size_t arena_top;
+static size_t arena_live;
+static uint32_t free_lists[EXEC_CLASS_COUNT];
+static uint8_t page_classes[EXEC_ARENA_SIZE >> EXEC_PAGE_SHIFT];
+static uint32_t free_next[EXEC_ARENA_SIZE >> EXEC_PAGE_SHIFT];
+static int32_t write_depth;
+
+static size_t class_size(size_t cls)
+{
+    return EXEC_PAGE_SIZE << cls;
+}
+
+static bool in_arena(const void *ptr)
 {
+    return arena && ptr >= arena && ptr < arena + EXEC_ARENA_SIZE;
+}
+
 #ifdef WIN32
+
+static uint8_t *os_reserve(size_t size)
+{
+    return (uint8_t *)VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+static bool os_commit(uint8_t *ptr, size_t size)
+{
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE) != NULL;
+}
+
+static void os_decommit(uint8_t *ptr, size_t size)
+{
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+}
+
+static void os_protect(uint8_t *, size_t, bool)
+{
+    // Windows pages stay RWX, since the dynarec patches its jump tables while code from the same buffer is running.
+}
+
+static void *os_map(size_t size)
+{
     return VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+}
+
+static void os_unmap(void *ptr)
+{
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
 #else
-#error "malloc_exec not implemented for this platform"
+
+static int protection(bool writable)
+{
+    return writable ? PROT_READ | PROT_WRITE : PROT_READ | PROT_EXEC;
+}
+
+static uint8_t *os_reserve(size_t size)
+{
+    void *ptr = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr == MAP_FAILED ? NULL : (uint8_t *)ptr;
+}
+
+static bool os_commit(uint8_t *ptr, size_t size)
+{
+    return mprotect(ptr, size, protection(write_depth > 0)) == 0;
+}
+
+static void os_decommit(uint8_t *ptr, size_t size)
+{
+    madvise(ptr, size, MADV_DONTNEED);
+    mprotect(ptr, size, PROT_NONE);
+}
+
+static void os_protect(uint8_t *ptr, size_t size, bool writable)
+{
+    mprotect(ptr, size, protection(writable));
+}
+
+// Dedicated mappings remember their size in a header page, since munmap needs it.
+static void *os_map(size_t size)
+{
+    const int prot = PROT_READ | PROT_WRITE | PROT_EXEC;
+    void *ptr = mmap(NULL, size + EXEC_PAGE_SIZE, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) return NULL;
+    *(size_t *)ptr = size + EXEC_PAGE_SIZE;
+    return (uint8_t *)ptr + EXEC_PAGE_SIZE;
+}
+
+static void os_unmap(void *ptr)
+{
+    uint8_t *base = (uint8_t *)ptr - EXEC_PAGE_SIZE;
+    munmap(base, *(size_t *)base);
+}
+
 #endif
+
+/**
+ * \brief Gets the smallest size class holding a buffer of the given size, or EXEC_CLASS_COUNT if none does.
+ */
+static size_t size_class(size_t size)
+{
+    size_t cls = 0;
+    while (cls < EXEC_CLASS_COUNT && class_size(cls) < size) cls++;
+    return cls;
+}
+
+// Free list entries are page indices plus one, so zero can terminate the lists.
+static void *arena_alloc(size_t cls)
+{
+    if (const uint32_t entry = free_lists[cls])
+    {
+        free_lists[cls] = free_next[entry - 1];
+        arena_live++;
+        return arena + ((size_t)(entry - 1) << EXEC_PAGE_SHIFT);
+    }
+
+    if (!arena && !(arena = os_reserve(EXEC_ARENA_SIZE))) return NULL;
+    if (arena_top + class_size(cls) > EXEC_ARENA_SIZE) return NULL;
+
+    uint8_t *ptr = arena + arena_top;
+    if (!os_commit(ptr, class_size(cls))) return NULL;
+
+    page_classes[arena_top >> EXEC_PAGE_SHIFT] = (uint8_t)cls;
+    arena_top += class_size(cls);
+    arena_live++;
+    return ptr;
+}
+
+static void arena_free(void *ptr)
+{
+    const size_t page = ((uint8_t *)ptr - arena) >> EXEC_PAGE_SHIFT;
+    const size_t cls = page_classes[page];
+    free_next[page] = free_lists[cls];
+    free_lists[cls] = (uint32_t)page + 1;
+
+    // Once nothing lives in the arena anymore, the free lists are dropped and allocation starts over from the bottom,
+    // undoing any fragmentation left behind by invalidated blocks.
+    if (--arena_live == 0)
+    {
+        os_decommit(arena, arena_top);
+        arena_top = 0;
+        memset(free_lists, 0, sizeof(free_lists));
+    }
+}
+
+void *malloc_exec(size_t size)
+{
+    const size_t cls = size_class(size);
+    if (cls < EXEC_CLASS_COUNT)
+    {
+        if (void *ptr = arena_alloc(cls)) return ptr;
+    }
+    return os_map(size);
 }
 
 void *realloc_exec(void *ptr, size_t oldsize, size_t newsize)
 {
+    if (in_arena(ptr) && newsize <= class_size(page_classes[((uint8_t *)ptr - arena) >> EXEC_PAGE_SHIFT]))
+    {
+        return ptr;
+    }
+
     void *block = malloc_exec(newsize);
     if (block != NULL)
     {
@@ -37,9 +203,20 @@ void *realloc_exec(void *ptr, size_t oldsize, size_t newsize)
 
 void free_exec(void *ptr)
 {
-#ifdef WIN32
-    VirtualFree(ptr, 0, MEM_RELEASE);
-#else
-#error "free_exec not implemented for this platform"
-#endif
+    if (in_arena(ptr))
+    {
+        arena_free(ptr);
+        return;
+    }
+    os_unmap(ptr);
+}
+
+void exec_begin_write()
+{
+    if (write_depth++ == 0 && arena_top) os_protect(arena, arena_top, true);
+}
+
+void exec_end_write()
+{
+    if (--write_depth == 0 && arena_top) os_protect(arena, arena_top, false);
 }
@@ -9,3 +9,14 @@
 void *malloc_exec(size_t size);
 void *realloc_exec(void *ptr, size_t oldsize, size_t newsize);
 void free_exec(void *ptr);
+
+/**
+ * \brief Makes executable memory writable until the matching <c>exec_end_write</c> call. Calls may be nested.
+ * On platforms enforcing W^X, the memory can't be executed in the meantime.
+ */
+void exec_begin_write();
+
+/**
+ * \brief Ends a write section started by <c>exec_begin_write</c>.
+ */
+void exec_end_write();
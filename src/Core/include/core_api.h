@@ -41,7 +41,14 @@ extern "C"
         std::function<void(bool)> emu_paused_changed = [](bool) {};
         std::function<void(bool)> emu_launched_changed = [](bool) {};
         std::function<void(bool)> emu_starting_changed = [](bool) {};
+        /**
+         * \brief Called when the plugins are started. Not called on soft resets, which keep the plugins running and only
+         * notify them through <c>plugins_rom_closed</c> and <c>plugins_rom_open</c>.
+         */
         std::function<void()> emu_starting = [] {};
+        /**
+         * \brief Called when the plugins are to be stopped. Not called on soft resets, see <c>emu_starting</c>.
+         */
         std::function<void()> emu_stopped = [] {};
         std::function<void()> emu_stopping = [] {};
         std::function<void()> reset_completed = [] {};
@@ -129,6 +136,18 @@ extern "C"
          */
         void (*initiate_plugins)(void);
 
+        /**
+         * \brief Calls the "RomClosed" function of all loaded plugins without unloading them.
+         * Used during soft resets, where the plugins stay loaded across the reset.
+         */
+        void (*plugins_rom_closed)(void);
+
+        /**
+         * \brief Calls the "RomOpen" function of all loaded plugins.
+         * Used during soft resets, where the plugins stay loaded across the reset.
+         */
+        void (*plugins_rom_open)(void);
+
         /**
          * \brief Executes a function asynchronously.
          * \param func The function to be executed.
@@ -633,6 +652,73 @@ extern "C"
 
 #pragma endregion
 
+#pragma region Sync Log
+
+        /**
+         * \brief Gets whether the sync log is recording.
+         */
+        std::function<bool()> sl_active;
+
+        /**
+         * \brief Clears the sync log and starts recording per-section hashes of the machine state (RDRAM pages, CPU
+         * and RCP registers, SP memory) into it.
+         * \param interval The interval, in movie samples, between checkpoints. Checkpoints are only taken while a
+         * movie is being played back or recorded.
+         * \remarks Checkpoints are taken at the same point savestates are, so two runs of the same movie produce
+         * identical logs unless they desync. Loading a savestate discards checkpoints after the loaded sample.
+         */
+        std::function<void(size_t interval)> sl_start;
+
+        /**
+         * \brief Stops recording the sync log. The recorded log is kept until the next <c>sl_start</c> call.
+         */
+        std::function<void()> sl_stop;
+
+        /**
+         * \brief Gets a copy of the sync log.
+         */
+        std::function<void(core_sl_log &log)> sl_get_log;
+
+        /**
+         * \brief Sets a sync log which checkpoints are compared against as they're taken, so a desync is known as
+         * soon as it happens. Cleared by <c>sl_start</c>.
+         * \param log The reference log, usually one loaded with <c>sl_load</c>.
+         */
+        std::function<void(const core_sl_log &log)> sl_set_reference;
+
+        /**
+         * \brief Gets the first divergence from the reference log found so far, with the same semantics as
+         * <c>sl_find_divergence</c>. The sample is SIZE_MAX if none was found.
+         */
+        std::function<core_sl_divergence()> sl_get_divergence;
+
+        /**
+         * \brief Writes the sync log to a file.
+         * \param path The output path.
+         * \return Whether the operation succeeded.
+         */
+        std::function<bool(const std::filesystem::path &path)> sl_save;
+
+        /**
+         * \brief Reads a sync log from a file.
+         * \param path The sync log's path.
+         * \param log The log to fill.
+         * \return Whether the operation succeeded.
+         */
+        std::function<bool(const std::filesystem::path &path, core_sl_log &log)> sl_load;
+
+        /**
+         * \brief Finds the first sample at which two sync logs differ, along with the differing sections.
+         */
+        std::function<core_sl_divergence(const core_sl_log &first, const core_sl_log &second)> sl_find_divergence;
+
+        /**
+         * \brief Gets a human-readable name for a sync log section.
+         */
+        std::function<std::wstring(uint16_t section)> sl_get_section_name;
+
+#pragma endregion
+
 #pragma region Savestates
 
         /**
@@ -661,9 +747,25 @@ extern "C"
             st_do_memory;
 
         /**
-         * Gets the undo savestate buffer. Will be empty will no undo savestate is available.
+         * \brief Restores the state from before a previous savestate load. Undo savestates newer than the restored one
+         * are discarded once the load succeeds.
+         * \param steps The amount of loads to go back by. 1 restores the state from before the most recent load.
+         * \param callback The callback to call when the operation is complete.
+         * \warning The operation won't complete immediately. Must be called via AsyncExecutor unless calls are
+         * originating from the emu thread. \return Whether the operation was enqueued.
+         */
+        std::function<bool(size_t steps, const core_st_callback &callback)> st_undo;
+
+        /**
+         * \brief Gets the amount of undo savestates available, which is the maximum amount of steps <c>st_undo</c>
+         * accepts.
+         */
+        std::function<size_t()> st_get_undo_count;
+
+        /**
+         * \brief Gets the amount of memory, in bytes, used by the undo savestates.
          */
-        std::function<void(std::vector<uint8_t> &buffer)> st_get_undo_savestate;
+        std::function<size_t()> st_get_undo_memory_usage;
 
 #pragma endregion
 
@@ -182,6 +182,11 @@ struct core_cfg
     /// </summary>
     int32_t st_undo_load = 1;
 
+    /// <summary>
+    /// The maximum amount of undo savestates to keep in memory.
+    /// </summary>
+    int32_t st_undo_max_count = 8;
+
     /// <summary>
     /// SD card emulation
     /// </summary>
@@ -787,6 +792,96 @@ using core_st_callback = std::function<void(const core_st_callback_info &, const
 
 #pragma endregion
 
+#pragma region Sync Log
+
+/**
+ * \brief The size of an RDRAM page tracked by the sync log.
+ */
+constexpr uint32_t CORE_SL_RDRAM_PAGE_SIZE = 0x1000;
+
+/**
+ * \brief The amount of RDRAM pages tracked by the sync log. Sections below this value identify RDRAM pages.
+ */
+constexpr uint16_t CORE_SL_RDRAM_PAGE_COUNT = 0x800000 / CORE_SL_RDRAM_PAGE_SIZE;
+
+/**
+ * \brief A machine state section hashed by the sync log. Values below <c>CORE_SL_RDRAM_PAGE_COUNT</c> are RDRAM page
+ * indices.
+ */
+typedef enum : uint16_t
+{
+    core_sl_section_cpu = CORE_SL_RDRAM_PAGE_COUNT,
+    core_sl_section_cop0,
+    core_sl_section_cop1,
+    core_sl_section_tlb,
+    core_sl_section_sp_dmem,
+    core_sl_section_sp_imem,
+    core_sl_section_pif_ram,
+    core_sl_section_rdram_reg,
+    core_sl_section_mi_reg,
+    core_sl_section_pi_reg,
+    core_sl_section_sp_reg,
+    core_sl_section_rsp_reg,
+    core_sl_section_si_reg,
+    core_sl_section_vi_reg,
+    core_sl_section_ri_reg,
+    core_sl_section_ai_reg,
+    core_sl_section_dpc_reg,
+    core_sl_section_dps_reg,
+    core_sl_section_count,
+} core_sl_section;
+
+/**
+ * \brief A sync log checkpoint.
+ */
+struct core_sl_entry
+{
+    /**
+     * \brief The movie sample the checkpoint was taken at.
+     */
+    uint32_t sample{};
+
+    /**
+     * \brief The sections whose hash changed since the previous checkpoint, along with their new hash. The first
+     * checkpoint contains all sections.
+     */
+    std::vector<std::pair<uint16_t, uint64_t>> changes{};
+};
+
+/**
+ * \brief A log of machine state hashes taken at regular movie sample intervals.
+ */
+struct core_sl_log
+{
+    /**
+     * \brief The interval, in samples, between checkpoints.
+     */
+    uint32_t interval{};
+
+    /**
+     * \brief The checkpoints, ordered by sample.
+     */
+    std::vector<core_sl_entry> entries{};
+};
+
+/**
+ * \brief Describes where two sync logs diverge.
+ */
+struct core_sl_divergence
+{
+    /**
+     * \brief The first sample present in both logs at which the machine states differ. SIZE_MAX if the logs match.
+     */
+    size_t sample = SIZE_MAX;
+
+    /**
+     * \brief The sections which differ at <c>sample</c>.
+     */
+    std::vector<uint16_t> sections{};
+};
+
+#pragma endregion
+
 #pragma region Host API Types
 
 /**
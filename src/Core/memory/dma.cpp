@@ -166,6 +166,8 @@ void dma_pi_write()
 
     if (!interpcore)
     {
+        hash_rdram_blocks(pi_register.pi_dram_addr_reg, pi_register.pi_dram_addr_reg + longueur);
+
         for (i = 0; i < longueur; i++)
         {
             uint32_t rdram_address1 = pi_register.pi_dram_addr_reg + i + 0x80000000;
@@ -184,6 +186,8 @@ void dma_pi_write()
                 if (blocks[rdram_address2 >> 12]->block[(rdram_address2 & 0xFFF) / 4].ops != NOTCOMPILED)
                     invalid_code[rdram_address2 >> 12] = 1;
         }
+
+        clear_rdram_block_hashes(pi_register.pi_dram_addr_reg, pi_register.pi_dram_addr_reg + longueur);
     }
     else
     {
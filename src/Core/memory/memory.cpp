@@ -1201,6 +1201,7 @@ void update_SP()
                             firstFrameBufferSetting = 0;
                             fast_memory = 0;
                             for (j = 0; j < 0x100000; j++) invalid_code[j] = 1;
+                            clear_block_hashes();
                         }
                     }
                 }
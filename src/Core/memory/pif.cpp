@@ -12,6 +12,7 @@
 #include <memory/savestates.h>
 #include <cheats.h>
 #include <r4300/r4300.h>
+#include <r4300/synclog.h>
 #include <r4300/vcr.h>
 
 // Amount of VIs since last input poll
@@ -436,6 +437,7 @@ void update_pif_read()
                     if (stAllowed)
                     {
                         st_do_work();
+                        sl_on_input_poll();
                     }
                     if (g_st_old)
                     {
@@ -13,6 +13,7 @@
 #include <memory/memory.h>
 #include <memory/savestates.h>
 #include <memory/summercart.h>
+#include <memory/tlb.h>
 #include <r4300/interrupt.h>
 #include <r4300/r4300.h>
 #include <r4300/rom.h>
@@ -20,6 +21,12 @@
 
 constexpr auto RDRAM_DEVICE_MANUF_NEW_FIX_BIT = (1 << 31);
 
+// st whose TLB LUTs aren't stored, as they're rebuilt from the TLB entries on load.
+constexpr auto RDRAM_DEVICE_MANUF_COMPACT_TLB_BIT = (1 << 30);
+
+// Size of the TLB LUT section found in st without the compact TLB bit.
+constexpr auto TLB_LUT_SECTION_SIZE = 0x200000;
+
 // st that comes from no delay fix mupen, it has some differences compared to new st:
 // - one frame of input is "embedded", that is the pif ram holds already fetched controller info.
 // - execution continues at exception handler (after input poll) at 0x80000180.
@@ -43,14 +50,59 @@ struct t_savestate_task
 
     /// Whether warnings, such as those about ROM compatibility, shouldn't be shown.
     bool ignore_warnings;
+
+    /// Whether the task restores an undo savestate, in which case it doesn't create an undo point itself.
+    bool is_undo{};
+};
+
+/// A compressed chunk of an undo savestate. Identical chunks are shared between undo savestates.
+struct t_undo_chunk
+{
+    /// The chunk's deflate-compressed data.
+    std::vector<uint8_t> data;
+
+    /// The chunk's uncompressed size.
+    size_t size;
+};
+
+/// An undo savestate.
+struct t_undo_savestate
+{
+    /// The uncompressed savestate, shared with the background compression. Only present until the compression finishes.
+    std::shared_ptr<const std::vector<uint8_t>> raw;
+
+    /// The savestate's chunks, in order. Only present once the background compression finishes.
+    std::vector<std::shared_ptr<const t_undo_chunk>> chunks;
 };
 
+/// A savestate file whose uncompressed contents are kept in memory.
+struct t_hot_slot
+{
+    /// The savestate file's path.
+    std::filesystem::path path;
+
+    /// The file's last write time when it was cached. Used to detect modifications made by others.
+    std::filesystem::file_time_type write_time;
+
+    /// The uncompressed savestate.
+    std::vector<uint8_t> buffer;
+};
+
+// Maximum amount of savestate files kept in memory.
+constexpr size_t HOT_SLOT_MAX_COUNT = 4;
+
+// Size of the chunks undo savestates are split into for deduplication.
+constexpr size_t UNDO_CHUNK_SIZE = 0x10000;
+
 // The task vector mutex. Locked when accessing the task vector.
 std::recursive_mutex g_task_mutex;
 
 // The task vector, which contains the task queue to be performed by the savestate system.
 std::vector<t_savestate_task> g_tasks;
 
+// The savestate files kept in memory, most recently used first. Guarded by the task vector mutex.
+std::deque<t_hot_slot> g_hot_slots;
+
 // Demarcator for new screenshot section
 char screen_section[] = "SCR";
 
@@ -63,8 +115,14 @@ char g_event_queue_buf[1024]{};
 // Buffer used for storing st data up to event queue
 uint8_t g_first_block[0xA02BB4 - 32]{};
 
-// The undo savestate buffer.
-std::vector<uint8_t> g_undo_savestate;
+// The undo savestate mutex. Locked when accessing the undo savestates or the chunk pool.
+std::mutex g_undo_mutex;
+
+// The undo savestates, oldest first.
+std::deque<std::shared_ptr<t_undo_savestate>> g_undo_savestates;
+
+// The chunks referenced by the undo savestates, keyed by the hash of their uncompressed data.
+std::multimap<uint64_t, std::weak_ptr<const t_undo_chunk>> g_undo_chunk_pool;
 void get_paths_for_task(const t_savestate_task &task, std::filesystem::path &st_path, std::filesystem::path &sd_path)
 {
     sd_path = g_core->get_saves_directory() / (const char *)ROM_HEADER.nom;
@@ -79,6 +137,8 @@ void load_memory_from_buffer(uint8_t *p)
         rdram_register.rdram_device_manuf &= ~RDRAM_DEVICE_MANUF_NEW_FIX_BIT; // remove the trick
         g_st_skip_dma = true;                                                 // tell dma.c to skip it
     }
+    const bool compact_tlb = rdram_register.rdram_device_manuf & RDRAM_DEVICE_MANUF_COMPACT_TLB_BIT;
+    rdram_register.rdram_device_manuf &= ~RDRAM_DEVICE_MANUF_COMPACT_TLB_BIT;
     MiscHelpers::memread(&p, &MI_register, sizeof(core_mips_reg));
     MiscHelpers::memread(&p, &pi_register, sizeof(core_pi_reg));
     MiscHelpers::memread(&p, &sp_register, sizeof(core_sp_reg));
@@ -89,6 +149,11 @@ void load_memory_from_buffer(uint8_t *p)
     MiscHelpers::memread(&p, &ai_register, sizeof(core_ai_reg));
     MiscHelpers::memread(&p, &dpc_register, sizeof(core_dpc_reg));
     MiscHelpers::memread(&p, &dps_register, sizeof(core_dps_reg));
+
+    // Remember what the compiled code looked like, so blocks whose code is unchanged by the load are revalidated on
+    // entry instead of being rebuilt.
+    if (dynacore || !interpcore) hash_rdram_blocks(0, 0x800000);
+
     MiscHelpers::memread(&p, rdram, 0x800000);
     MiscHelpers::memread(&p, SP_DMEM, 0x1000);
     MiscHelpers::memread(&p, SP_IMEM, 0x1000);
@@ -98,8 +163,12 @@ void load_memory_from_buffer(uint8_t *p)
     MiscHelpers::memread(&p, buf, 24);
     load_flashram_infos(buf);
 
-    MiscHelpers::memread(&p, tlb_LUT_r, 0x100000);
-    MiscHelpers::memread(&p, tlb_LUT_w, 0x100000);
+    const uint8_t *stored_luts = nullptr;
+    if (!compact_tlb)
+    {
+        stored_luts = p;
+        p += TLB_LUT_SECTION_SIZE;
+    }
 
     MiscHelpers::memread(&p, &llbit, 4);
     MiscHelpers::memread(&p, reg, 32 * 8);
@@ -114,6 +183,13 @@ void load_memory_from_buffer(uint8_t *p)
     MiscHelpers::memread(&p, &FCR0, 4);
     MiscHelpers::memread(&p, &FCR31, 4);
     MiscHelpers::memread(&p, tlb_e, 32 * sizeof(tlb));
+    tlb_rebuild_luts();
+    if (stored_luts)
+    {
+        // Older st only stored the low quarter of each LUT, so keep those entries verbatim on top of the rebuilt ones.
+        memcpy(tlb_LUT_r, stored_luts, TLB_LUT_SECTION_SIZE / 2);
+        memcpy(tlb_LUT_w, stored_luts + TLB_LUT_SECTION_SIZE / 2, TLB_LUT_SECTION_SIZE / 2);
+    }
     if (!dynacore && interpcore)
         MiscHelpers::memread(&p, &interp_addr, 4);
     else
@@ -158,8 +234,11 @@ std::vector<uint8_t> generate_savestate()
     save_flashram_infos(g_flashram_buf);
     const int32_t event_queue_len = save_eventqueue_infos(g_event_queue_buf);
 
+    core_rdram_reg st_rdram_register = rdram_register;
+    st_rdram_register.rdram_device_manuf |= RDRAM_DEVICE_MANUF_COMPACT_TLB_BIT;
+
     MiscHelpers::vecwrite(b, rom_md5, 32);
-    MiscHelpers::vecwrite(b, &rdram_register, sizeof(core_rdram_reg));
+    MiscHelpers::vecwrite(b, &st_rdram_register, sizeof(core_rdram_reg));
     MiscHelpers::vecwrite(b, &MI_register, sizeof(core_mips_reg));
     MiscHelpers::vecwrite(b, &pi_register, sizeof(core_pi_reg));
     MiscHelpers::vecwrite(b, &sp_register, sizeof(core_sp_reg));
@@ -175,8 +254,6 @@ std::vector<uint8_t> generate_savestate()
     MiscHelpers::vecwrite(b, SP_IMEM, 0x1000);
     MiscHelpers::vecwrite(b, PIF_RAM, 0x40);
     MiscHelpers::vecwrite(b, g_flashram_buf, 24);
-    MiscHelpers::vecwrite(b, tlb_LUT_r, 0x100000);
-    MiscHelpers::vecwrite(b, tlb_LUT_w, 0x100000);
     MiscHelpers::vecwrite(b, &llbit, 4);
     MiscHelpers::vecwrite(b, reg, 32 * 8);
     for (size_t i = 0; i < 32; i++)
@@ -227,6 +304,52 @@ std::vector<uint8_t> generate_savestate()
     return b;
 }
 
+/**
+ * Caches an uncompressed savestate file in memory. Must be called after the file has been written.
+ */
+void hot_slot_put(const std::filesystem::path &path, const std::vector<uint8_t> &buffer)
+{
+    std::erase_if(g_hot_slots, [&](const t_hot_slot &slot) { return slot.path == path; });
+
+    std::error_code ec;
+    const auto write_time = std::filesystem::last_write_time(path, ec);
+    if (ec)
+    {
+        return;
+    }
+
+    g_hot_slots.push_front(t_hot_slot{.path = path, .write_time = write_time, .buffer = buffer});
+    if (g_hot_slots.size() > HOT_SLOT_MAX_COUNT)
+    {
+        g_hot_slots.pop_back();
+    }
+}
+
+/**
+ * Gets a savestate file's uncompressed contents from memory, provided the file hasn't changed since it was cached.
+ * \return Whether the file was cached.
+ */
+bool hot_slot_get(const std::filesystem::path &path, std::vector<uint8_t> &buffer)
+{
+    const auto it = std::ranges::find_if(g_hot_slots, [&](const t_hot_slot &slot) { return slot.path == path; });
+    if (it == g_hot_slots.end())
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    const auto write_time = std::filesystem::last_write_time(path, ec);
+    if (ec || write_time != it->write_time)
+    {
+        g_hot_slots.erase(it);
+        return false;
+    }
+
+    buffer = it->buffer;
+    std::rotate(g_hot_slots.begin(), it, it + 1);
+    return true;
+}
+
 void savestates_save_immediate_impl(const t_savestate_task &task)
 {
     // TODO: Reimplement timing
@@ -260,6 +383,8 @@ void savestates_save_immediate_impl(const t_savestate_task &task)
                 st);
             return;
         }
+
+        hot_slot_put(new_st_path, st);
     }
 
     task.callback(
@@ -283,36 +408,43 @@ void savestates_load_immediate_impl(const t_savestate_task &task)
 
     if (g_core->cfg->use_summercart) load_summercart(new_sd_path);
 
-    std::vector<uint8_t> st_buf;
-
-    switch (task.medium)
+    // Slot files which were recently saved or loaded are served from memory, skipping the file read and inflate.
+    std::vector<uint8_t> decompressed_buf;
+    if (task.medium != core_st_medium_path || !hot_slot_get(new_st_path, decompressed_buf))
     {
-    case core_st_medium_path:
-        st_buf = g_core->io_service->read_file_buffer(new_st_path);
-        break;
-    case core_st_medium_memory:
-        st_buf = task.params.buffer;
-        break;
-    default:
-        assert(false);
-    }
+        std::vector<uint8_t> st_buf;
 
-    if (st_buf.empty())
-    {
-        task.callback(
-            core_st_callback_info{.result = ST_NotFound, .job = task.job, .medium = task.medium, .params = task.params},
-            {});
-        return;
-    }
+        switch (task.medium)
+        {
+        case core_st_medium_path:
+            st_buf = g_core->io_service->read_file_buffer(new_st_path);
+            break;
+        case core_st_medium_memory:
+            st_buf = task.params.buffer;
+            break;
+        default:
+            assert(false);
+        }
 
-    std::vector<uint8_t> decompressed_buf = MiscHelpers::auto_decompress(st_buf, 0xB624F0);
-    if (decompressed_buf.empty())
-    {
-        task.callback(
-            core_st_callback_info{
-                .result = ST_DecompressionError, .job = task.job, .medium = task.medium, .params = task.params},
-            {});
-        return;
+        if (st_buf.empty())
+        {
+            task.callback(core_st_callback_info{
+                              .result = ST_NotFound, .job = task.job, .medium = task.medium, .params = task.params},
+                          {});
+            return;
+        }
+
+        decompressed_buf = MiscHelpers::auto_decompress(st_buf, 0xB624F0);
+        if (decompressed_buf.empty())
+        {
+            task.callback(
+                core_st_callback_info{
+                    .result = ST_DecompressionError, .job = task.job, .medium = task.medium, .params = task.params},
+                {});
+            return;
+        }
+
+        if (task.medium == core_st_medium_path) hot_slot_put(new_st_path, decompressed_buf);
     }
 
     // BUG (PRONE): we arent allowed to hold on to a vector element pointer
@@ -343,8 +475,12 @@ void savestates_load_immediate_impl(const t_savestate_task &task)
         }
     }
 
-    // new version does one bigass gzread for first part of .st (static size)
-    MiscHelpers::memread(&ptr, g_first_block, sizeof(g_first_block));
+    // new version does one bigass gzread for first part of .st (static size, minus the LUTs if they weren't stored)
+    const auto device_manuf = *(uint32_t *)(ptr + offsetof(core_rdram_reg, rdram_device_manuf));
+    const size_t first_block_size = device_manuf & RDRAM_DEVICE_MANUF_COMPACT_TLB_BIT
+        ? sizeof(g_first_block) - TLB_LUT_SECTION_SIZE
+        : sizeof(g_first_block);
+    MiscHelpers::memread(&ptr, g_first_block, first_block_size);
 
     const auto si_reg = (core_si_reg *)&g_first_block[0xDC - 0x20];
     if (!check_register_validity(si_reg) || !check_flashram_infos(&g_first_block[0x8021F0 - 0x20]))
@@ -499,7 +635,8 @@ failedLoad:
     // For safety, load .sts in dynarec because it completely avoids this issue by being differently coded
     g_st_old = (interp_addr == 0x80000180 || PC->addr == 0x80000180);
     // doubled because can't just reuse this variable
-    if (interp_addr == 0x80000180 || (PC->addr == 0x80000180 && !dynacore)) g_vr_beq_ignore_jmp = true;
+    if (interp_addr == 0x80000180 || (PC->addr == 0x80000180 && !dynacore))
+        interp_set_feature(INTERP_FEATURE_BEQ_IGNORE_JMP, true);
     if (!dynacore && interpcore)
     {
         // g_core->log_info(L".st jump: {:#06x}, stopped here:{:#06x}", interp_addr, last_addr);
@@ -604,6 +741,111 @@ void savestates_log_tasks()
     g_core->log_info(L"[ST] End task dump");
 }
 
+/**
+ * Decompresses an undo savestate.
+ */
+std::vector<uint8_t> undo_savestate_to_buffer(const t_undo_savestate &st)
+{
+    if (st.raw)
+    {
+        return *st.raw;
+    }
+
+    size_t size = 0;
+    for (const auto &chunk : st.chunks) size += chunk->size;
+
+    std::vector<uint8_t> buffer(size);
+    const auto decompressor = libdeflate_alloc_decompressor();
+    size_t offset = 0;
+    for (const auto &chunk : st.chunks)
+    {
+        libdeflate_deflate_decompress(decompressor, chunk->data.data(), chunk->data.size(), buffer.data() + offset,
+                                      chunk->size, nullptr);
+        offset += chunk->size;
+    }
+    libdeflate_free_decompressor(decompressor);
+    return buffer;
+}
+
+/**
+ * Compresses an undo savestate's chunks, reusing identical chunks already held by other undo savestates.
+ */
+void compress_undo_savestate(const std::weak_ptr<t_undo_savestate> &weak_st, const std::vector<uint8_t> &raw)
+{
+    const auto compressor = libdeflate_alloc_compressor(1);
+    const auto decompressor = libdeflate_alloc_decompressor();
+    std::vector<uint8_t> scratch(UNDO_CHUNK_SIZE);
+    std::vector<std::shared_ptr<const t_undo_chunk>> chunks;
+
+    for (size_t offset = 0; offset < raw.size(); offset += UNDO_CHUNK_SIZE)
+    {
+        const size_t size = std::min(UNDO_CHUNK_SIZE, raw.size() - offset);
+        const uint64_t hash = xxh64::hash((const char *)raw.data() + offset, size, 0);
+
+        std::shared_ptr<const t_undo_chunk> chunk;
+        {
+            std::scoped_lock lock(g_undo_mutex);
+            auto [begin, end] = g_undo_chunk_pool.equal_range(hash);
+            for (auto it = begin; it != end && !chunk; ++it)
+            {
+                const auto candidate = it->second.lock();
+                if (!candidate || candidate->size != size) continue;
+
+                // Verify the match, as a hash collision would silently corrupt the savestate.
+                libdeflate_deflate_decompress(decompressor, candidate->data.data(), candidate->data.size(),
+                                              scratch.data(), size, nullptr);
+                if (!memcmp(scratch.data(), raw.data() + offset, size)) chunk = candidate;
+            }
+        }
+
+        if (!chunk)
+        {
+            t_undo_chunk new_chunk{.size = size};
+            new_chunk.data.resize(libdeflate_deflate_compress_bound(compressor, size));
+            new_chunk.data.resize(libdeflate_deflate_compress(compressor, raw.data() + offset, size,
+                                                              new_chunk.data.data(), new_chunk.data.size()));
+            chunk = std::make_shared<const t_undo_chunk>(std::move(new_chunk));
+
+            std::scoped_lock lock(g_undo_mutex);
+            g_undo_chunk_pool.emplace(hash, chunk);
+        }
+
+        chunks.push_back(chunk);
+    }
+
+    libdeflate_free_decompressor(decompressor);
+    libdeflate_free_compressor(compressor);
+
+    std::scoped_lock lock(g_undo_mutex);
+    if (const auto st = weak_st.lock())
+    {
+        st->chunks = std::move(chunks);
+        st->raw.reset();
+    }
+    std::erase_if(g_undo_chunk_pool, [](const auto &pair) { return pair.second.expired(); });
+}
+
+/**
+ * Pushes a savestate to the undo savestates, evicting the oldest ones past the configured limit, and compresses it in
+ * the background.
+ */
+void push_undo_savestate(const std::vector<uint8_t> &buffer)
+{
+    const auto st = std::make_shared<t_undo_savestate>();
+    st->raw = std::make_shared<const std::vector<uint8_t>>(buffer);
+
+    {
+        std::scoped_lock lock(g_undo_mutex);
+        g_undo_savestates.push_back(st);
+        while (g_undo_savestates.size() > (size_t)std::max(g_core->cfg->st_undo_max_count, 1))
+        {
+            g_undo_savestates.pop_front();
+        }
+    }
+
+    g_core->submit_task([weak_st = std::weak_ptr(st), raw = st->raw] { compress_undo_savestate(weak_st, *raw); });
+}
+
 /**
  * Inserts a save operation at the start of the queue (whose callback assigns the undo savestate buffer) if the task
  * queue contains one or more load operations.
@@ -615,8 +857,8 @@ void savestates_create_undo_point()
         return;
     }
 
-    bool queue_contains_load =
-        std::ranges::any_of(g_tasks, [](const t_savestate_task &task) { return task.job == core_st_job_load; });
+    bool queue_contains_load = std::ranges::any_of(
+        g_tasks, [](const t_savestate_task &task) { return task.job == core_st_job_load && !task.is_undo; });
 
     if (!queue_contains_load)
     {
@@ -636,8 +878,7 @@ void savestates_create_undo_point()
                     return;
                 }
 
-                std::scoped_lock lock(g_task_mutex);
-                g_undo_savestate = buffer;
+                push_undo_savestate(buffer);
             },
         .params =
             {
@@ -687,7 +928,11 @@ void st_on_core_stop()
 {
     std::scoped_lock lock(g_task_mutex);
     g_tasks.clear();
-    g_undo_savestate.clear();
+    g_hot_slots.clear();
+
+    std::scoped_lock undo_lock(g_undo_mutex);
+    g_undo_savestates.clear();
+    g_undo_chunk_pool.clear();
 }
 
 /**
@@ -775,9 +1020,86 @@ bool st_do_memory(const std::vector<uint8_t> &buffer, const core_st_job job, con
     return true;
 }
 
-void st_get_undo_savestate(std::vector<uint8_t> &buffer)
+bool st_undo(const size_t steps, const core_st_callback &callback)
 {
+    std::shared_ptr<t_undo_savestate> st;
+    t_undo_savestate contents;
+    {
+        std::scoped_lock undo_lock(g_undo_mutex);
+        if (steps == 0 || steps > g_undo_savestates.size())
+        {
+            g_core->log_trace(std::format(L"[ST] undo: No undo savestate {} steps back.", steps));
+            return false;
+        }
+        st = g_undo_savestates[g_undo_savestates.size() - steps];
+
+        // The background compression swaps the contents under the lock, so take a reference to them while holding it.
+        contents = *st;
+    }
+
+    auto buffer = undo_savestate_to_buffer(contents);
+
     std::scoped_lock lock(g_task_mutex);
-    buffer.clear();
-    buffer = g_undo_savestate;
+
+    if (!can_push_work())
+    {
+        g_core->log_trace(L"[ST] undo: Can't enqueue work.");
+        return false;
+    }
+
+    auto internal_callback_wrapper = [=](const core_st_callback_info &info, const std::vector<uint8_t> &buffer) {
+        if (info.result == Res_Ok)
+        {
+            // The restored undo savestate and all newer ones are now in the future, so they can't be undone to.
+            std::scoped_lock undo_lock(g_undo_mutex);
+            if (const auto it = std::ranges::find(g_undo_savestates, st); it != g_undo_savestates.end())
+            {
+                g_undo_savestates.erase(it, g_undo_savestates.end());
+            }
+        }
+
+        g_core->st_pre_callback(info, buffer);
+        if (callback)
+        {
+            callback(info, buffer);
+        }
+    };
+
+    const t_savestate_task task = {
+        .job = core_st_job_load,
+        .medium = core_st_medium_memory,
+        .callback = internal_callback_wrapper,
+        .params = {.buffer = std::move(buffer)},
+        .ignore_warnings = true,
+        .is_undo = true,
+    };
+
+    g_tasks.insert(g_tasks.begin(), task);
+    return true;
+}
+
+size_t st_get_undo_count()
+{
+    std::scoped_lock lock(g_undo_mutex);
+    return g_undo_savestates.size();
+}
+
+size_t st_get_undo_memory_usage()
+{
+    std::scoped_lock lock(g_undo_mutex);
+
+    size_t usage = 0;
+    std::vector<const t_undo_chunk *> chunks;
+    for (const auto &st : g_undo_savestates)
+    {
+        if (st->raw) usage += st->raw->size();
+        for (const auto &chunk : st->chunks) chunks.push_back(chunk.get());
+    }
+
+    std::ranges::sort(chunks);
+    const auto [first, last] = std::ranges::unique(chunks);
+    chunks.erase(first, last);
+    for (const auto chunk : chunks) usage += chunk->data.size();
+
+    return usage;
 }
@@ -19,7 +19,7 @@ extern bool g_st_old;
 void st_do_work();
 
 /**
- * Clears the work queue and the undo savestate.
+ * Clears the work queue, the undo savestates, and the savestate files cached in memory.
  */
 void st_on_core_stop();
 
@@ -27,4 +27,6 @@ bool st_do_file(const std::filesystem::path &path, core_st_job job, const core_s
                 bool ignore_warnings);
 bool st_do_memory(const std::vector<uint8_t> &buffer, core_st_job job, const core_st_callback &callback,
                   bool ignore_warnings);
-void st_get_undo_savestate(std::vector<uint8_t> &buffer);
+bool st_undo(size_t steps, const core_st_callback &callback);
+size_t st_get_undo_count();
+size_t st_get_undo_memory_usage();
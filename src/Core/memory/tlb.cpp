@@ -21,17 +21,94 @@ uint32_t tlb_LUT_w[0x100000];
 extern uint32_t interp_addr;
 int32_t jump_marker = 0;
 
-uint32_t virtual_to_physical_address(uint32_t addresse, int32_t w)
+/**
+ * \brief Fills the LUT entries covering one half of a TLB entry.
+ * \param start The first virtual address of the range.
+ * \param end The last virtual address of the range.
+ * \param phys The physical address the range maps to.
+ * \param dirty Whether the range is writable.
+ */
+static void tlb_map_range(uint32_t start, uint32_t end, uint32_t phys, bool dirty)
+{
+    if (start >= end || (start >= 0x80000000 && end < 0xC0000000) || phys >= 0x20000000) return;
+
+    // Walks pages instead of bytes, but yields exactly what writing every address in [start, end) would, since the
+    // last address written in each page wins.
+    for (uint32_t page = start >> 12; page <= (end - 1) >> 12; page++)
+    {
+        const uint32_t last = std::min(end - 1, (page << 12) | 0xFFF);
+        tlb_LUT_r[page] = 0x80000000 | (phys + (last - start));
+        if (dirty) tlb_LUT_w[page] = tlb_LUT_r[page];
+    }
+}
+
+void tlb_rebuild_luts()
 {
-    if (addresse >= 0x7f000000 && addresse < 0x80000000) // golden eye hack (it uses TLB a lot)
+    memset(tlb_LUT_r, 0, sizeof(tlb_LUT_r));
+    memset(tlb_LUT_w, 0, sizeof(tlb_LUT_w));
+
+    for (const auto &entry : tlb_e)
     {
-        if (ROM_HEADER.CRC1 == std::byteswap(0xDCBC50D1)) // US
-            return 0xb0034b30 + (addresse & 0xFFFFFF);
-        if (ROM_HEADER.CRC1 == std::byteswap(0x0414CA61)) // E
-            return 0xb00329f0 + (addresse & 0xFFFFFF);
-        if (ROM_HEADER.CRC1 == std::byteswap(0xA24F4CF1)) // J
-            return 0xb0034b70 + (addresse & 0xFFFFFF);
+        if (entry.v_even) tlb_map_range(entry.start_even, entry.end_even, entry.phys_even, entry.d_even);
+        if (entry.v_odd) tlb_map_range(entry.start_odd, entry.end_odd, entry.phys_odd, entry.d_odd);
+    }
+}
+
+/**
+ * \brief A virtual address range which a game accesses without mapping it through the TLB.
+ */
+struct tlb_quirk
+{
+    /**
+     * \brief The game's CRC1, as shown in the ROM header.
+     */
+    uint32_t crc1;
+
+    uint32_t start;
+    uint32_t end;
+
+    /**
+     * \brief The address the start of the range translates to.
+     */
+    uint32_t target;
+};
+
+static constexpr tlb_quirk TLB_QUIRKS[] = {
+    // GoldenEye streams data from ROM through TLB misses, which are far too slow to emulate.
+    {0xDCBC50D1, 0x7F000000, 0x80000000, 0xB0034B30}, // GoldenEye 007 (U)
+    {0x0414CA61, 0x7F000000, 0x80000000, 0xB00329F0}, // GoldenEye 007 (E)
+    {0xA24F4CF1, 0x7F000000, 0x80000000, 0xB0034B70}, // GoldenEye 007 (J)
+};
+
+static std::vector<tlb_quirk> active_tlb_quirks;
+
+void tlb_init_quirks()
+{
+    active_tlb_quirks.clear();
+    for (const auto &quirk : TLB_QUIRKS)
+    {
+        if (ROM_HEADER.CRC1 == std::byteswap(quirk.crc1))
+        {
+            active_tlb_quirks.push_back(quirk);
+        }
     }
+}
+
+/**
+ * \brief Translates an address which isn't in the LUTs, raising a TLB refill exception if no quirk covers it either.
+ */
+static uint32_t tlb_translate_miss(uint32_t addresse, int32_t w)
+{
+    for (const auto &quirk : active_tlb_quirks)
+    {
+        if (addresse >= quirk.start && addresse < quirk.end) return quirk.target + (addresse - quirk.start);
+    }
+    TLB_refill_exception(addresse, w);
+    return 0x00000000;
+}
+
+uint32_t virtual_to_physical_address(uint32_t addresse, int32_t w)
+{
     if (w == 1)
     {
         if (tlb_LUT_w[addresse >> 12]) return (tlb_LUT_w[addresse >> 12] & 0xFFFFF000) | (addresse & 0xFFF);
@@ -40,8 +117,7 @@ uint32_t virtual_to_physical_address(uint32_t addresse, int32_t w)
     {
         if (tlb_LUT_r[addresse >> 12]) return (tlb_LUT_r[addresse >> 12] & 0xFFFFF000) | (addresse & 0xFFF);
     }
-    TLB_refill_exception(addresse, w);
-    return 0x00000000;
+    return tlb_translate_miss(addresse, w);
 }
 
 int32_t probe_nop(uint32_t address)
@@ -156,18 +232,8 @@ void TLBWI()
 
     if (tlb_e[core_Index & 0x3F].v_even)
     {
-        if (tlb_e[core_Index & 0x3F].start_even < tlb_e[core_Index & 0x3F].end_even &&
-            !(tlb_e[core_Index & 0x3F].start_even >= 0x80000000 && tlb_e[core_Index & 0x3F].end_even < 0xC0000000) &&
-            tlb_e[core_Index & 0x3F].phys_even < 0x20000000)
-        {
-            for (i = tlb_e[core_Index & 0x3F].start_even; i < tlb_e[core_Index & 0x3F].end_even; i++)
-                tlb_LUT_r[i >> 12] =
-                    0x80000000 | (tlb_e[core_Index & 0x3F].phys_even + (i - tlb_e[core_Index & 0x3F].start_even));
-            if (tlb_e[core_Index & 0x3F].d_even)
-                for (i = tlb_e[core_Index & 0x3F].start_even; i < tlb_e[core_Index & 0x3F].end_even; i++)
-                    tlb_LUT_w[i >> 12] =
-                        0x80000000 | (tlb_e[core_Index & 0x3F].phys_even + (i - tlb_e[core_Index & 0x3F].start_even));
-        }
+        tlb_map_range(tlb_e[core_Index & 0x3F].start_even, tlb_e[core_Index & 0x3F].end_even,
+                      tlb_e[core_Index & 0x3F].phys_even, tlb_e[core_Index & 0x3F].d_even);
 
         for (i = tlb_e[core_Index & 0x3F].start_even >> 12; i <= tlb_e[core_Index & 0x3F].end_even >> 12; i++)
         {
@@ -185,18 +251,8 @@ void TLBWI()
 
     if (tlb_e[core_Index & 0x3F].v_odd)
     {
-        if (tlb_e[core_Index & 0x3F].start_odd < tlb_e[core_Index & 0x3F].end_odd &&
-            !(tlb_e[core_Index & 0x3F].start_odd >= 0x80000000 && tlb_e[core_Index & 0x3F].end_odd < 0xC0000000) &&
-            tlb_e[core_Index & 0x3F].phys_odd < 0x20000000)
-        {
-            for (i = tlb_e[core_Index & 0x3F].start_odd; i < tlb_e[core_Index & 0x3F].end_odd; i++)
-                tlb_LUT_r[i >> 12] =
-                    0x80000000 | (tlb_e[core_Index & 0x3F].phys_odd + (i - tlb_e[core_Index & 0x3F].start_odd));
-            if (tlb_e[core_Index & 0x3F].d_odd)
-                for (i = tlb_e[core_Index & 0x3F].start_odd; i < tlb_e[core_Index & 0x3F].end_odd; i++)
-                    tlb_LUT_w[i >> 12] =
-                        0x80000000 | (tlb_e[core_Index & 0x3F].phys_odd + (i - tlb_e[core_Index & 0x3F].start_odd));
-        }
+        tlb_map_range(tlb_e[core_Index & 0x3F].start_odd, tlb_e[core_Index & 0x3F].end_odd,
+                      tlb_e[core_Index & 0x3F].phys_odd, tlb_e[core_Index & 0x3F].d_odd);
 
         for (i = tlb_e[core_Index & 0x3F].start_odd >> 12; i <= tlb_e[core_Index & 0x3F].end_odd >> 12; i++)
         {
@@ -276,17 +332,8 @@ void TLBWR()
 
     if (tlb_e[core_Random].v_even)
     {
-        if (tlb_e[core_Random].start_even < tlb_e[core_Random].end_even &&
-            !(tlb_e[core_Random].start_even >= 0x80000000 && tlb_e[core_Random].end_even < 0xC0000000) &&
-            tlb_e[core_Random].phys_even < 0x20000000)
-        {
-            for (i = tlb_e[core_Random].start_even; i < tlb_e[core_Random].end_even; i++)
-                tlb_LUT_r[i >> 12] = 0x80000000 | (tlb_e[core_Random].phys_even + (i - tlb_e[core_Random].start_even));
-            if (tlb_e[core_Random].d_even)
-                for (i = tlb_e[core_Random].start_even; i < tlb_e[core_Random].end_even; i++)
-                    tlb_LUT_w[i >> 12] =
-                        0x80000000 | (tlb_e[core_Random].phys_even + (i - tlb_e[core_Random].start_even));
-        }
+        tlb_map_range(tlb_e[core_Random].start_even, tlb_e[core_Random].end_even,
+                      tlb_e[core_Random].phys_even, tlb_e[core_Random].d_even);
 
         for (i = tlb_e[core_Random].start_even >> 12; i <= tlb_e[core_Random].end_even >> 12; i++)
         {
@@ -303,17 +350,8 @@ void TLBWR()
 
     if (tlb_e[core_Random].v_odd)
     {
-        if (tlb_e[core_Random].start_odd < tlb_e[core_Random].end_odd &&
-            !(tlb_e[core_Random].start_odd >= 0x80000000 && tlb_e[core_Random].end_odd < 0xC0000000) &&
-            tlb_e[core_Random].phys_odd < 0x20000000)
-        {
-            for (i = tlb_e[core_Random].start_odd; i < tlb_e[core_Random].end_odd; i++)
-                tlb_LUT_r[i >> 12] = 0x80000000 | (tlb_e[core_Random].phys_odd + (i - tlb_e[core_Random].start_odd));
-            if (tlb_e[core_Random].d_odd)
-                for (i = tlb_e[core_Random].start_odd; i < tlb_e[core_Random].end_odd; i++)
-                    tlb_LUT_w[i >> 12] =
-                        0x80000000 | (tlb_e[core_Random].phys_odd + (i - tlb_e[core_Random].start_odd));
-        }
+        tlb_map_range(tlb_e[core_Random].start_odd, tlb_e[core_Random].end_odd,
+                      tlb_e[core_Random].phys_odd, tlb_e[core_Random].d_odd);
 
         for (i = tlb_e[core_Random].start_odd >> 12; i <= tlb_e[core_Random].end_odd >> 12; i++)
         {
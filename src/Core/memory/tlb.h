@@ -35,3 +35,14 @@ extern uint32_t tlb_LUT_r[0x100000];
 extern uint32_t tlb_LUT_w[0x100000];
 uint32_t virtual_to_physical_address(uint32_t addresse, int32_t w);
 int32_t probe_nop(uint32_t address);
+
+/**
+ * \brief Resolves the address translation quirks of the loaded ROM. Quirks only apply to addresses which no TLB entry
+ * maps, so the LUT lookup stays the only work on the translation path.
+ */
+void tlb_init_quirks();
+
+/**
+ * \brief Regenerates the TLB LUTs from the current TLB entries.
+ */
+void tlb_rebuild_luts();
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include <r4300/const_prop.h>
+
+// k0 and k1 belong to the exception handlers, which may run between any two instructions accessing memory
+#define UNTRACKED_GPRS ((1 << 26) | (1 << 27))
+
+/**
+ * \brief Decodes an arithmetic instruction without side effects, whose result is a sign-extended 32-bit value.
+ * \param op The instruction.
+ * \param dest Receives the register written by the instruction.
+ * \param reads Receives the registers read by the instruction as a bitmask.
+ * \return Whether the instruction is such an instruction.
+ */
+static bool decode_alu(const uint32_t op, uint32_t &dest, uint32_t &reads)
+{
+    const uint32_t rs = (op >> 21) & 0x1F;
+    const uint32_t rt = (op >> 16) & 0x1F;
+    const uint32_t rd = (op >> 11) & 0x1F;
+
+    switch (op >> 26)
+    {
+    case 0x00:
+        switch (op & 0x3F)
+        {
+        case 0x00: // SLL
+        case 0x02: // SRL
+        case 0x03: // SRA
+            reads = 1 << rt;
+            dest = rd;
+            return true;
+        case 0x20: // ADD
+        case 0x21: // ADDU
+        case 0x22: // SUB
+        case 0x23: // SUBU
+        case 0x24: // AND
+        case 0x25: // OR
+        case 0x26: // XOR
+        case 0x27: // NOR
+        case 0x2A: // SLT
+        case 0x2B: // SLTU
+            reads = (1 << rs) | (1 << rt);
+            dest = rd;
+            return true;
+        default:
+            return false;
+        }
+    case 0x08: // ADDI
+    case 0x09: // ADDIU
+    case 0x0A: // SLTI
+    case 0x0B: // SLTIU
+    case 0x0C: // ANDI
+    case 0x0D: // ORI
+    case 0x0E: // XORI
+        reads = 1 << rs;
+        dest = rt;
+        return true;
+    case 0x0F: // LUI
+        reads = 0;
+        dest = rt;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * \brief Computes the result of an instruction accepted by <c>decode_alu</c>, matching the interpreter.
+ */
+static int32_t evaluate_alu(const uint32_t op, const int32_t *values)
+{
+    const int32_t rs = values[(op >> 21) & 0x1F];
+    const int32_t rt = values[(op >> 16) & 0x1F];
+    const uint32_t sa = (op >> 6) & 0x1F;
+    const int32_t imm = (int16_t)op;
+    const uint32_t uimm = (uint16_t)op;
+
+    // The operands are sign-extended, so comparing their low words gives the same order as the interpreter's 64-bit
+    // comparisons, signed or not.
+    switch (op >> 26)
+    {
+    case 0x00:
+        switch (op & 0x3F)
+        {
+        case 0x00:
+            return (int32_t)((uint32_t)rt << sa);
+        case 0x02:
+            return (int32_t)((uint32_t)rt >> sa);
+        case 0x03:
+            return rt >> sa;
+        case 0x20:
+        case 0x21:
+            return (int32_t)((uint32_t)rs + (uint32_t)rt);
+        case 0x22:
+        case 0x23:
+            return (int32_t)((uint32_t)rs - (uint32_t)rt);
+        case 0x24:
+            return rs & rt;
+        case 0x25:
+            return rs | rt;
+        case 0x26:
+            return rs ^ rt;
+        case 0x27:
+            return ~(rs | rt);
+        case 0x2A:
+            return rs < rt;
+        case 0x2B:
+            return (uint32_t)rs < (uint32_t)rt;
+        }
+        break;
+    case 0x08:
+    case 0x09:
+        return (int32_t)((uint32_t)rs + (uint32_t)imm);
+    case 0x0A:
+        return rs < imm;
+    case 0x0B:
+        return (uint32_t)rs < (uint32_t)imm;
+    case 0x0C:
+        return (int32_t)(rs & uimm);
+    case 0x0D:
+        return (int32_t)(rs | uimm);
+    case 0x0E:
+        return (int32_t)(rs ^ uimm);
+    case 0x0F:
+        return (int32_t)(uimm << 16);
+    }
+    return 0;
+}
+
+/**
+ * \brief Gets the registers an instruction may write as a bitmask, erring on the side of too many.
+ */
+static uint32_t get_writes(const uint32_t op)
+{
+    switch (op >> 26)
+    {
+    case 0x00: // SPECIAL
+        return 1 << ((op >> 11) & 0x1F);
+    case 0x01: // REGIMM
+    case 0x03: // JAL
+        return 1 << 31;
+    case 0x02: // J
+    case 0x04: // BEQ
+    case 0x05: // BNE
+    case 0x06: // BLEZ
+    case 0x07: // BGTZ
+    case 0x14: // BEQL
+    case 0x15: // BNEL
+    case 0x16: // BLEZL
+    case 0x17: // BGTZL
+    case 0x28: // SB
+    case 0x29: // SH
+    case 0x2A: // SWL
+    case 0x2B: // SW
+    case 0x2C: // SDL
+    case 0x2D: // SDR
+    case 0x2E: // SWR
+    case 0x2F: // CACHE
+    case 0x31: // LWC1
+    case 0x35: // LDC1
+    case 0x39: // SWC1
+    case 0x3D: // SDC1
+    case 0x3F: // SD
+        return 0;
+    default:
+        return 1 << ((op >> 16) & 0x1F);
+    }
+}
+
+void const_prop_reset(const_state &state)
+{
+    state.known = 1;
+    state.values[0] = 0;
+}
+
+void const_prop_step(const_state &state, const uint32_t op)
+{
+    uint32_t gpr, reads;
+    int32_t value;
+    if (const_prop_fold(state, op, gpr, value, reads))
+    {
+        state.known |= 1 << gpr;
+        state.values[gpr] = value;
+    }
+    else
+    {
+        state.known &= ~get_writes(op) | 1;
+    }
+    state.known &= ~UNTRACKED_GPRS;
+}
+
+bool const_prop_fold(const const_state &state, const uint32_t op, uint32_t &gpr, int32_t &value, uint32_t &reads)
+{
+    if (!decode_alu(op, gpr, reads) || gpr == 0 || (reads & ~state.known)) return false;
+
+    value = evaluate_alu(op, state.values);
+    return true;
+}
+
+bool const_prop_is_control(const uint32_t op)
+{
+    switch (op >> 26)
+    {
+    case 0x00:
+        return (op & 0x3F) == 0x08 || (op & 0x3F) == 0x09; // JR, JALR
+    case 0x01:
+        return (((op >> 16) & 0x1F) & ~0x13) == 0; // BLTZ, BGEZ, BLTZL, BGEZL and their linking variants
+    case 0x02:
+    case 0x03:
+    case 0x04:
+    case 0x05:
+    case 0x06:
+    case 0x07:
+    case 0x14:
+    case 0x15:
+    case 0x16:
+    case 0x17:
+        return true;
+    case 0x11:
+        return ((op >> 21) & 0x1F) == 0x08; // BC1
+    default:
+        return false;
+    }
+}
+
+bool const_prop_is_barrier(const uint32_t op)
+{
+    switch (op >> 26)
+    {
+    case 0x00:
+        // SYSCALL, BREAK and the traps
+        return (op & 0x3F) == 0x0C || (op & 0x3F) == 0x0D || ((op & 0x3F) >= 0x30 && (op & 0x3F) <= 0x36);
+    case 0x01:
+        // The traps
+        return ((op >> 16) & 0x1F) >= 0x08 && ((op >> 16) & 0x1F) <= 0x0E;
+    case 0x10:
+        // COP0 instructions may raise interrupts or return from exceptions
+        return true;
+    default:
+        return false;
+    }
+}
+
+void const_prop_find_targets(const int32_t *source, const uint32_t start, const int32_t length, uint32_t *targets)
+{
+    memset(targets, 0, ((length + 31) / 32) * sizeof(uint32_t));
+
+    for (int32_t i = 0; i < length; i++)
+    {
+        const uint32_t op = source[i];
+        const uint32_t addr = start + i * 4;
+        uint32_t target;
+
+        if (!const_prop_is_control(op) || (op >> 26) == 0x00)
+        {
+            // Register jumps can't be followed
+            continue;
+        }
+        if ((op >> 26) == 0x02 || (op >> 26) == 0x03)
+            target = ((addr + 4) & 0xF0000000) | ((op & 0x3FFFFFF) << 2);
+        else
+            target = addr + 4 + (int32_t)(int16_t)op * 4;
+
+        const uint32_t index = (target - start) / 4;
+        if (target - start < (uint32_t)length * 4) targets[index / 32] |= 1 << (index % 32);
+    }
+}
+
+bool const_prop_is_dead(const int32_t *source, const int32_t count)
+{
+    uint32_t dest, reads;
+    if (!decode_alu(source[0], dest, reads) || dest == 0) return false;
+
+    for (int32_t i = 1; i < count; i++)
+    {
+        uint32_t next_dest, next_reads;
+        if (!decode_alu(source[i], next_dest, next_reads) || (next_reads >> dest & 1)) return false;
+        if (next_dest == dest) return true;
+    }
+    return false;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+/**
+ * \brief The GPRs known to hold a constant at some point of a block while it's being recompiled. Every tracked
+ * instruction produces a sign-extended 32-bit value, so a known register is fully described by its low word.
+ */
+struct const_state
+{
+    uint32_t known;
+    int32_t values[32];
+};
+
+/**
+ * \brief Forgets everything but r0.
+ */
+void const_prop_reset(const_state &state);
+
+/**
+ * \brief Advances the state past an instruction.
+ */
+void const_prop_step(const_state &state, uint32_t op);
+
+/**
+ * \brief Computes the result of an instruction whose operands are all known.
+ * \param state The state before the instruction.
+ * \param op The instruction.
+ * \param gpr Receives the register written by the instruction.
+ * \param value Receives the value written by the instruction.
+ * \param reads Receives the registers read by the instruction as a bitmask.
+ * \return Whether the instruction is a side effect free arithmetic instruction whose result is known.
+ */
+bool const_prop_fold(const const_state &state, uint32_t op, uint32_t &gpr, int32_t &value, uint32_t &reads);
+
+/**
+ * \brief Gets whether an instruction is a branch or a jump, after whose delay slot nothing is known anymore.
+ */
+bool const_prop_is_control(uint32_t op);
+
+/**
+ * \brief Gets whether the registers may hold anything after an instruction, e.g. because it raises an exception whose
+ * handler returns past it.
+ */
+bool const_prop_is_barrier(uint32_t op);
+
+/**
+ * \brief Marks the instructions of a code page which are targets of branches or jumps in the same page.
+ * \param source The page's instructions.
+ * \param start The page's address.
+ * \param length The number of instructions in the page.
+ * \param targets Receives one bit per instruction, which must have room for <c>length</c> bits.
+ */
+void const_prop_find_targets(const int32_t *source, uint32_t start, int32_t length, uint32_t *targets);
+
+/**
+ * \brief Gets whether an arithmetic instruction's result is overwritten by one of the following instructions before
+ * anything can observe it. Only arithmetic instructions are looked through, since anything else may leave the block.
+ * \param source The instruction, followed by the instructions executed after it.
+ * \param count The number of instructions in <c>source</c>.
+ */
+bool const_prop_is_dead(const int32_t *source, int32_t count);
@@ -11,55 +11,51 @@
 #include <r4300/ops.h>
 #include <r4300/r4300.h>
 
+template <bool FloatExceptions>
 void ADD_D()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    CHECK_INPUT(*reg_cop1_double[core_cfft]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_double[core_cffs] + *reg_cop1_double[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_double[core_cffs] + *reg_cop1_double[core_cfft],
+                         *reg_cop1_double[core_cffs], *reg_cop1_double[core_cfft]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void SUB_D()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    CHECK_INPUT(*reg_cop1_double[core_cfft]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_double[core_cffs] - *reg_cop1_double[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_double[core_cffs] - *reg_cop1_double[core_cfft],
+                         *reg_cop1_double[core_cffs], *reg_cop1_double[core_cfft]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void MUL_D()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    CHECK_INPUT(*reg_cop1_double[core_cfft]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_double[core_cffs] * *reg_cop1_double[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_double[core_cffs] * *reg_cop1_double[core_cfft],
+                         *reg_cop1_double[core_cffs], *reg_cop1_double[core_cfft]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void DIV_D()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    CHECK_INPUT(*reg_cop1_double[core_cfft]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_double[core_cffs] / *reg_cop1_double[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_double[core_cffs] / *reg_cop1_double[core_cfft],
+                         *reg_cop1_double[core_cffs], *reg_cop1_double[core_cfft]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void SQRT_D()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    *reg_cop1_double[core_cffd] = sqrt(*reg_cop1_double[core_cffs]);
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], sqrt(*reg_cop1_double[core_cffs]), *reg_cop1_double[core_cffs]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void ABS_D()
 {
     if (check_cop1_unusable()) return;
@@ -77,6 +73,7 @@ void MOV_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void NEG_D()
 {
     if (check_cop1_unusable()) return;
@@ -86,6 +83,7 @@ void NEG_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void ROUND_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -97,6 +95,7 @@ void ROUND_L_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void TRUNC_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -108,6 +107,7 @@ void TRUNC_L_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void CEIL_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -119,6 +119,7 @@ void CEIL_L_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void FLOOR_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -130,6 +131,7 @@ void FLOOR_L_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void ROUND_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -141,6 +143,7 @@ void ROUND_W_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void TRUNC_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -152,6 +155,7 @@ void TRUNC_W_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void CEIL_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -163,6 +167,7 @@ void CEIL_W_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void FLOOR_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -174,23 +179,28 @@ void FLOOR_W_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void CVT_S_D()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
     if (g_core->cfg->wii_vc_emulation)
     {
         set_trunc();
     }
-    *reg_cop1_simple[core_cffd] = *reg_cop1_double[core_cffs];
+    float result = (float)*reg_cop1_double[core_cffs];
     if (g_core->cfg->wii_vc_emulation)
     {
         set_rounding();
     }
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    if (!check_float_result<FloatExceptions>(result, *reg_cop1_double[core_cffs]))
+    {
+        return;
+    }
+    *reg_cop1_simple[core_cffd] = result;
     PC++;
 }
 
+template <bool FloatExceptions>
 void CVT_W_D()
 {
     if (check_cop1_unusable()) return;
@@ -200,6 +210,7 @@ void CVT_W_D()
     PC++;
 }
 
+template <bool FloatExceptions>
 void CVT_L_D()
 {
     if (check_cop1_unusable()) return;
@@ -393,3 +404,41 @@ void C_NGT_D()
         FCR31 &= ~0x800000;
     PC++;
 }
+
+// Both specializations are referenced through FLOAT_OP
+template void ADD_D<false>();
+template void ADD_D<true>();
+template void SUB_D<false>();
+template void SUB_D<true>();
+template void MUL_D<false>();
+template void MUL_D<true>();
+template void DIV_D<false>();
+template void DIV_D<true>();
+template void SQRT_D<false>();
+template void SQRT_D<true>();
+template void ABS_D<false>();
+template void ABS_D<true>();
+template void NEG_D<false>();
+template void NEG_D<true>();
+template void ROUND_L_D<false>();
+template void ROUND_L_D<true>();
+template void TRUNC_L_D<false>();
+template void TRUNC_L_D<true>();
+template void CEIL_L_D<false>();
+template void CEIL_L_D<true>();
+template void FLOOR_L_D<false>();
+template void FLOOR_L_D<true>();
+template void ROUND_W_D<false>();
+template void ROUND_W_D<true>();
+template void TRUNC_W_D<false>();
+template void TRUNC_W_D<true>();
+template void CEIL_W_D<false>();
+template void CEIL_W_D<true>();
+template void FLOOR_W_D<false>();
+template void FLOOR_W_D<true>();
+template void CVT_S_D<false>();
+template void CVT_S_D<true>();
+template void CVT_W_D<false>();
+template void CVT_W_D<true>();
+template void CVT_L_D<false>();
+template void CVT_L_D<true>();
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "macros.h"
+#include <pmmintrin.h>
 
 extern float largest_denormal_float;
 extern double largest_denormal_double;
@@ -16,46 +17,115 @@ void fail_float_input_arg(double x);
 void fail_float_output();
 void fail_float_convert();
 
+// The checks below are used by COP1 ops specialized on a `bool FloatExceptions` template parameter, so they compile to
+// nothing when float exceptions aren't emulated.
+
 #define LARGEST_DENORMAL(x) (sizeof(x) == 4 ? largest_denormal_float : largest_denormal_double)
 
+/**
+ * \brief The sticky SSE exception flags which may indicate an emulated float exception. Overflow and inexact results
+ * never fault, so their flags are ignored.
+ */
+constexpr uint32_t FLOAT_FAULT_FLAGS = _MM_EXCEPT_INVALID | _MM_EXCEPT_DENORM | _MM_EXCEPT_UNDERFLOW;
+
+/**
+ * \brief Prepares the calling thread's SSE control register for float exception emulation: exception flags are cleared,
+ * and underflowing results are flushed to zero in hardware, which is what the precise check does for them too.
+ * Denormal inputs must still be detected, so DAZ is left off.
+ * \return The previous register value, to be restored with _mm_setcsr once emulation stops.
+ */
+inline uint32_t begin_float_exception_emulation()
+{
+    const uint32_t csr = _mm_getcsr();
+    _mm_setcsr((csr | _MM_FLUSH_ZERO_ON) & ~(_MM_EXCEPT_MASK | _MM_DENORMALS_ZERO_MASK));
+    return csr;
+}
+
+/**
+ * \brief Checks an arithmetic result and its inputs for emulated float exceptions, raising the exception if one occurs.
+ * Denormal or NaN inputs and NaN results fault, while denormal results are flushed to zero.
+ * \return Whether the result is valid and may be written back.
+ */
+template <typename T, typename... Inputs>
+bool check_float_result_precise(T &result, const Inputs... inputs)
+{
+    _mm_setcsr(_mm_getcsr() & ~_MM_EXCEPT_MASK);
+
+    const auto check_input = [](const auto x) {
+        if (fabs(x) > LARGEST_DENORMAL(x) || x == 0)
+        {
+            return true;
+        }
+        fail_float_input_arg(x);
+        return false;
+    };
+
+    if (!(check_input(inputs) && ...))
+    {
+        return false;
+    }
+
+    if (!(fabs(result) > LARGEST_DENORMAL(result)))
+    {
+        if (isnan(result))
+        {
+            fail_float_output();
+            return false;
+        }
+        // Denormal inputs fault, so a denormal result is flushed to zero rather than failing the next operation.
+        result = (T)copysign(0, result);
+    }
+    return true;
+}
+
+/**
+ * \brief Checks an arithmetic result for emulated float exceptions. The host's sticky exception flags are tested
+ * instead of the operands: they stay clear as long as no operation faults, so the precise check only runs when a flag
+ * is set or the result is NaN, which also covers quiet NaN inputs as they propagate without raising a flag.
+ * \return Whether the result is valid and may be written back.
+ */
+template <bool FloatExceptions, typename T, typename... Inputs>
+bool check_float_result(T &result, const Inputs... inputs)
+{
+    if constexpr (FloatExceptions)
+    {
+        if (isnan(result) || (_mm_getcsr() & FLOAT_FAULT_FLAGS))
+        {
+            return check_float_result_precise(result, inputs...);
+        }
+    }
+    return true;
+}
+
 #define CHECK_INPUT(x)                                                                                                 \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (g_core->cfg->float_exception_emulation && !(fabs(x) > LARGEST_DENORMAL(x)) && x != 0)                      \
+        if (FloatExceptions && !(fabs(x) > LARGEST_DENORMAL(x)) && x != 0)                                             \
         {                                                                                                              \
             fail_float_input_arg(x);                                                                                   \
             return;                                                                                                    \
         }                                                                                                              \
     } while (0)
 
-#define CHECK_OUTPUT(x)                                                                                                \
+// Computes an arithmetic result from the given inputs and writes it to dst unless the operation faults.
+#define CHECKED_FLOAT_RESULT(dst, expr, ...)                                                                           \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (g_core->cfg->float_exception_emulation && !(fabs(x) > LARGEST_DENORMAL(x)))                                \
+        std::remove_reference_t<decltype(dst)> result = (expr);                                                        \
+        if (!check_float_result<FloatExceptions>(result, __VA_ARGS__))                                                 \
         {                                                                                                              \
-            if (isnan(x))                                                                                              \
-            {                                                                                                          \
-                fail_float_output();                                                                                   \
-                return;                                                                                                \
-            }                                                                                                          \
-            else                                                                                                       \
-            {                                                                                                          \
-                /* Flush denormals to zero manually, since x87 doesn't have a built-in */                              \
-                /* way to do it. Typically this doesn't matter, because denormals are */                               \
-                /* too small to cause visible console/emu divergences, but since we */                                 \
-                /* check for them on entry to each operation this becomes important... */                              \
-                x = copysign(0, x);                                                                                    \
-            }                                                                                                          \
+            return;                                                                                                    \
         }                                                                                                              \
+        dst = result;                                                                                                  \
     } while (0)
 
 #ifdef _M_X64
 #define CHECK_CONVERT_EXCEPTIONS()                                                                                     \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (g_core->cfg->float_exception_emulation)                                                                    \
+        if (FloatExceptions)                                                                                           \
         {                                                                                                              \
-            if (fetestexcept(FE_ALL_EXCEPT & (~FE_INEXACT)))                                                           \
+            if (_mm_getcsr() & _MM_EXCEPT_INVALID)                                                                     \
             {                                                                                                          \
                 fail_float_convert();                                                                                  \
                 return;                                                                                                \
@@ -66,7 +136,7 @@ void fail_float_convert();
 #define CHECK_CONVERT_EXCEPTIONS()                                                                                     \
     do                                                                                                                 \
     {                                                                                                                  \
-        if (g_core->cfg->float_exception_emulation)                                                                    \
+        if (FloatExceptions)                                                                                           \
         {                                                                                                              \
             read_x87_status_word();                                                                                    \
             if (x87_status_word & 1)                                                                                   \
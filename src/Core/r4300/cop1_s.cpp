@@ -11,55 +11,51 @@
 #include <r4300/macros.h>
 #include <r4300/cop1_helpers.h>
 
+template <bool FloatExceptions>
 void ADD_S()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    CHECK_INPUT(*reg_cop1_simple[core_cfft]);
-    *reg_cop1_simple[core_cffd] = *reg_cop1_simple[core_cffs] + *reg_cop1_simple[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], *reg_cop1_simple[core_cffs] + *reg_cop1_simple[core_cfft],
+                         *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cfft]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void SUB_S()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    CHECK_INPUT(*reg_cop1_simple[core_cfft]);
-    *reg_cop1_simple[core_cffd] = *reg_cop1_simple[core_cffs] - *reg_cop1_simple[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], *reg_cop1_simple[core_cffs] - *reg_cop1_simple[core_cfft],
+                         *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cfft]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void MUL_S()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    CHECK_INPUT(*reg_cop1_simple[core_cfft]);
-    *reg_cop1_simple[core_cffd] = *reg_cop1_simple[core_cffs] * *reg_cop1_simple[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], *reg_cop1_simple[core_cffs] * *reg_cop1_simple[core_cfft],
+                         *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cfft]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void DIV_S()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    CHECK_INPUT(*reg_cop1_simple[core_cfft]);
-    *reg_cop1_simple[core_cffd] = *reg_cop1_simple[core_cffs] / *reg_cop1_simple[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], *reg_cop1_simple[core_cffs] / *reg_cop1_simple[core_cfft],
+                         *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cfft]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void SQRT_S()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    *reg_cop1_simple[core_cffd] = sqrt(*reg_cop1_simple[core_cffs]);
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], sqrt(*reg_cop1_simple[core_cffs]), *reg_cop1_simple[core_cffs]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void ABS_S()
 {
     if (check_cop1_unusable()) return;
@@ -77,6 +73,7 @@ void MOV_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void NEG_S()
 {
     if (check_cop1_unusable()) return;
@@ -86,6 +83,7 @@ void NEG_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void ROUND_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -98,6 +96,7 @@ void ROUND_L_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void TRUNC_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -110,6 +109,7 @@ void TRUNC_L_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void CEIL_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -122,6 +122,7 @@ void CEIL_L_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void FLOOR_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -134,6 +135,7 @@ void FLOOR_L_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void ROUND_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -146,6 +148,7 @@ void ROUND_W_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void TRUNC_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -158,6 +161,7 @@ void TRUNC_W_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void CEIL_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -170,6 +174,7 @@ void CEIL_W_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void FLOOR_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -182,14 +187,15 @@ void FLOOR_W_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void CVT_D_S()
 {
     if (check_cop1_unusable()) return;
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_simple[core_cffs];
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cffs]);
     PC++;
 }
 
+template <bool FloatExceptions>
 void CVT_W_S()
 {
     if (check_cop1_unusable()) return;
@@ -200,6 +206,7 @@ void CVT_W_S()
     PC++;
 }
 
+template <bool FloatExceptions>
 void CVT_L_S()
 {
     if (check_cop1_unusable()) return;
@@ -398,3 +405,41 @@ void C_NGT_S()
         FCR31 &= ~0x800000;
     PC++;
 }
+
+// Both specializations are referenced through FLOAT_OP
+template void ADD_S<false>();
+template void ADD_S<true>();
+template void SUB_S<false>();
+template void SUB_S<true>();
+template void MUL_S<false>();
+template void MUL_S<true>();
+template void DIV_S<false>();
+template void DIV_S<true>();
+template void SQRT_S<false>();
+template void SQRT_S<true>();
+template void ABS_S<false>();
+template void ABS_S<true>();
+template void NEG_S<false>();
+template void NEG_S<true>();
+template void ROUND_L_S<false>();
+template void ROUND_L_S<true>();
+template void TRUNC_L_S<false>();
+template void TRUNC_L_S<true>();
+template void CEIL_L_S<false>();
+template void CEIL_L_S<true>();
+template void FLOOR_L_S<false>();
+template void FLOOR_L_S<true>();
+template void ROUND_W_S<false>();
+template void ROUND_W_S<true>();
+template void TRUNC_W_S<false>();
+template void TRUNC_W_S<true>();
+template void CEIL_W_S<false>();
+template void CEIL_W_S<true>();
+template void FLOOR_W_S<false>();
+template void FLOOR_W_S<true>();
+template void CVT_D_S<false>();
+template void CVT_D_S<true>();
+template void CVT_W_S<false>();
+template void CVT_W_S<true>();
+template void CVT_L_S<false>();
+template void CVT_L_S<true>();
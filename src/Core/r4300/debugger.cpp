@@ -7,6 +7,7 @@
 #include "stdafx.h"
 #include <r4300/debugger.h>
 #include <Core.h>
+#include <r4300/r4300.h>
 
 bool g_resumed = true;
 bool g_instruction_advancing = false;
@@ -20,6 +21,12 @@ static uint32_t dummy_doRspCycles(uint32_t cycles)
     return cycles;
 }
 
+// The interpreter only needs to call into the debugger while it's paused or stepping
+static void update_interp_feature()
+{
+    interp_set_feature(INTERP_FEATURE_DEBUGGER, !g_resumed || g_instruction_advancing);
+}
+
 bool dbg_get_resumed()
 {
     return g_resumed;
@@ -32,6 +39,7 @@ void dbg_set_is_resumed(bool value)
         g_instruction_advancing = false;
     }
     g_resumed = value;
+    update_interp_feature();
     g_core->callbacks.debugger_resumed_changed(g_resumed);
 }
 
@@ -39,6 +47,7 @@ void dbg_step()
 {
     g_instruction_advancing = true;
     g_resumed = true;
+    update_interp_feature();
 }
 
 bool dbg_get_dma_read_enabled()
@@ -89,7 +89,13 @@
 #define set_ceil() fesetround(FE_UPWARD)
 #define set_floor() fesetround(FE_DOWNWARD)
 
-#define clear_x87_exceptions() feclearexcept(FE_ALL_EXCEPT)
+// Conversions only check the sticky invalid flag afterwards, so it only has to be cleared when an earlier operation
+// left it set, which spares the MXCSR write in the common case.
+#define clear_x87_exceptions()                                                                                         \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (_mm_getcsr() & _MM_EXCEPT_INVALID) _mm_setcsr(_mm_getcsr() & ~_MM_EXCEPT_INVALID);                         \
+    } while (0)
 
 #define read_x87_status_word() fegetexceptflag()
 
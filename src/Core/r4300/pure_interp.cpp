@@ -1203,36 +1203,34 @@ static void BC1TL()
 
 static void (*interp_cop1_bc[4])(void) = {BC1F, BC1T, BC1FL, BC1TL};
 
+template <bool FloatExceptions>
 static void ADD_S()
 {
     set_rounding();
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    CHECK_INPUT(*reg_cop1_simple[core_cfft]);
-    *reg_cop1_simple[core_cffd] = *reg_cop1_simple[core_cffs] + *reg_cop1_simple[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], *reg_cop1_simple[core_cffs] + *reg_cop1_simple[core_cfft],
+                         *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cfft]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void SUB_S()
 {
     set_rounding();
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    CHECK_INPUT(*reg_cop1_simple[core_cfft]);
-    *reg_cop1_simple[core_cffd] = *reg_cop1_simple[core_cffs] - *reg_cop1_simple[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], *reg_cop1_simple[core_cffs] - *reg_cop1_simple[core_cfft],
+                         *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cfft]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void MUL_S()
 {
     set_rounding();
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    CHECK_INPUT(*reg_cop1_simple[core_cfft]);
-    *reg_cop1_simple[core_cffd] = *reg_cop1_simple[core_cffs] * *reg_cop1_simple[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], *reg_cop1_simple[core_cffs] * *reg_cop1_simple[core_cfft],
+                         *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cfft]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void DIV_S()
 {
     if ((FCR31 & 0x400) && *reg_cop1_simple[core_cfft] == 0)
@@ -1240,22 +1238,20 @@ static void DIV_S()
         g_core->log_info(L"div_s by 0");
     }
     set_rounding();
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    CHECK_INPUT(*reg_cop1_simple[core_cfft]);
-    *reg_cop1_simple[core_cffd] = *reg_cop1_simple[core_cffs] / *reg_cop1_simple[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], *reg_cop1_simple[core_cffs] / *reg_cop1_simple[core_cfft],
+                         *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cfft]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void SQRT_S()
 {
     set_rounding();
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    *reg_cop1_simple[core_cffd] = sqrt(*reg_cop1_simple[core_cffs]);
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_simple[core_cffd], sqrt(*reg_cop1_simple[core_cffs]), *reg_cop1_simple[core_cffs]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void ABS_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1269,6 +1265,7 @@ static void MOV_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void NEG_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1276,6 +1273,7 @@ static void NEG_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void ROUND_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1287,6 +1285,7 @@ static void ROUND_L_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void TRUNC_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1298,6 +1297,7 @@ static void TRUNC_L_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CEIL_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1309,6 +1309,7 @@ static void CEIL_L_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void FLOOR_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1320,6 +1321,7 @@ static void FLOOR_L_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void ROUND_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1331,6 +1333,7 @@ static void ROUND_W_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void TRUNC_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1342,6 +1345,7 @@ static void TRUNC_W_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CEIL_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1353,6 +1357,7 @@ static void CEIL_W_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void FLOOR_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1364,13 +1369,14 @@ static void FLOOR_W_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CVT_D_S()
 {
-    CHECK_INPUT(*reg_cop1_simple[core_cffs]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_simple[core_cffs];
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_simple[core_cffs], *reg_cop1_simple[core_cffs]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CVT_W_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1381,6 +1387,7 @@ static void CVT_W_S()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CVT_L_S()
 {
     CHECK_INPUT(*reg_cop1_simple[core_cffs]);
@@ -1564,44 +1571,53 @@ static void C_NGT_S()
     interp_addr += 4;
 }
 
-static void (*interp_cop1_s[64])(void) = {
-    ADD_S,     SUB_S,     MUL_S,     DIV_S,    SQRT_S,    ABS_S,  MOV_S,   NEG_S,   ROUND_L_S, TRUNC_L_S, CEIL_L_S,
-    FLOOR_L_S, ROUND_W_S, TRUNC_W_S, CEIL_W_S, FLOOR_W_S, NI,     NI,      NI,      NI,        NI,        NI,
-    NI,        NI,        NI,        NI,       NI,        NI,     NI,      NI,      NI,        NI,        NI,
-    CVT_D_S,   NI,        NI,        CVT_W_S,  CVT_L_S,   NI,     NI,      NI,      NI,        NI,        NI,
-    NI,        NI,        NI,        NI,       C_F_S,     C_UN_S, C_EQ_S,  C_UEQ_S, C_OLT_S,   C_ULT_S,   C_OLE_S,
-    C_ULE_S,   C_SF_S,    C_NGLE_S,  C_SEQ_S,  C_NGL_S,   C_LT_S, C_NGE_S, C_LE_S,  C_NGT_S};
-
+template <bool FloatExceptions>
+static void (*interp_cop1_s_table[64])(void) = {
+    ADD_S<FloatExceptions>,     SUB_S<FloatExceptions>,     MUL_S<FloatExceptions>,    DIV_S<FloatExceptions>,
+    SQRT_S<FloatExceptions>,    ABS_S<FloatExceptions>,     MOV_S,                     NEG_S<FloatExceptions>,
+    ROUND_L_S<FloatExceptions>, TRUNC_L_S<FloatExceptions>, CEIL_L_S<FloatExceptions>, FLOOR_L_S<FloatExceptions>,
+    ROUND_W_S<FloatExceptions>, TRUNC_W_S<FloatExceptions>, CEIL_W_S<FloatExceptions>, FLOOR_W_S<FloatExceptions>,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         CVT_D_S<FloatExceptions>,   NI,                        NI,
+    CVT_W_S<FloatExceptions>,   CVT_L_S<FloatExceptions>,   NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    C_F_S,                      C_UN_S,                     C_EQ_S,                    C_UEQ_S,
+    C_OLT_S,                    C_ULT_S,                    C_OLE_S,                   C_ULE_S,
+    C_SF_S,                     C_NGLE_S,                   C_SEQ_S,                   C_NGL_S,
+    C_LT_S,                     C_NGE_S,                    C_LE_S,                    C_NGT_S};
+
+template <bool FloatExceptions>
 static void ADD_D()
 {
     set_rounding();
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    CHECK_INPUT(*reg_cop1_double[core_cfft]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_double[core_cffs] + *reg_cop1_double[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_double[core_cffs] + *reg_cop1_double[core_cfft],
+                         *reg_cop1_double[core_cffs], *reg_cop1_double[core_cfft]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void SUB_D()
 {
     set_rounding();
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    CHECK_INPUT(*reg_cop1_double[core_cfft]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_double[core_cffs] - *reg_cop1_double[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_double[core_cffs] - *reg_cop1_double[core_cfft],
+                         *reg_cop1_double[core_cffs], *reg_cop1_double[core_cfft]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void MUL_D()
 {
     set_rounding();
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    CHECK_INPUT(*reg_cop1_double[core_cfft]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_double[core_cffs] * *reg_cop1_double[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_double[core_cffs] * *reg_cop1_double[core_cfft],
+                         *reg_cop1_double[core_cffs], *reg_cop1_double[core_cfft]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void DIV_D()
 {
     if ((FCR31 & 0x400) && *reg_cop1_double[core_cfft] == 0)
@@ -1614,22 +1630,20 @@ static void DIV_D()
         // return;
     }
     set_rounding();
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    CHECK_INPUT(*reg_cop1_double[core_cfft]);
-    *reg_cop1_double[core_cffd] = *reg_cop1_double[core_cffs] / *reg_cop1_double[core_cfft];
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], *reg_cop1_double[core_cffs] / *reg_cop1_double[core_cfft],
+                         *reg_cop1_double[core_cffs], *reg_cop1_double[core_cfft]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void SQRT_D()
 {
     set_rounding();
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
-    *reg_cop1_double[core_cffd] = sqrt(*reg_cop1_double[core_cffs]);
-    CHECK_OUTPUT(*reg_cop1_double[core_cffd]);
+    CHECKED_FLOAT_RESULT(*reg_cop1_double[core_cffd], sqrt(*reg_cop1_double[core_cffs]), *reg_cop1_double[core_cffs]);
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void ABS_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1643,6 +1657,7 @@ static void MOV_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void NEG_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1650,6 +1665,7 @@ static void NEG_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void ROUND_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1661,6 +1677,7 @@ static void ROUND_L_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void TRUNC_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1672,6 +1689,7 @@ static void TRUNC_L_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CEIL_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1683,6 +1701,7 @@ static void CEIL_L_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void FLOOR_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1694,6 +1713,7 @@ static void FLOOR_L_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void ROUND_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1705,6 +1725,7 @@ static void ROUND_W_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void TRUNC_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1716,6 +1737,7 @@ static void TRUNC_W_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CEIL_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1727,6 +1749,7 @@ static void CEIL_W_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void FLOOR_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1738,9 +1761,9 @@ static void FLOOR_W_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CVT_S_D()
 {
-    CHECK_INPUT(*reg_cop1_double[core_cffs]);
     if (g_core->cfg->wii_vc_emulation)
     {
         set_trunc();
@@ -1749,12 +1772,17 @@ static void CVT_S_D()
     {
         set_rounding();
     }
-    *reg_cop1_simple[core_cffd] = *reg_cop1_double[core_cffs];
+    float result = (float)*reg_cop1_double[core_cffs];
     set_rounding();
-    CHECK_OUTPUT(*reg_cop1_simple[core_cffd]);
+    if (!check_float_result<FloatExceptions>(result, *reg_cop1_double[core_cffs]))
+    {
+        return;
+    }
+    *reg_cop1_simple[core_cffd] = result;
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CVT_W_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1765,6 +1793,7 @@ static void CVT_W_D()
     interp_addr += 4;
 }
 
+template <bool FloatExceptions>
 static void CVT_L_D()
 {
     CHECK_INPUT(*reg_cop1_double[core_cffs]);
@@ -1948,13 +1977,28 @@ static void C_NGT_D()
     interp_addr += 4;
 }
 
-static void (*interp_cop1_d[64])(void) = {
-    ADD_D,     SUB_D,     MUL_D,     DIV_D,    SQRT_D,    ABS_D,  MOV_D,   NEG_D,   ROUND_L_D, TRUNC_L_D, CEIL_L_D,
-    FLOOR_L_D, ROUND_W_D, TRUNC_W_D, CEIL_W_D, FLOOR_W_D, NI,     NI,      NI,      NI,        NI,        NI,
-    NI,        NI,        NI,        NI,       NI,        NI,     NI,      NI,      NI,        NI,        CVT_S_D,
-    NI,        NI,        NI,        CVT_W_D,  CVT_L_D,   NI,     NI,      NI,      NI,        NI,        NI,
-    NI,        NI,        NI,        NI,       C_F_D,     C_UN_D, C_EQ_D,  C_UEQ_D, C_OLT_D,   C_ULT_D,   C_OLE_D,
-    C_ULE_D,   C_SF_D,    C_NGLE_D,  C_SEQ_D,  C_NGL_D,   C_LT_D, C_NGE_D, C_LE_D,  C_NGT_D};
+template <bool FloatExceptions>
+static void (*interp_cop1_d_table[64])(void) = {
+    ADD_D<FloatExceptions>,     SUB_D<FloatExceptions>,     MUL_D<FloatExceptions>,    DIV_D<FloatExceptions>,
+    SQRT_D<FloatExceptions>,    ABS_D<FloatExceptions>,     MOV_D,                     NEG_D<FloatExceptions>,
+    ROUND_L_D<FloatExceptions>, TRUNC_L_D<FloatExceptions>, CEIL_L_D<FloatExceptions>, FLOOR_L_D<FloatExceptions>,
+    ROUND_W_D<FloatExceptions>, TRUNC_W_D<FloatExceptions>, CEIL_W_D<FloatExceptions>, FLOOR_W_D<FloatExceptions>,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    CVT_S_D<FloatExceptions>,   NI,                         NI,                        NI,
+    CVT_W_D<FloatExceptions>,   CVT_L_D<FloatExceptions>,   NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    NI,                         NI,                         NI,                        NI,
+    C_F_D,                      C_UN_D,                     C_EQ_D,                    C_UEQ_D,
+    C_OLT_D,                    C_ULT_D,                    C_OLE_D,                   C_ULE_D,
+    C_SF_D,                     C_NGLE_D,                   C_SEQ_D,                   C_NGL_D,
+    C_LT_D,                     C_NGE_D,                    C_LE_D,                    C_NGT_D};
+
+// The COP1 tables matching the float exception emulation setting, selected when the interpreter starts
+static void (**interp_cop1_s)(void) = interp_cop1_s_table<false>;
+static void (**interp_cop1_d)(void) = interp_cop1_d_table<false>;
 
 static void CVT_S_W()
 {
@@ -2151,7 +2195,8 @@ static void JAL()
     if (next_interrupt <= core_Count) gen_interrupt();
 }
 
-static void BEQ()
+template <bool IgnoreJump>
+static void beq()
 {
     int16_t local_immediate = core_iimmediate;
     local_rs = core_irs;
@@ -2166,11 +2211,16 @@ static void BEQ()
     interp_ops[((vr_op >> 26) & 0x3F)]();
     update_count();
     delay_slot = 0;
-    if (local_rs == local_rt && !g_vr_beq_ignore_jmp) interp_addr += (local_immediate - 1) * 4;
+    if (local_rs == local_rt && !IgnoreJump) interp_addr += (local_immediate - 1) * 4;
     last_addr = interp_addr;
     if (next_interrupt <= core_Count) gen_interrupt();
 }
 
+static void BEQ()
+{
+    beq<false>();
+}
+
 static void BNE()
 {
     int16_t local_immediate = core_iimmediate;
@@ -3000,7 +3050,8 @@ void (*interp_ops[64])(void) = {SPECIAL, REGIMM, J,   JAL,  BEQ,  BNE,  BLEZ, BG
                                 NI,      LDC1,   NI,  LD,   SC,   SWC1, NI,   NI,   NI,    SDC1,  NI,    SD};
 
 // Get opcode from address (interp_address)
-void prefetch()
+template <bool Tracelog>
+static void fetch()
 {
     // static FILE *f = NULL;
     // static int32_t line=1;
@@ -3055,39 +3106,86 @@ void prefetch()
             interp_addr = phys;
         else
         {
-            prefetch();
+            fetch<Tracelog>();
             // tlb_used = 0;
             return;
         }
         // tlb_used = 1;
-        prefetch();
+        fetch<Tracelog>();
         // tlb_used = 0;
         interp_addr = addr;
         return;
     }
-    if (g_ctx.tl_active()) tracelog_log_pure();
+    if constexpr (Tracelog) tracelog_log_pure();
 }
 
+void prefetch()
+{
+    if (g_interp_features.load(std::memory_order_relaxed) & INTERP_FEATURE_TRACELOG)
+        fetch<true>();
+    else
+        fetch<false>();
+}
+
+// Runs the interpreter until it's stopped or the set of enabled features changes
+template <uint32_t Features>
+static void pure_interpreter_loop()
+{
+    while (!stop && g_interp_features.load(std::memory_order_relaxed) == Features)
+    {
+        if constexpr ((Features & INTERP_FEATURE_DEBUGGER) != 0)
+        {
+            while (!dbg_get_resumed())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        fetch<(Features & INTERP_FEATURE_TRACELOG) != 0>();
+
+        if constexpr ((Features & INTERP_FEATURE_BEQ_IGNORE_JMP) != 0)
+        {
+            if (((vr_op >> 26) & 0x3F) == 4)
+                beq<true>();
+            else
+                interp_ops[((vr_op >> 26) & 0x3F)]();
+            interp_set_feature(INTERP_FEATURE_BEQ_IGNORE_JMP, false);
+        }
+        else
+        {
+            interp_ops[((vr_op >> 26) & 0x3F)]();
+        }
+
+        if constexpr ((Features & INTERP_FEATURE_DEBUGGER) != 0)
+        {
+            Debugger::on_late_cycle(vr_op, interp_addr);
+        }
+    }
+}
+
+static void select_cop1_tables()
+{
+    interp_cop1_s = g_float_exception_emulation ? interp_cop1_s_table<true> : interp_cop1_s_table<false>;
+    interp_cop1_d = g_float_exception_emulation ? interp_cop1_d_table<true> : interp_cop1_d_table<false>;
+}
+
+// One specialization per combination of interp_feature flags
+static void (*const pure_interpreter_loops[8])() = {
+    pure_interpreter_loop<0>, pure_interpreter_loop<1>, pure_interpreter_loop<2>, pure_interpreter_loop<3>,
+    pure_interpreter_loop<4>, pure_interpreter_loop<5>, pure_interpreter_loop<6>, pure_interpreter_loop<7>,
+};
+
 void pure_interpreter()
 {
     interp_addr = 0xa4000040;
     stop = 0;
     PC = (precomp_instr *)malloc(sizeof(precomp_instr));
     last_addr = interp_addr;
-    core_executing = true;
-    g_core->callbacks.core_executing_changed(core_executing);
-    g_core->log_info(std::format(L"core_executing: {}", (bool)core_executing));
+    select_cop1_tables();
+    vr_set_core_executing(true);
     while (!stop)
     {
-        prefetch();
-        interp_ops[((vr_op >> 26) & 0x3F)]();
-        g_vr_beq_ignore_jmp = false;
-
-        while (!g_ctx.dbg_get_resumed())
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
-        Debugger::on_late_cycle(vr_op, interp_addr);
+        pure_interpreter_loops[g_interp_features.load(std::memory_order_relaxed) & 7]();
     }
     PC->addr = interp_addr;
 }
@@ -3097,6 +3195,7 @@ void interprete_section(uint32_t addr)
     interp_addr = addr;
     PC = (precomp_instr *)malloc(sizeof(precomp_instr));
     last_addr = interp_addr;
+    select_cop1_tables();
     while (!stop && (addr >> 12) == (interp_addr >> 12))
     {
         prefetch();
@@ -9,6 +9,7 @@
 #include <memory/memory.h>
 #include <memory/pif.h>
 #include <memory/savestates.h>
+#include <r4300/cop1_helpers.h>
 #include <r4300/exception.h>
 #include <r4300/interrupt.h>
 #include <r4300/macros.h>
@@ -28,12 +29,23 @@ std::thread audio_thread_handle;
 
 std::atomic<bool> audio_thread_stop_requested;
 
+// Guards the core executing state and the soft reset handshake between the resetting thread and the emu thread
+std::mutex g_core_executing_mtx;
+std::condition_variable g_core_executing_cv;
+std::atomic<bool> g_soft_reset_pending = false;
+bool g_soft_reset_clear_save_data = false;
+
+// Held by the audio thread while it calls into the audio plugin, and by the emu thread while it notifies the plugins
+// of a soft reset
+std::mutex g_audio_plugin_mtx;
+
 // Lock to prevent emu state change race conditions
 std::recursive_mutex g_emu_cs;
 
 std::filesystem::path rom_path;
 
-bool g_vr_beq_ignore_jmp;
+std::atomic<uint32_t> g_interp_features;
+bool g_float_exception_emulation;
 volatile bool emu_launched = false;
 volatile bool emu_paused = false;
 volatile bool core_executing = false;
@@ -60,6 +72,7 @@ uint64_t debug_count = 0;
 uint32_t next_interrupt, CIC_Chip;
 precomp_instr *PC;
 char invalid_code[0x100000];
+uint32_t code_lines[0x200000];
 std::atomic<bool> screen_invalidated = true;
 precomp_block *blocks[0x100000], *actual;
 int32_t rounding_mode = MUP_ROUND_NEAREST;
@@ -84,8 +97,7 @@ FILE *g_mpak_file;
        invalid_code[address>>12] = 1;*/
 
 #define check_memory()                                                                                                 \
-    if (!invalid_code[address >> 12])                                                                                  \
-        if (blocks[address >> 12]->block[(address & 0xFFF) / 4].ops != NOTCOMPILED) invalid_code[address >> 12] = 1;
+    if (!invalid_code[address >> 12] && is_code_line(address)) invalid_code[address >> 12] = 1;
 
 void vr_invalidate_visuals()
 {
@@ -120,6 +132,17 @@ std::filesystem::path get_mempak_path()
                        g_ctx.vr_country_code_to_country_name(ROM_HEADER.Country_code));
 }
 
+void vr_set_core_executing(bool value)
+{
+    {
+        std::scoped_lock lock(g_core_executing_mtx);
+        core_executing = value;
+    }
+    g_core_executing_cv.notify_all();
+    g_core->callbacks.core_executing_changed(core_executing);
+    g_core->log_info(std::format(L"core_executing: {}", (bool)core_executing));
+}
+
 void vr_resume_emu_impl(bool force)
 {
     if (!force && !vcr_allows_core_unpause())
@@ -346,7 +369,8 @@ void JAL_IDLE()
         JAL();
 }
 
-void BEQ()
+template <bool IgnoreJump>
+static void beq()
 {
     local_rs = core_irs;
     local_rt = core_irt;
@@ -355,11 +379,16 @@ void BEQ()
     PC->ops();
     update_count();
     delay_slot = 0;
-    if (local_rs == local_rt && !skip_jump && !g_vr_beq_ignore_jmp) PC += (PC - 2)->f.i.immediate - 1;
+    if (local_rs == local_rt && !skip_jump && !IgnoreJump) PC += (PC - 2)->f.i.immediate - 1;
     last_addr = PC->addr;
     if (next_interrupt <= core_Count) gen_interrupt();
 }
 
+void BEQ()
+{
+    beq<false>();
+}
+
 void BEQ_OUT()
 {
     local_rs = core_irs;
@@ -391,6 +420,12 @@ void BEQ_IDLE()
         BEQ();
 }
 
+void BEQ_IDLE_LOOP()
+{
+    if (!skip_idle_loop(core_irs == core_irt))
+        BEQ();
+}
+
 void BNE()
 {
     local_rs = core_irs;
@@ -436,6 +471,12 @@ void BNE_IDLE()
         BNE();
 }
 
+void BNE_IDLE_LOOP()
+{
+    if (!skip_idle_loop(core_irs != core_irt))
+        BNE();
+}
+
 void BLEZ()
 {
     local_rs = core_irs;
@@ -479,6 +520,12 @@ void BLEZ_IDLE()
         BLEZ();
 }
 
+void BLEZ_IDLE_LOOP()
+{
+    if (!skip_idle_loop(core_irs <= 0))
+        BLEZ();
+}
+
 void BGTZ()
 {
     local_rs = core_irs;
@@ -522,6 +569,12 @@ void BGTZ_IDLE()
         BGTZ();
 }
 
+void BGTZ_IDLE_LOOP()
+{
+    if (!skip_idle_loop(core_irs > 0))
+        BGTZ();
+}
+
 void ADDI()
 {
     irt32 = irs32 + core_iimmediate;
@@ -636,6 +689,12 @@ void BEQL_IDLE()
         BEQL();
 }
 
+void BEQL_IDLE_LOOP()
+{
+    if (!skip_idle_loop(core_irs == core_irt))
+        BEQL();
+}
+
 void BNEL()
 {
     if (core_irs != core_irt)
@@ -693,6 +752,12 @@ void BNEL_IDLE()
         BNEL();
 }
 
+void BNEL_IDLE_LOOP()
+{
+    if (!skip_idle_loop(core_irs != core_irt))
+        BNEL();
+}
+
 void BLEZL()
 {
     if (core_irs <= 0)
@@ -1451,7 +1516,10 @@ void SD()
     check_memory();
 }
 
-void NOTCOMPILED()
+/**
+ * \brief Recompiles the current instruction's block, starting at the current instruction.
+ */
+static void recompile_from_pc()
 {
     if ((PC->addr >> 16) == 0xa400)
         recompile_block((int32_t *)SP_DMEM, blocks[0xa4000000 >> 12], PC->addr);
@@ -1480,13 +1548,32 @@ void NOTCOMPILED()
         else
             g_core->log_info(L"not compiled exception");
     }
+}
+
+void NOTCOMPILED()
+{
+    recompile_from_pc();
+    const precomp_instr *next = PC + 1;
     PC->ops();
-    if (dynacore) dyna_jump();
+    if (dynacore)
+    {
+        // Falling through from the interpreted instruction can't break what the next one relies on, so it gets a fresh
+        // entry point without being remembered as an entry.
+        if (PC == next && get_dyna_instr(actual, PC)->const_dependent) recompile_from_pc();
+        dyna_jump();
+    }
     //*return_address = (uint32_t)(blocks[PC->addr>>12]->code + PC->local_addr);
     // else
     // PC->ops();
 }
 
+void RECOMPILE_ENTRY()
+{
+    get_dyna_instr(actual, PC)->const_entry = true;
+    recompile_from_pc();
+    dyna_jump();
+}
+
 void NOTCOMPILED2()
 {
     NOTCOMPILED();
@@ -1532,6 +1619,7 @@ inline void jump_to_func()
     // #endif
     uint32_t paddr;
     if (skip_jump) return;
+    if (invalid_code[addr >> 12]) revalidate_block(addr >> 12);
     paddr = update_invalid_addr(addr);
     if (!paddr) return;
     actual = blocks[addr >> 12];
@@ -1543,6 +1631,7 @@ inline void jump_to_func()
             actual = blocks[addr >> 12];
             blocks[addr >> 12]->code = NULL;
             blocks[addr >> 12]->block = NULL;
+            blocks[addr >> 12]->dyna = NULL;
             blocks[addr >> 12]->jumps_table = NULL;
         }
         blocks[addr >> 12]->start = addr & ~0xFFF;
@@ -1567,27 +1656,114 @@ int32_t check_cop1_unusable()
     return 0;
 }
 
-void update_count()
+void log_count_regression()
+{
+    g_core->log_info(L"PC->addr < last_addr");
+}
+
+/**
+ * \brief Gets whether a load at the specified address reads state which only changes when the CPU writes to it or an
+ * interrupt is serviced.
+ */
+static bool is_polled_address(const uint32_t address)
 {
-    if (interpcore)
+    // TLB-mapped loads could fault, so only the unmapped segments qualify.
+    if (address < 0x80000000 || address >= 0xC0000000)
     {
-        core_Count = core_Count + (interp_addr - last_addr) / 2;
-        last_addr = interp_addr;
+        return false;
     }
+
+    const uint32_t physical = address & 0x1FFFFFFF;
+    if (physical < sizeof(rdram))
+    {
+        return true;
+    }
+
+    // VI_CURRENT and AI_LEN are derived from the count register and reading SP_SEMAPHORE sets it, so they don't qualify.
+    switch (physical)
+    {
+    case 0x04040010: // SP_STATUS
+    case 0x0410000C: // DPC_STATUS
+    case 0x04300008: // MI_INTR
+    case 0x04600010: // PI_STATUS
+    case 0x04800018: // SI_STATUS
+        return true;
+    default:
+        return false;
+    }
+}
+
+void interp_set_feature(const interp_feature feature, const bool enabled)
+{
+    if (enabled)
+        g_interp_features.fetch_or(feature);
     else
+        g_interp_features.fetch_and(~feature);
+}
+
+bool skip_idle_loop(const bool taken)
+{
+    if (!taken)
     {
-        if (PC->addr < last_addr)
+        return false;
+    }
+
+    // The recompiler has proven that the loop's iterations are identical while the memory they poll is unchanged, but
+    // the polled addresses depend on the registers and must be checked here. Instructions which were invalidated or
+    // wrapped since then aren't recognized and fail the check.
+    for (const precomp_instr *instr = PC + PC->f.i.immediate + 1; instr <= PC + 1; ++instr)
+    {
+        if (instr == PC)
+        {
+            continue;
+        }
+
+        const auto ops = instr->ops;
+        uint32_t alignment;
+        if (ops == LB || ops == LBU)
         {
-            g_core->log_info(L"PC->addr < last_addr");
+            alignment = 0;
         }
-        core_Count = core_Count + (PC->addr - last_addr) / 2;
-        last_addr = PC->addr;
+        else if (ops == LH || ops == LHU)
+        {
+            alignment = 1;
+        }
+        else if (ops == LW || ops == LWU)
+        {
+            alignment = 3;
+        }
+        else if (ops == NOP || ops == SLL || ops == SRL || ops == SRA || ops == ADDU || ops == SUBU || ops == AND ||
+                 ops == OR || ops == XOR || ops == NOR || ops == SLT || ops == SLTU || ops == ADDIU || ops == SLTI ||
+                 ops == SLTIU || ops == ANDI || ops == ORI || ops == XORI || ops == LUI)
+        {
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+
+        const uint32_t address = (uint32_t)(*(int32_t *)instr->f.i.rs + instr->f.i.immediate);
+        if ((address & alignment) || !is_polled_address(address))
+        {
+            return false;
+        }
+    }
+
+    update_count();
+    const int32_t skip = next_interrupt - core_Count;
+    if (skip <= 3)
+    {
+        return false;
     }
+    core_Count += (skip & 0xFFFFFFFC);
+    return true;
 }
 
 void init_blocks()
 {
     int32_t i;
+    memset(code_lines, 0, sizeof(code_lines));
     for (i = 0; i < 0x100000; i++)
     {
         invalid_code[i] = 1;
@@ -1597,6 +1773,7 @@ void init_blocks()
     invalid_code[0xa4000000 >> 12] = 1;
     blocks[0xa4000000 >> 12]->code = NULL;
     blocks[0xa4000000 >> 12]->block = NULL;
+    blocks[0xa4000000 >> 12]->dyna = NULL;
     blocks[0xa4000000 >> 12]->jumps_table = NULL;
     blocks[0xa4000000 >> 12]->start = 0xa4000000;
     blocks[0xa4000000 >> 12]->end = 0xa4001000;
@@ -1628,6 +1805,9 @@ void core_start()
     memcpy((char *)SP_DMEM + 0x40, rom + 0x40, 0xFBC);
     delay_slot = 0;
     stop = 0;
+    g_float_exception_emulation = g_core->cfg->float_exception_emulation;
+    const uint32_t host_csr = g_float_exception_emulation ? begin_float_exception_emulation() : _mm_getcsr();
+    interp_set_feature(INTERP_FEATURE_BEQ_IGNORE_JMP, false);
     for (i = 0; i < 32; i++)
     {
         reg[i] = 0;
@@ -1663,6 +1843,7 @@ void core_start()
     }
     memset(tlb_LUT_r, 0, sizeof(tlb_LUT_r));
     memset(tlb_LUT_r, 0, sizeof(tlb_LUT_w));
+    tlb_init_quirks();
     llbit = 0;
     hi = 0;
     lo = 0;
@@ -1856,13 +2037,19 @@ void core_start()
         g_core->log_info(L"interpreter");
         init_blocks();
         last_addr = PC->addr;
-        core_executing = true;
-        g_core->callbacks.core_executing_changed(core_executing);
-        g_core->log_info(std::format(L"core_executing: {}", (bool)core_executing));
+        vr_set_core_executing(true);
         while (!stop)
         {
+            if (g_interp_features.load(std::memory_order_relaxed) & INTERP_FEATURE_BEQ_IGNORE_JMP)
+            {
+                if (PC->ops == BEQ)
+                    beq<true>();
+                else
+                    PC->ops();
+                interp_set_feature(INTERP_FEATURE_BEQ_IGNORE_JMP, false);
+                continue;
+            }
             PC->ops();
-            g_vr_beq_ignore_jmp = false;
         }
     }
     else if (dynacore == 2)
@@ -1877,7 +2064,7 @@ void core_start()
         g_core->log_info(L"dynamic recompiler");
         init_blocks();
 
-        auto code_addr = actual->code + (actual->block[0x40 / 4].local_addr);
+        auto code_addr = actual->code + (actual->dyna[0x40 / 4].local_addr);
 
         code = (void (*)(void))(code_addr);
         dyna_start(code);
@@ -1894,6 +2081,11 @@ void core_start()
                 free(blocks[i]->block);
                 blocks[i]->block = NULL;
             }
+            if (blocks[i]->dyna)
+            {
+                free(blocks[i]->dyna);
+                blocks[i]->dyna = NULL;
+            }
             if (blocks[i]->code)
             {
                 free_exec(blocks[i]->code);
@@ -1908,9 +2100,10 @@ void core_start()
             blocks[i] = NULL;
         }
     }
+    clear_block_links();
     if (!dynacore && interpcore) free(PC);
-    core_executing = false;
-    g_core->callbacks.core_executing_changed(core_executing);
+    _mm_setcsr(host_csr);
+    vr_set_core_executing(false);
 }
 
 bool open_core_file_stream(const std::filesystem::path &path, FILE **file)
@@ -1931,13 +2124,11 @@ bool open_core_file_stream(const std::filesystem::path &path, FILE **file)
     return *file != nullptr;
 }
 
-void clear_save_data()
+/**
+ * \brief Clears the save data held by the currently open save file streams.
+ */
+void clear_open_save_data()
 {
-    open_core_file_stream(get_eeprom_path(), &g_eeprom_file);
-    open_core_file_stream(get_sram_path(), &g_sram_file);
-    open_core_file_stream(get_flashram_path(), &g_fram_file);
-    open_core_file_stream(get_mempak_path(), &g_mpak_file);
-
     {
         memset(sram, 0, sizeof(sram));
         fseek(g_sram_file, 0, SEEK_SET);
@@ -1957,6 +2148,20 @@ void clear_save_data()
         }
     }
 
+    fflush(g_eeprom_file);
+    fflush(g_sram_file);
+    fflush(g_mpak_file);
+}
+
+void clear_save_data()
+{
+    open_core_file_stream(get_eeprom_path(), &g_eeprom_file);
+    open_core_file_stream(get_sram_path(), &g_sram_file);
+    open_core_file_stream(get_flashram_path(), &g_fram_file);
+    open_core_file_stream(get_mempak_path(), &g_mpak_file);
+
+    clear_open_save_data();
+
     fclose(g_eeprom_file);
     fclose(g_sram_file);
     fclose(g_fram_file);
@@ -1985,11 +2190,65 @@ void audio_thread()
             continue;
         }
 
+        // The plugins are being notified of a soft reset, so we mustn't call into them
+        std::scoped_lock lock(g_audio_plugin_mtx);
+        if (!core_executing)
+        {
+            continue;
+        }
+
         g_core->audio_ai_update(0);
     }
     g_core->log_info(L"Sound thread exiting...");
 }
 
+/**
+ * \brief Reinitializes the machine state in-place after the CPU loop was stopped for a soft reset.
+ * \remark Must be called on the emu thread.
+ */
+void soft_reset()
+{
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    g_core->log_info(L"[Core] Soft resetting...");
+
+    st_on_core_stop();
+
+    g_core->callbacks.emu_starting_changed(true);
+
+    bool clear_save_data;
+    {
+        std::scoped_lock lock(g_core_executing_mtx);
+        clear_save_data = g_soft_reset_clear_save_data;
+        g_soft_reset_pending = false;
+    }
+
+    {
+        std::scoped_lock lock(g_audio_plugin_mtx);
+
+        g_core->plugins_rom_closed();
+
+        if (clear_save_data)
+        {
+            clear_open_save_data();
+        }
+
+        init_memory();
+
+        g_core->plugins_rom_open();
+    }
+
+    dynacore = g_core->cfg->core_type;
+
+    g_core->callbacks.emu_launched_changed(true);
+    g_core->callbacks.emu_starting_changed(false);
+    g_core->callbacks.reset();
+
+    g_core->log_info(std::format(
+        L"[Core] Soft reset took {}ms",
+        static_cast<int32_t>((std::chrono::high_resolution_clock::now() - start_time).count() / 1'000'000)));
+}
+
 void emu_thread()
 {
     auto start_time = std::chrono::high_resolution_clock::now();
@@ -2013,12 +2272,22 @@ void emu_thread()
         static_cast<int32_t>((std::chrono::high_resolution_clock::now() - start_time).count() / 1'000'000)));
     core_start();
 
+    while (g_soft_reset_pending)
+    {
+        soft_reset();
+        core_start();
+    }
+
     st_on_core_stop();
 
     g_core->callbacks.emu_stopped();
 
     emu_paused = true;
-    emu_launched = false;
+    {
+        std::scoped_lock lock(g_core_executing_mtx);
+        emu_launched = false;
+    }
+    g_core_executing_cv.notify_all();
 
     if (!emu_resetting)
     {
@@ -2144,7 +2413,8 @@ core_result vr_start_rom_impl(std::filesystem::path path)
     // We need to wait until the core is actually done and running before we can continue, because we release the lock
     // If we return too early (before core is ready to also be killed), then another start or close might come in during
     // the core initialization (catastrophe)
-    while (!core_executing);
+    std::unique_lock lock(g_core_executing_mtx);
+    g_core_executing_cv.wait(lock, [] { return core_executing || !emu_launched; });
 
     return Res_Ok;
 }
@@ -2161,6 +2431,38 @@ core_result vr_close_rom(bool stop_vcr)
     return vr_close_rom_impl(stop_vcr);
 }
 
+/**
+ * \brief Resets the ROM in-place, keeping the emu thread, plugins, save files and ROM buffer alive.
+ */
+core_result vr_soft_reset_rom_impl(bool reset_save_data, bool stop_vcr)
+{
+    vr_resume_emu_impl(true);
+
+    if (stop_vcr)
+    {
+        g_ctx.vcr_stop_all();
+    }
+
+    g_core->callbacks.emu_stopping();
+
+    {
+        std::scoped_lock lock(g_core_executing_mtx);
+        g_soft_reset_clear_save_data = reset_save_data;
+        g_soft_reset_pending = true;
+    }
+
+    // Make the CPU loop bail out, the emu thread will pick up the reset request afterwards
+    stop = 1;
+
+    {
+        std::unique_lock lock(g_core_executing_mtx);
+        g_core_executing_cv.wait(lock, [] { return (!g_soft_reset_pending && core_executing) || !emu_launched; });
+    }
+
+    g_core->callbacks.reset_completed();
+    return emu_launched ? Res_Ok : VR_NotRunning;
+}
+
 core_result vr_reset_rom_impl(bool reset_save_data, bool stop_vcr, bool skip_reset_recording_check)
 {
     if (!emu_launched) return VR_NotRunning;
@@ -2175,13 +2477,18 @@ core_result vr_reset_rom_impl(bool reset_save_data, bool stop_vcr, bool skip_res
         return Res_Ok;
     }
 
-    // why is it so damned difficult to reset the game?
-    // right now it's hacked to exit to the GUI then re-load the ROM,
-    // but it should be possible to reset the game while it's still running
-    // simply by clearing out some memory and maybe notifying the plugins...
     frame_advance_outstanding = 0;
+
     emu_resetting = true;
 
+    // The summercart can write to the ROM, so we need to reload it from scratch in that case.
+    if (!g_core->cfg->use_summercart)
+    {
+        const auto result = vr_soft_reset_rom_impl(reset_save_data, stop_vcr);
+        emu_resetting = false;
+        return result;
+    }
+
     core_result result = g_ctx.vr_close_rom(stop_vcr);
     if (result != Res_Ok)
     {
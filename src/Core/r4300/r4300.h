@@ -10,6 +10,7 @@
 #define VR_PROFILE (1)
 #endif
 
+#include <r4300/macros.h>
 #include <r4300/recomp.h>
 #include <memory/tlb.h>
 #include <r4300/rom.h>
@@ -24,7 +25,26 @@ extern uint32_t vr_op;
 extern precomp_block *blocks[0x100000], *actual;
 extern void (*interp_ops[64])(void);
 extern int32_t fast_memory;
-extern bool g_vr_beq_ignore_jmp;
+
+/**
+ * \brief Interpreter features which cost time on every instruction. The interpreter loops are specialized for each
+ * combination, so disabled features cost nothing, and switch to the matching specialization when the set changes.
+ */
+enum interp_feature : uint32_t
+{
+    INTERP_FEATURE_TRACELOG = 1 << 0,
+    INTERP_FEATURE_DEBUGGER = 1 << 1,
+    // The next BEQ executed as the first instruction after loading a legacy savestate mustn't take its jump.
+    INTERP_FEATURE_BEQ_IGNORE_JMP = 1 << 2,
+};
+
+extern std::atomic<uint32_t> g_interp_features;
+
+/**
+ * \brief Whether float exceptions are emulated. Latched from the config when emulation starts, since the COP1 ops are
+ * specialized on it.
+ */
+extern bool g_float_exception_emulation;
 extern volatile bool emu_launched;
 extern volatile bool emu_paused;
 extern volatile bool core_executing;
@@ -67,10 +87,53 @@ extern bool g_vr_benchmark_enabled;
 
 void pure_interpreter();
 extern void jump_to_func();
-void update_count();
+
+/**
+ * \brief Logs that execution went back before the point Count was last advanced to.
+ */
+void log_count_regression();
+
+/**
+ * \brief Advances Count by the instructions executed since it was last advanced. Called once per control transfer, so
+ * a run of straight-line code is accounted for at its exit from the distance to its entry, and the interrupt checks
+ * following the calls happen at the same points. Count reads in between see the value from the run's entry.
+ */
+inline void update_count()
+{
+    if (interpcore)
+    {
+        core_Count = core_Count + (interp_addr - last_addr) / 2;
+        last_addr = interp_addr;
+    }
+    else
+    {
+        if (PC->addr < last_addr) log_count_regression();
+        core_Count = core_Count + (PC->addr - last_addr) / 2;
+        last_addr = PC->addr;
+    }
+}
+
+/**
+ * \brief Skips to the next interrupt if the current branch closes a multi-instruction idle loop and is taken.
+ * \param taken Whether the branch is taken.
+ * \return Whether the skip happened. If not, the caller must execute the branch normally.
+ */
+bool skip_idle_loop(bool taken);
+
+/**
+ * \brief Enables or disables an interpreter feature. Takes effect before the interpreter's next instruction.
+ * \param feature The feature.
+ * \param enabled Whether the feature is enabled.
+ */
+void interp_set_feature(interp_feature feature, bool enabled);
 int32_t check_cop1_unusable();
 void critical_stop(const std::wstring &message = L"Unknown error");
 
+/**
+ * \brief Sets whether the core is executing and wakes up threads waiting for the change.
+ */
+void vr_set_core_executing(bool value);
+
 core_result vr_reset_rom_impl(bool reset_save_data, bool stop_vcr, bool skip_reset_recording_check = false);
 
 std::filesystem::path vr_get_rom_path();
@@ -7,6 +7,7 @@
 #include "stdafx.h"
 #include <Core.h>
 #include <memory/memory.h>
+#include <r4300/const_prop.h>
 #include <r4300/macros.h>
 #include <r4300/ops.h>
 #include <r4300/r4300.h>
@@ -33,6 +34,158 @@ static int32_t *SRC;      // currently recompiled instruction in the input strea
 static int32_t check_nop; // next instruction is nop ?
 static int32_t delay_slot_compiled = 0;
 
+// Maximum number of instructions before the branch in a loop considered for idle loop detection
+#define IDLE_LOOP_MAX_LENGTH 8
+
+// Maximum number of instructions looked through to find a result which is overwritten before being read
+#define DEAD_WRITE_WINDOW 8
+
+// The GPRs known to hold a constant before the instruction being recompiled by the dynarec
+static const_state known_gprs;
+
+// The instructions of the block being recompiled which are targets of branches or jumps in the block, one bit each
+static uint32_t branch_targets[0x1000 / 4 / 32];
+
+/**
+ * \brief Decodes the registers read and written by an instruction which may appear in an idle loop.
+ * \param op The instruction.
+ * \param reads Receives the registers read by the instruction as a bitmask.
+ * \param writes Receives the registers written by the instruction as a bitmask.
+ * \return Whether the instruction may appear in an idle loop, i.e. is a load or arithmetic without side effects.
+ */
+static bool get_idle_loop_operands(const uint32_t op, uint32_t &reads, uint32_t &writes)
+{
+    const uint32_t rs = 1 << ((op >> 21) & 0x1F);
+    const uint32_t rt = 1 << ((op >> 16) & 0x1F);
+    const uint32_t rd = 1 << ((op >> 11) & 0x1F);
+
+    switch (op >> 26)
+    {
+    case 0x00:
+        switch (op & 0x3F)
+        {
+        case 0x00: // SLL
+        case 0x02: // SRL
+        case 0x03: // SRA
+            reads = rt;
+            writes = rd;
+            break;
+        case 0x21: // ADDU
+        case 0x23: // SUBU
+        case 0x24: // AND
+        case 0x25: // OR
+        case 0x26: // XOR
+        case 0x27: // NOR
+        case 0x2A: // SLT
+        case 0x2B: // SLTU
+            reads = rs | rt;
+            writes = rd;
+            break;
+        default:
+            return false;
+        }
+        break;
+    case 0x09: // ADDIU
+    case 0x0A: // SLTI
+    case 0x0B: // SLTIU
+    case 0x0C: // ANDI
+    case 0x0D: // ORI
+    case 0x0E: // XORI
+    case 0x20: // LB
+    case 0x21: // LH
+    case 0x23: // LW
+    case 0x24: // LBU
+    case 0x25: // LHU
+    case 0x27: // LWU
+        reads = rs;
+        writes = rt;
+        break;
+    case 0x0F: // LUI
+        reads = 0;
+        writes = rt;
+        break;
+    default:
+        return false;
+    }
+
+    reads &= ~1;
+    writes &= ~1;
+    return true;
+}
+
+/**
+ * \brief Determines whether the backward branch being recompiled closes an idle loop, i.e. a short loop of loads and
+ * arithmetic which computes the same result in every iteration until an interrupt changes the state it polls.
+ * The addresses it polls are only known at runtime and are checked by skip_idle_loop.
+ * \param target The branch target.
+ * \param branch_reads The registers read by the branch as a bitmask.
+ */
+static bool is_idle_loop(const uint32_t target, const uint32_t branch_reads)
+{
+    if (interpcore || target >= dst->addr || target < dst_block->start || dst->addr >= dst_block->end - 4)
+    {
+        return false;
+    }
+
+    const int32_t length = (dst->addr - target) / 4;
+    if (length > IDLE_LOOP_MAX_LENGTH)
+    {
+        return false;
+    }
+
+    // The loop in execution order: the body, the branch and its delay slot.
+    uint32_t reads[IDLE_LOOP_MAX_LENGTH + 2];
+    uint32_t writes[IDLE_LOOP_MAX_LENGTH + 2];
+    uint32_t bases[IDLE_LOOP_MAX_LENGTH + 2];
+    uint32_t written = 0;
+    for (int32_t i = 0; i <= length + 1; i++)
+    {
+        if (i == length)
+        {
+            reads[i] = branch_reads & ~1;
+            writes[i] = 0;
+            bases[i] = 0;
+        }
+        else if (!get_idle_loop_operands(SRC[i - length], reads[i], writes[i]))
+        {
+            return false;
+        }
+        else
+        {
+            // Loads are the only accepted instructions with an opcode of 0x20 or above.
+            const uint32_t op = SRC[i - length];
+            bases[i] = (op >> 26) >= 0x20 ? (1 << ((op >> 21) & 0x1F)) & ~1 : 0;
+        }
+        written |= writes[i];
+    }
+
+    // A register read before it's written in the same iteration carries state between iterations, e.g. a counter.
+    uint32_t defined = 0;
+    for (int32_t i = 0; i <= length + 1; i++)
+    {
+        if (reads[i] & written & ~defined)
+        {
+            return false;
+        }
+        defined |= writes[i];
+    }
+
+    // skip_idle_loop computes the polled addresses from the base registers' values at the branch, so a base register
+    // mustn't change between its load and the end of the iteration. Bases set up earlier in the iteration are fine, as
+    // the check above makes them hold the same value at the load and at the branch in every iteration.
+    uint32_t written_later = 0;
+    for (int32_t i = length + 1; i >= 0; i--)
+    {
+        written_later |= writes[i];
+        if (bases[i] & written_later)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static void RSV()
 {
     dst->ops = RESERVED;
@@ -573,6 +726,11 @@ static void RBLTZ()
         dst->ops = BLTZ_OUT;
         if (dynacore) genbltz_out();
     }
+    else if (is_idle_loop(target, 1 << ((src >> 21) & 0x1F)))
+    {
+        dst->ops = BLTZ_IDLE_LOOP;
+        if (dynacore) genidle_loop();
+    }
     else if (dynacore)
         genbltz();
 }
@@ -599,6 +757,11 @@ static void RBGEZ()
         dst->ops = BGEZ_OUT;
         if (dynacore) genbgez_out();
     }
+    else if (is_idle_loop(target, 1 << ((src >> 21) & 0x1F)))
+    {
+        dst->ops = BGEZ_IDLE_LOOP;
+        if (dynacore) genidle_loop();
+    }
     else if (dynacore)
         genbgez();
 }
@@ -988,42 +1151,42 @@ static void (*recomp_bc[4])(void) = {RBC1F, RBC1T, RBC1FL, RBC1TL};
 
 static void RADD_S()
 {
-    dst->ops = ADD_S;
+    dst->ops = FLOAT_OP(ADD_S);
     recompile_standard_cf_type();
     if (dynacore) genadd_s();
 }
 
 static void RSUB_S()
 {
-    dst->ops = SUB_S;
+    dst->ops = FLOAT_OP(SUB_S);
     recompile_standard_cf_type();
     if (dynacore) gensub_s();
 }
 
 static void RMUL_S()
 {
-    dst->ops = MUL_S;
+    dst->ops = FLOAT_OP(MUL_S);
     recompile_standard_cf_type();
     if (dynacore) genmul_s();
 }
 
 static void RDIV_S()
 {
-    dst->ops = DIV_S;
+    dst->ops = FLOAT_OP(DIV_S);
     recompile_standard_cf_type();
     if (dynacore) gendiv_s();
 }
 
 static void RSQRT_S()
 {
-    dst->ops = SQRT_S;
+    dst->ops = FLOAT_OP(SQRT_S);
     recompile_standard_cf_type();
     if (dynacore) gensqrt_s();
 }
 
 static void RABS_S()
 {
-    dst->ops = ABS_S;
+    dst->ops = FLOAT_OP(ABS_S);
     recompile_standard_cf_type();
     if (dynacore) genabs_s();
 }
@@ -1037,84 +1200,84 @@ static void RMOV_S()
 
 static void RNEG_S()
 {
-    dst->ops = NEG_S;
+    dst->ops = FLOAT_OP(NEG_S);
     recompile_standard_cf_type();
     if (dynacore) genneg_s();
 }
 
 static void RROUND_L_S()
 {
-    dst->ops = ROUND_L_S;
+    dst->ops = FLOAT_OP(ROUND_L_S);
     recompile_standard_cf_type();
     if (dynacore) genround_l_s();
 }
 
 static void RTRUNC_L_S()
 {
-    dst->ops = TRUNC_L_S;
+    dst->ops = FLOAT_OP(TRUNC_L_S);
     recompile_standard_cf_type();
     if (dynacore) gentrunc_l_s();
 }
 
 static void RCEIL_L_S()
 {
-    dst->ops = CEIL_L_S;
+    dst->ops = FLOAT_OP(CEIL_L_S);
     recompile_standard_cf_type();
     if (dynacore) genceil_l_s();
 }
 
 static void RFLOOR_L_S()
 {
-    dst->ops = FLOOR_L_S;
+    dst->ops = FLOAT_OP(FLOOR_L_S);
     recompile_standard_cf_type();
     if (dynacore) genfloor_l_s();
 }
 
 static void RROUND_W_S()
 {
-    dst->ops = ROUND_W_S;
+    dst->ops = FLOAT_OP(ROUND_W_S);
     recompile_standard_cf_type();
     if (dynacore) genround_w_s();
 }
 
 static void RTRUNC_W_S()
 {
-    dst->ops = TRUNC_W_S;
+    dst->ops = FLOAT_OP(TRUNC_W_S);
     recompile_standard_cf_type();
     if (dynacore) gentrunc_w_s();
 }
 
 static void RCEIL_W_S()
 {
-    dst->ops = CEIL_W_S;
+    dst->ops = FLOAT_OP(CEIL_W_S);
     recompile_standard_cf_type();
     if (dynacore) genceil_w_s();
 }
 
 static void RFLOOR_W_S()
 {
-    dst->ops = FLOOR_W_S;
+    dst->ops = FLOAT_OP(FLOOR_W_S);
     recompile_standard_cf_type();
     if (dynacore) genfloor_w_s();
 }
 
 static void RCVT_D_S()
 {
-    dst->ops = CVT_D_S;
+    dst->ops = FLOAT_OP(CVT_D_S);
     recompile_standard_cf_type();
     if (dynacore) gencvt_d_s();
 }
 
 static void RCVT_W_S()
 {
-    dst->ops = CVT_W_S;
+    dst->ops = FLOAT_OP(CVT_W_S);
     recompile_standard_cf_type();
     if (dynacore) gencvt_w_s();
 }
 
 static void RCVT_L_S()
 {
-    dst->ops = CVT_L_S;
+    dst->ops = FLOAT_OP(CVT_L_S);
     recompile_standard_cf_type();
     if (dynacore) gencvt_l_s();
 }
@@ -1246,42 +1409,42 @@ static void (*recomp_s[64])(void) = {
 
 static void RADD_D()
 {
-    dst->ops = ADD_D;
+    dst->ops = FLOAT_OP(ADD_D);
     recompile_standard_cf_type();
     if (dynacore) genadd_d();
 }
 
 static void RSUB_D()
 {
-    dst->ops = SUB_D;
+    dst->ops = FLOAT_OP(SUB_D);
     recompile_standard_cf_type();
     if (dynacore) gensub_d();
 }
 
 static void RMUL_D()
 {
-    dst->ops = MUL_D;
+    dst->ops = FLOAT_OP(MUL_D);
     recompile_standard_cf_type();
     if (dynacore) genmul_d();
 }
 
 static void RDIV_D()
 {
-    dst->ops = DIV_D;
+    dst->ops = FLOAT_OP(DIV_D);
     recompile_standard_cf_type();
     if (dynacore) gendiv_d();
 }
 
 static void RSQRT_D()
 {
-    dst->ops = SQRT_D;
+    dst->ops = FLOAT_OP(SQRT_D);
     recompile_standard_cf_type();
     if (dynacore) gensqrt_d();
 }
 
 static void RABS_D()
 {
-    dst->ops = ABS_D;
+    dst->ops = FLOAT_OP(ABS_D);
     recompile_standard_cf_type();
     if (dynacore) genabs_d();
 }
@@ -1295,84 +1458,84 @@ static void RMOV_D()
 
 static void RNEG_D()
 {
-    dst->ops = NEG_D;
+    dst->ops = FLOAT_OP(NEG_D);
     recompile_standard_cf_type();
     if (dynacore) genneg_d();
 }
 
 static void RROUND_L_D()
 {
-    dst->ops = ROUND_L_D;
+    dst->ops = FLOAT_OP(ROUND_L_D);
     recompile_standard_cf_type();
     if (dynacore) genround_l_d();
 }
 
 static void RTRUNC_L_D()
 {
-    dst->ops = TRUNC_L_D;
+    dst->ops = FLOAT_OP(TRUNC_L_D);
     recompile_standard_cf_type();
     if (dynacore) gentrunc_l_d();
 }
 
 static void RCEIL_L_D()
 {
-    dst->ops = CEIL_L_D;
+    dst->ops = FLOAT_OP(CEIL_L_D);
     recompile_standard_cf_type();
     if (dynacore) genceil_l_d();
 }
 
 static void RFLOOR_L_D()
 {
-    dst->ops = FLOOR_L_D;
+    dst->ops = FLOAT_OP(FLOOR_L_D);
     recompile_standard_cf_type();
     if (dynacore) genfloor_l_d();
 }
 
 static void RROUND_W_D()
 {
-    dst->ops = ROUND_W_D;
+    dst->ops = FLOAT_OP(ROUND_W_D);
     recompile_standard_cf_type();
     if (dynacore) genround_w_d();
 }
 
 static void RTRUNC_W_D()
 {
-    dst->ops = TRUNC_W_D;
+    dst->ops = FLOAT_OP(TRUNC_W_D);
     recompile_standard_cf_type();
     if (dynacore) gentrunc_w_d();
 }
 
 static void RCEIL_W_D()
 {
-    dst->ops = CEIL_W_D;
+    dst->ops = FLOAT_OP(CEIL_W_D);
     recompile_standard_cf_type();
     if (dynacore) genceil_w_d();
 }
 
 static void RFLOOR_W_D()
 {
-    dst->ops = FLOOR_W_D;
+    dst->ops = FLOAT_OP(FLOOR_W_D);
     recompile_standard_cf_type();
     if (dynacore) genfloor_w_d();
 }
 
 static void RCVT_S_D()
 {
-    dst->ops = CVT_S_D;
+    dst->ops = FLOAT_OP(CVT_S_D);
     recompile_standard_cf_type();
     if (dynacore) gencvt_s_d();
 }
 
 static void RCVT_W_D()
 {
-    dst->ops = CVT_W_D;
+    dst->ops = FLOAT_OP(CVT_W_D);
     recompile_standard_cf_type();
     if (dynacore) gencvt_w_d();
 }
 
 static void RCVT_L_D()
 {
-    dst->ops = CVT_L_D;
+    dst->ops = FLOAT_OP(CVT_L_D);
     recompile_standard_cf_type();
     if (dynacore) gencvt_l_d();
 }
@@ -1725,6 +1888,11 @@ static void RBEQ()
         dst->ops = BEQ_OUT;
         if (dynacore) genbeq_out();
     }
+    else if (is_idle_loop(target, (1 << ((src >> 21) & 0x1F)) | (1 << ((src >> 16) & 0x1F))))
+    {
+        dst->ops = BEQ_IDLE_LOOP;
+        if (dynacore) genidle_loop();
+    }
     else if (dynacore)
         genbeq();
 }
@@ -1751,6 +1919,11 @@ static void RBNE()
         dst->ops = BNE_OUT;
         if (dynacore) genbne_out();
     }
+    else if (is_idle_loop(target, (1 << ((src >> 21) & 0x1F)) | (1 << ((src >> 16) & 0x1F))))
+    {
+        dst->ops = BNE_IDLE_LOOP;
+        if (dynacore) genidle_loop();
+    }
     else if (dynacore)
         genbne();
 }
@@ -1777,6 +1950,11 @@ static void RBLEZ()
         dst->ops = BLEZ_OUT;
         if (dynacore) genblez_out();
     }
+    else if (is_idle_loop(target, 1 << ((src >> 21) & 0x1F)))
+    {
+        dst->ops = BLEZ_IDLE_LOOP;
+        if (dynacore) genidle_loop();
+    }
     else if (dynacore)
         genblez();
 }
@@ -1803,6 +1981,11 @@ static void RBGTZ()
         dst->ops = BGTZ_OUT;
         if (dynacore) genbgtz_out();
     }
+    else if (is_idle_loop(target, 1 << ((src >> 21) & 0x1F)))
+    {
+        dst->ops = BGTZ_IDLE_LOOP;
+        if (dynacore) genidle_loop();
+    }
     else if (dynacore)
         genbgtz();
 }
@@ -1919,6 +2102,11 @@ static void RBEQL()
         dst->ops = BEQL_OUT;
         if (dynacore) genbeql_out();
     }
+    else if (is_idle_loop(target, (1 << ((src >> 21) & 0x1F)) | (1 << ((src >> 16) & 0x1F))))
+    {
+        dst->ops = BEQL_IDLE_LOOP;
+        if (dynacore) genidle_loop();
+    }
     else if (dynacore)
         genbeql();
 }
@@ -1945,6 +2133,11 @@ static void RBNEL()
         dst->ops = BNEL_OUT;
         if (dynacore) genbnel_out();
     }
+    else if (is_idle_loop(target, (1 << ((src >> 21) & 0x1F)) | (1 << ((src >> 16) & 0x1F))))
+    {
+        dst->ops = BNEL_IDLE_LOOP;
+        if (dynacore) genidle_loop();
+    }
     else if (dynacore)
         genbnel();
 }
@@ -2262,6 +2455,89 @@ static void (*recomp_ops[64])(void) = {
     RLWU,     RSB,     RSH,  RSWL,  RSW,   RSDL,  RSDR,  RSWR,  RCACHE, RLL,    RLWC1,  RSV,    RSV,
     RLLD,     RLDC1,   RSV,  RLD,   RSC,   RSWC1, RSV,   RSV,   RSCD,   RSDC1,  RSV,    RSD};
 
+/**
+ * \brief Resets the dynarec metadata of the instruction being decoded, if the dynarec is active.
+ */
+static void init_dyna_instr(precomp_block *block)
+{
+    if (!dynacore) return;
+    dyna_instr *instr = get_dyna_instr(block, dst);
+    instr->reg_cache_infos.need_map = 0;
+    instr->local_addr = code_length;
+    instr->const_dependent = false;
+}
+
+bool get_known_gpr(const int64_t *gpr, int32_t *value)
+{
+    const uint32_t index = gpr - reg;
+    if (index >= 32 || !(known_gprs.known >> index & 1)) return false;
+
+    *value = known_gprs.values[index];
+    return true;
+}
+
+void use_known_gpr(const int64_t *gpr)
+{
+    if (gpr != reg) get_dyna_instr(dst_block, dst)->const_dependent = true;
+}
+
+/**
+ * \brief Decodes the current instruction for the interpreter without emitting any code for it.
+ */
+static void decode_only()
+{
+    dynacore = 0;
+    recomp_ops[((src >> 26) & 0x3F)]();
+    dynacore = 1;
+}
+
+/**
+ * \brief Recompiles the current instruction, replacing it with a load of its result if the result is known.
+ * \param state The GPRs known to hold a constant before the instruction.
+ */
+static void recompile_folded(const const_state &state)
+{
+    uint32_t gpr, reads;
+    int32_t value;
+    if (!const_prop_fold(state, src, gpr, value, reads))
+    {
+        recomp_ops[((src >> 26) & 0x3F)]();
+        return;
+    }
+
+    decode_only();
+    genli(gpr, value);
+    if (reads & ~1) get_dyna_instr(dst_block, dst)->const_dependent = true;
+}
+
+/**
+ * \brief Recompiles the instruction at an index of the block, using and updating the known GPRs.
+ * \param source The block's instructions.
+ * \param i The instruction's index.
+ * \param first The index the recompilation started at.
+ * \param length The number of instructions in the block.
+ */
+static void recompile_known(const int32_t *source, const int32_t i, const int32_t first, const int32_t length)
+{
+    // Nothing is known where execution may come from elsewhere. The instructions past the end of the page can only be
+    // reached by falling through.
+    if (i == first || (i < length && branch_targets[i / 32] >> (i % 32) & 1) ||
+        get_dyna_instr(dst_block, dst)->const_entry || (i > 0 && const_prop_is_barrier(source[i - 1])) ||
+        (i >= 2 && const_prop_is_control(source[i - 2])))
+    {
+        const_prop_reset(known_gprs);
+    }
+
+    // A delay slot's result is read by the branch's code emitted before it, so it's never dead
+    const bool delay_slot = i > 0 && const_prop_is_control(source[i - 1]);
+    if (!delay_slot && i + 1 < length && const_prop_is_dead(source + i, std::min(length - i, DEAD_WRITE_WINDOW)))
+        decode_only();
+    else
+        recompile_folded(known_gprs);
+
+    const_prop_step(known_gprs, src);
+}
+
 /**********************************************************************
  ******************** initialize an empty block ***********************
  **********************************************************************/
@@ -2272,14 +2548,23 @@ void init_block(int32_t *source, precomp_block *block)
     // g_core->log_info(L"init block recompiled {:#06x}\n", (int32_t)block->start);
 
     length = (block->end - block->start) / 4;
+    block->hash = 0;
+    memset(&code_lines[block->start >> 11], 0, (block->end - block->start) / 64 / 8);
 
     if (!block->block)
     {
         block->block = (precomp_instr *)malloc(((length + 1) + (length >> 2)) * sizeof(precomp_instr));
         already_exist = 0;
     }
+    if (dynacore && !block->dyna)
+    {
+        block->dyna = (dyna_instr *)calloc((length + 1) + (length >> 2), sizeof(dyna_instr));
+        already_exist = 0;
+    }
     if (dynacore)
     {
+        exec_begin_write();
+        unlink_block(block);
         if (!block->code)
         {
             block->code = (unsigned char *)malloc_exec(CODE_BLOCK_SIZE);
@@ -2296,7 +2581,7 @@ void init_block(int32_t *source, precomp_block *block)
             block->jumps_table = NULL;
         }
         init_assembler(NULL, 0);
-        init_cache(block->block);
+        init_cache(block, block->block);
     }
 
     if (!already_exist)
@@ -2305,8 +2590,7 @@ void init_block(int32_t *source, precomp_block *block)
         {
             dst = block->block + i;
             dst->addr = block->start + i * 4;
-            dst->reg_cache_infos.need_map = 0;
-            dst->local_addr = code_length;
+            init_dyna_instr(block);
             RNOTCOMPILED();
         }
         init_length = code_length;
@@ -2317,8 +2601,12 @@ void init_block(int32_t *source, precomp_block *block)
         for (i = 0; i < length; i++)
         {
             dst = block->block + i;
-            dst->reg_cache_infos.need_map = 0;
-            dst->local_addr = i * (code_length / length);
+            if (dynacore)
+            {
+                get_dyna_instr(block, dst)->reg_cache_infos.need_map = 0;
+                get_dyna_instr(block, dst)->local_addr = i * (code_length / length);
+                get_dyna_instr(block, dst)->const_dependent = false;
+            }
             dst->ops = NOTCOMPILED;
         }
     }
@@ -2330,6 +2618,7 @@ void init_block(int32_t *source, precomp_block *block)
         block->code_length = code_length;
         block->max_code_length = max_code_length;
         free_assembler(&block->jumps_table, &block->jumps_number);
+        exec_end_write();
     }
 
     /* here we're marking the block as a valid code even if it's not compiled
@@ -2347,6 +2636,7 @@ void init_block(int32_t *source, precomp_block *block)
             blocks[paddr >> 12] = (precomp_block *)malloc(sizeof(precomp_block));
             blocks[paddr >> 12]->code = NULL;
             blocks[paddr >> 12]->block = NULL;
+            blocks[paddr >> 12]->dyna = NULL;
             blocks[paddr >> 12]->jumps_table = NULL;
             blocks[paddr >> 12]->start = paddr & ~0xFFF;
             blocks[paddr >> 12]->end = (paddr & ~0xFFF) + 0x1000;
@@ -2360,6 +2650,7 @@ void init_block(int32_t *source, precomp_block *block)
             blocks[paddr >> 12] = (precomp_block *)malloc(sizeof(precomp_block));
             blocks[paddr >> 12]->code = NULL;
             blocks[paddr >> 12]->block = NULL;
+            blocks[paddr >> 12]->dyna = NULL;
             blocks[paddr >> 12]->jumps_table = NULL;
             blocks[paddr >> 12]->start = paddr & ~0xFFF;
             blocks[paddr >> 12]->end = (paddr & ~0xFFF) + 0x1000;
@@ -2375,6 +2666,7 @@ void init_block(int32_t *source, precomp_block *block)
                 blocks[(block->start + 0x20000000) >> 12] = (precomp_block *)malloc(sizeof(precomp_block));
                 blocks[(block->start + 0x20000000) >> 12]->code = NULL;
                 blocks[(block->start + 0x20000000) >> 12]->block = NULL;
+                blocks[(block->start + 0x20000000) >> 12]->dyna = NULL;
                 blocks[(block->start + 0x20000000) >> 12]->jumps_table = NULL;
                 blocks[(block->start + 0x20000000) >> 12]->start = (block->start + 0x20000000) & ~0xFFF;
                 blocks[(block->start + 0x20000000) >> 12]->end = ((block->start + 0x20000000) & ~0xFFF) + 0x1000;
@@ -2388,6 +2680,7 @@ void init_block(int32_t *source, precomp_block *block)
                 blocks[(block->start - 0x20000000) >> 12] = (precomp_block *)malloc(sizeof(precomp_block));
                 blocks[(block->start - 0x20000000) >> 12]->code = NULL;
                 blocks[(block->start - 0x20000000) >> 12]->block = NULL;
+                blocks[(block->start - 0x20000000) >> 12]->dyna = NULL;
                 blocks[(block->start - 0x20000000) >> 12]->jumps_table = NULL;
                 blocks[(block->start - 0x20000000) >> 12]->start = (block->start - 0x20000000) & ~0xFFF;
                 blocks[(block->start - 0x20000000) >> 12]->end = ((block->start - 0x20000000) & ~0xFFF) + 0x1000;
@@ -2413,8 +2706,10 @@ void recompile_block(int32_t *source, precomp_block *block, uint32_t func)
         code_length = block->code_length;
         max_code_length = block->max_code_length;
         inst_pointer = &block->code;
+        exec_begin_write();
         init_assembler(block->jumps_table, block->jumps_number);
-        init_cache(block->block + (func & 0xFFF) / 4);
+        init_cache(block, block->block + (func & 0xFFF) / 4);
+        const_prop_find_targets(source, block->start, length, branch_targets);
     }
 
     for (i = (func & 0xFFF) / 4; /*i<length &&*/ finished != 2; i++)
@@ -2424,6 +2719,7 @@ void recompile_block(int32_t *source, precomp_block *block, uint32_t func)
             uint32_t address2 = virtual_to_physical_address(block->start + i * 4, 0);
             if (blocks[address2 >> 12]->block[(address2 & 0xFFF) / 4].ops == NOTCOMPILED)
                 blocks[address2 >> 12]->block[(address2 & 0xFFF) / 4].ops = NOTCOMPILED2;
+            mark_code_line(address2);
         }
 
         SRC = source + i;
@@ -2434,9 +2730,12 @@ void recompile_block(int32_t *source, precomp_block *block, uint32_t func)
             check_nop = 0;
         dst = block->block + i;
         dst->addr = block->start + i * 4;
-        dst->reg_cache_infos.need_map = 0;
-        dst->local_addr = code_length;
-        recomp_ops[((src >> 26) & 0x3F)]();
+        init_dyna_instr(block);
+        if (dynacore)
+            recompile_known(source, i, (func & 0xFFF) / 4, length);
+        else
+            recomp_ops[((src >> 26) & 0x3F)]();
+        mark_code_line(dst->addr);
         if (g_ctx.tl_active())
         {
             dst->s_ops = dst->ops;
@@ -2469,16 +2768,14 @@ void recompile_block(int32_t *source, precomp_block *block, uint32_t func)
     {
         dst = block->block + i;
         dst->addr = block->start + i * 4;
-        dst->reg_cache_infos.need_map = 0;
-        dst->local_addr = code_length;
+        init_dyna_instr(block);
         RFIN_BLOCK();
         i++;
         if (i < length - 1 + (length >> 2)) // useful when last opcode is a jump
         {
             dst = block->block + i;
             dst->addr = block->start + i * 4;
-            dst->reg_cache_infos.need_map = 0;
-            dst->local_addr = code_length;
+            init_dyna_instr(block);
             RFIN_BLOCK();
             i++;
         }
@@ -2492,6 +2789,7 @@ void recompile_block(int32_t *source, precomp_block *block, uint32_t func)
         block->code_length = code_length;
         block->max_code_length = max_code_length;
         free_assembler(&block->jumps_table, &block->jumps_number);
+        exec_end_write();
     }
     // g_core->log_info(L"block recompiled ({:#06x}-%x)\n", (int32_t)func, (int32_t)(block->start+i*4));
     // getchar();
@@ -2519,7 +2817,10 @@ int32_t is_jump()
         dst->ops == BGEZALL || dst->ops == BGEZALL_OUT || dst->ops == BGEZALL_IDLE || dst->ops == BC1F ||
         dst->ops == BC1F_OUT || dst->ops == BC1F_IDLE || dst->ops == BC1T || dst->ops == BC1T_OUT ||
         dst->ops == BC1T_IDLE || dst->ops == BC1FL || dst->ops == BC1FL_OUT || dst->ops == BC1FL_IDLE ||
-        dst->ops == BC1TL || dst->ops == BC1TL_OUT || dst->ops == BC1TL_IDLE)
+        dst->ops == BC1TL || dst->ops == BC1TL_OUT || dst->ops == BC1TL_IDLE || dst->ops == BEQ_IDLE_LOOP ||
+        dst->ops == BNE_IDLE_LOOP || dst->ops == BLEZ_IDLE_LOOP || dst->ops == BGTZ_IDLE_LOOP ||
+        dst->ops == BEQL_IDLE_LOOP || dst->ops == BNEL_IDLE_LOOP || dst->ops == BLTZ_IDLE_LOOP ||
+        dst->ops == BGEZ_IDLE_LOOP)
         jump = 1;
     if (dyn) dynacore = 1;
     return jump;
@@ -2534,11 +2835,19 @@ void recompile_opcode()
     src = *SRC;
     dst++;
     dst->addr = (dst - 1)->addr + 4;
-    dst->reg_cache_infos.need_map = 0;
-    if (!is_jump())
-        recomp_ops[((src >> 26) & 0x3F)]();
-    else
+    if (dynacore) get_dyna_instr(dst_block, dst)->reg_cache_infos.need_map = 0;
+    if (is_jump())
         RNOP();
+    else if (dynacore)
+    {
+        // The delay slot runs after the branch, which is still being recompiled
+        const_state state = known_gprs;
+        const_prop_step(state, *(SRC - 1));
+        recompile_folded(state);
+    }
+    else
+        recomp_ops[((src >> 26) & 0x3F)]();
+    mark_code_line(dst->addr);
     delay_slot_compiled = 2;
 }
 
@@ -2570,6 +2879,7 @@ void vr_recompile(uint32_t addr)
     {
         g_core->log_info(L"core_vr_recompile all blocks");
         memset(invalid_code, 1, 0x100000);
+        clear_block_hashes();
         return;
     }
 
@@ -2596,3 +2906,73 @@ void vr_recompile(uint32_t addr)
         }
     }
 }
+
+/**
+ * \brief Gets whether a virtual page lies in KSEG0 or KSEG1 and is backed by RDRAM.
+ */
+static bool is_rdram_page(uint32_t vpage)
+{
+    return (vpage >= (0x80000000 >> 12) && vpage < (0x80800000 >> 12)) ||
+           (vpage >= (0xa0000000 >> 12) && vpage < (0xa0800000 >> 12));
+}
+
+static uint64_t hash_rdram_page(uint32_t vpage)
+{
+    return xxh64::hash((const char *)&rdram[((vpage << 12) & 0x7FF000) / 4], 0x1000, 0);
+}
+
+void hash_rdram_blocks(uint32_t begin, uint32_t end)
+{
+    if (end <= begin) return;
+
+    for (uint32_t page = (begin & 0x7FFFFF) >> 12; page <= ((end - 1) & 0x7FFFFF) >> 12; page++)
+    {
+        for (uint32_t vpage : {page + (0x80000000 >> 12), page + (0xa0000000 >> 12)})
+        {
+            if (invalid_code[vpage] || !blocks[vpage] || !blocks[vpage]->block) continue;
+            blocks[vpage]->hash = hash_rdram_page(vpage);
+        }
+    }
+}
+
+void clear_rdram_block_hashes(uint32_t begin, uint32_t end)
+{
+    if (end <= begin) return;
+
+    for (uint32_t page = (begin & 0x7FFFFF) >> 12; page <= ((end - 1) & 0x7FFFFF) >> 12; page++)
+    {
+        for (uint32_t vpage : {page + (0x80000000 >> 12), page + (0xa0000000 >> 12)})
+        {
+            if (!invalid_code[vpage] && blocks[vpage]) blocks[vpage]->hash = 0;
+        }
+    }
+}
+
+void clear_block_hashes()
+{
+    for (precomp_block *block : blocks)
+    {
+        if (block) block->hash = 0;
+    }
+}
+
+bool revalidate_block(uint32_t vpage)
+{
+    if (!invalid_code[vpage]) return true;
+    if (!is_rdram_page(vpage) || !blocks[vpage] || !blocks[vpage]->hash) return false;
+
+    // Both KSEG0 and KSEG1 views of the page must agree, otherwise update_invalid_addr would invalidate us again.
+    const uint32_t alias = vpage ^ (0x20000000 >> 12);
+    const uint64_t hash = hash_rdram_page(vpage);
+
+    if (blocks[vpage]->hash != hash) return false;
+    if (invalid_code[alias] && (!blocks[alias] || blocks[alias]->hash != hash)) return false;
+
+    // The hash only describes the page up to now, so it mustn't outlive the revalidation.
+    for (uint32_t page : {vpage, alias})
+    {
+        invalid_code[page] = 0;
+        if (blocks[page]) blocks[page]->hash = 0;
+    }
+    return true;
+}
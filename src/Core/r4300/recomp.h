@@ -50,15 +50,31 @@ typedef struct _precomp_instr
     } f;
 
     uint32_t addr;
-    uint32_t local_addr;
-    reg_cache_struct reg_cache_infos;
     void (*s_ops)();
     uint32_t src;
 } precomp_instr;
 
+/**
+ * \brief The dynarec's metadata for an instruction. It's kept in a side table parallel to the block's
+ * <c>precomp_instr</c> array, so the interpreters only walk the decoded instructions.
+ */
+typedef struct _dyna_instr
+{
+    uint32_t local_addr;
+    reg_cache_struct reg_cache_infos;
+    // Whether the instruction's code relies on register values known from the instructions before it, so it may only
+    // be reached by falling through from them. Other entries go through a wrapper which recompiles the block from it.
+    bool const_dependent;
+    // Whether the instruction has been entered through such a wrapper, so recompilations don't carry known register
+    // values into it.
+    bool const_entry;
+} dyna_instr;
+
 typedef struct _precomp_block
 {
     precomp_instr *block;
+    // The dynarec metadata parallel to block, or NULL if the block was created while the dynarec wasn't active.
+    dyna_instr *dyna;
     uint32_t start;
     uint32_t end;
     unsigned char *code;
@@ -66,16 +82,103 @@ typedef struct _precomp_block
     uint32_t max_code_length;
     void *jumps_table;
     int32_t jumps_number;
+    // Hash of the code page's contents at the moment the block was invalidated, or 0 if unknown.
+    // Lets the block be revalidated instead of rebuilt if the same code is present when it's entered again.
     uint64_t hash;
 } precomp_block;
 
+/**
+ * \brief Gets the dynarec metadata of an instruction in a block.
+ */
+inline dyna_instr *get_dyna_instr(const precomp_block *block, const precomp_instr *instr)
+{
+    return &block->dyna[instr - block->block];
+}
+
+/**
+ * \brief A bitset with one bit per 64-byte line of the address space, set once an instruction in the line has been
+ * compiled. Stores test it to decide whether they must invalidate their page. Bits are only cleared when the page's
+ * block is reinitialized, so a stale bit merely causes a spurious invalidation.
+ */
+extern uint32_t code_lines[0x200000];
+
+/**
+ * \brief Marks the line containing an address as holding compiled code.
+ */
+inline void mark_code_line(uint32_t addr)
+{
+    code_lines[addr >> 11] |= 1 << ((addr >> 6) & 31);
+}
+
+/**
+ * \brief Gets whether the line containing an address may hold compiled code.
+ */
+inline bool is_code_line(uint32_t addr)
+{
+    return code_lines[addr >> 11] >> ((addr >> 6) & 31) & 1;
+}
+
 void recompile_block(int32_t *source, precomp_block *block, uint32_t func);
 void init_block(int32_t *source, precomp_block *block);
 void recompile_opcode();
 void prefetch_opcode(uint32_t op);
 void dyna_jump();
+
+/**
+ * \brief The size of an exit stub emitted by <c>genlink_out</c>, up to the call to <c>dyna_link_jump</c>.
+ */
+#define LINK_STUB_SIZE 69
+
+/**
+ * \brief The size of the room for the direct jump at the start of an exit stub, after the short jump skipping it.
+ */
+#define LINK_BODY_SIZE 40
+
+/**
+ * \brief Called by the exit stub of a jump to a known address outside the block. Jumps like <c>jump_to_func</c>, then
+ * patches the stub to jump straight to the target's code from now on if it's compiled.
+ */
+void dyna_link_jump();
+
+/**
+ * \brief Undoes the links into a block and forgets the links out of it, before its code is rewritten.
+ */
+void unlink_block(const precomp_block *block);
+
+/**
+ * \brief Forgets all links, once the blocks' code has been freed.
+ */
+void clear_block_links();
+
 void dyna_start(void (*code)());
 void dyna_stop();
 void vr_recompile(uint32_t addr);
 
+/**
+ * \brief Records content hashes for all valid blocks backed by an RDRAM range which is about to be overwritten.
+ * \param begin The physical start address of the range.
+ * \param end The physical end address of the range (exclusive).
+ */
+void hash_rdram_blocks(uint32_t begin, uint32_t end);
+
+/**
+ * \brief Drops the hashes recorded by <c>hash_rdram_blocks</c> for blocks which stayed valid after the overwrite.
+ * \param begin The physical start address of the range.
+ * \param end The physical end address of the range (exclusive).
+ */
+void clear_rdram_block_hashes(uint32_t begin, uint32_t end);
+
+/**
+ * \brief Drops all recorded block hashes, forcing every invalidated block to be rebuilt.
+ */
+void clear_block_hashes();
+
+/**
+ * \brief Tries to revalidate an invalidated RDRAM-backed block by comparing its recorded hash against the page's
+ * current contents.
+ * \param vpage The virtual page index of the block.
+ * \return Whether the block (and its KSEG0/KSEG1 alias) is valid again.
+ */
+bool revalidate_block(uint32_t vpage);
+
 extern precomp_instr *dst;
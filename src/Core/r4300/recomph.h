@@ -22,6 +22,27 @@ void free_assembler(void **block_jumps_table, int32_t *block_jumps_number);
 
 void gencallinterp(uint32_t addr, int32_t jump);
 
+/**
+ * \brief Gets the value of a GPR if it's known to hold a constant before the instruction being recompiled. Code
+ * relying on the value must call <c>use_known_gpr</c>.
+ * \param gpr The GPR.
+ * \param value Receives the GPR's value, sign-extended from it.
+ * \return Whether the GPR's value is known.
+ */
+bool get_known_gpr(const int64_t *gpr, int32_t *value);
+
+/**
+ * \brief Marks the instruction being recompiled as relying on the known value of a GPR.
+ */
+void use_known_gpr(const int64_t *gpr);
+
+/**
+ * \brief Emits code setting a GPR to a constant.
+ * \param gpr The GPR's index.
+ * \param value The constant, which is sign-extended.
+ */
+void genli(uint32_t gpr, int32_t value);
+
 void genupdate_system(int32_t type);
 void genbnel();
 void genblezl();
@@ -269,6 +290,7 @@ void gencheck_interrupt_reg();
 void gentest();
 void gentest_out();
 void gentest_idle();
+void genidle_loop();
 void gentestl();
 void gentestl_out();
 void gencheck_cop1_unusable();
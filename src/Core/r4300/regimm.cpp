@@ -54,6 +54,12 @@ void BLTZ_IDLE()
         BLTZ();
 }
 
+void BLTZ_IDLE_LOOP()
+{
+    if (!skip_idle_loop(core_irs < 0))
+        BLTZ();
+}
+
 void BGEZ()
 {
     local_rs = core_irs;
@@ -97,6 +103,12 @@ void BGEZ_IDLE()
         BGEZ();
 }
 
+void BGEZ_IDLE_LOOP()
+{
+    if (!skip_idle_loop(core_irs >= 0))
+        BGEZ();
+}
+
 void BLTZL()
 {
     if (core_irs < 0)
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "stdafx.h"
+#include "synclog.h"
+#include <Core.h>
+#include <memory/memory.h>
+#include <r4300/r4300.h>
+#include <r4300/vcr.h>
+
+constexpr uint32_t SL_MAGIC = 0x474F4C53;
+constexpr uint32_t SL_VERSION = 1;
+
+using t_sl_hashes = std::array<uint64_t, core_sl_section_count>;
+
+static std::mutex g_sl_mutex;
+static bool g_sl_active{};
+static core_sl_log g_sl_log{};
+
+// The section hashes as of the last checkpoint, used to only store changed sections.
+static t_sl_hashes g_sl_hashes{};
+
+// The log checkpoints are compared against as they're taken, along with the index of its first entry not applied to
+// its hashes yet and the first divergence found.
+static core_sl_log g_sl_reference{};
+static size_t g_sl_reference_index{};
+static t_sl_hashes g_sl_reference_hashes{};
+static core_sl_divergence g_sl_divergence{};
+
+template <typename... T> static uint64_t hash_parts(const T &...parts)
+{
+    std::vector<uint8_t> buf;
+    (MiscHelpers::vecwrite(buf, &parts, sizeof(parts)), ...);
+    return xxh64::hash((const char *)buf.data(), buf.size(), 0);
+}
+
+template <typename T> static uint64_t hash_bytes(const T *data, const size_t len)
+{
+    return xxh64::hash((const char *)data, len, 0);
+}
+
+static void compute_hashes(t_sl_hashes &hashes)
+{
+    for (size_t i = 0; i < CORE_SL_RDRAM_PAGE_COUNT; ++i)
+    {
+        hashes[i] = hash_bytes(rdramb + i * CORE_SL_RDRAM_PAGE_SIZE, CORE_SL_RDRAM_PAGE_SIZE);
+    }
+
+    // The PC is left out, as the dynarec doesn't keep PC->addr up to date and it would differ between cores.
+    hashes[core_sl_section_cpu] = hash_parts(reg, hi, lo, llbit);
+    hashes[core_sl_section_cop0] = hash_bytes(reg_cop0, sizeof(reg_cop0));
+    hashes[core_sl_section_cop1] = hash_parts(reg_cop1_fgr_64, FCR0, FCR31);
+    hashes[core_sl_section_tlb] = hash_bytes(tlb_e, sizeof(tlb_e));
+    hashes[core_sl_section_sp_dmem] = hash_bytes(SP_DMEM, 0x1000);
+    hashes[core_sl_section_sp_imem] = hash_bytes(SP_IMEM, 0x1000);
+    hashes[core_sl_section_pif_ram] = hash_bytes(PIF_RAM, sizeof(PIF_RAM));
+    hashes[core_sl_section_rdram_reg] = hash_parts(rdram_register);
+    hashes[core_sl_section_mi_reg] = hash_parts(MI_register);
+    hashes[core_sl_section_pi_reg] = hash_parts(pi_register);
+    hashes[core_sl_section_sp_reg] = hash_parts(sp_register);
+    hashes[core_sl_section_rsp_reg] = hash_parts(rsp_register);
+    hashes[core_sl_section_si_reg] = hash_parts(si_register);
+    hashes[core_sl_section_vi_reg] = hash_parts(vi_register);
+    hashes[core_sl_section_ri_reg] = hash_parts(ri_register);
+    hashes[core_sl_section_ai_reg] = hash_parts(ai_register);
+    hashes[core_sl_section_dpc_reg] = hash_parts(dpc_register);
+    hashes[core_sl_section_dps_reg] = hash_parts(dps_register);
+}
+
+/**
+ * \brief Applies a checkpoint's changes on top of the hashes of the previous checkpoint.
+ */
+static void apply_entry(t_sl_hashes &hashes, const core_sl_entry &entry)
+{
+    for (const auto &[section, hash] : entry.changes)
+    {
+        if (section < hashes.size())
+        {
+            hashes[section] = hash;
+        }
+    }
+}
+
+/**
+ * \brief Discards all checkpoints at or after the specified sample, which happens when a savestate rewinds the movie.
+ */
+static void truncate_log(const uint32_t sample)
+{
+    const auto it = std::ranges::find_if(g_sl_log.entries, [=](const auto &entry) { return entry.sample >= sample; });
+    g_sl_log.entries.erase(it, g_sl_log.entries.end());
+
+    g_sl_hashes = {};
+    for (const auto &entry : g_sl_log.entries)
+    {
+        apply_entry(g_sl_hashes, entry);
+    }
+
+    // The reference's hashes are rebuilt up to the next compared checkpoint, and a divergence in the discarded part
+    // may not happen again.
+    g_sl_reference_index = 0;
+    g_sl_reference_hashes = {};
+    if (g_sl_divergence.sample >= sample)
+    {
+        g_sl_divergence = {};
+    }
+}
+
+/**
+ * \brief Compares the checkpoint just taken against the reference, if it has one at the same sample. Mirrors
+ * sl_find_divergence, but only walks the reference entries added since the last checkpoint.
+ */
+static void compare_reference(const uint32_t sample)
+{
+    const auto &entries = g_sl_reference.entries;
+    bool has_sample = false;
+    while (g_sl_reference_index < entries.size() && entries[g_sl_reference_index].sample <= sample)
+    {
+        has_sample = entries[g_sl_reference_index].sample == sample;
+        apply_entry(g_sl_reference_hashes, entries[g_sl_reference_index]);
+        ++g_sl_reference_index;
+    }
+
+    if (!has_sample || g_sl_divergence.sample != SIZE_MAX || g_sl_reference_hashes == g_sl_hashes)
+    {
+        return;
+    }
+
+    g_sl_divergence.sample = sample;
+    for (uint16_t section = 0; section < core_sl_section_count; ++section)
+    {
+        if (g_sl_reference_hashes[section] != g_sl_hashes[section])
+        {
+            g_sl_divergence.sections.emplace_back(section);
+        }
+    }
+}
+
+void sl_on_input_poll()
+{
+    std::scoped_lock lock(g_sl_mutex);
+
+    if (!g_sl_active)
+    {
+        return;
+    }
+
+    uint32_t sample;
+    {
+        std::scoped_lock vcr_lock(vcr_mtx);
+        if (vcr.task != task_playback && vcr.task != task_recording)
+        {
+            return;
+        }
+        sample = vcr.current_sample;
+    }
+
+    if (sample % g_sl_log.interval != 0)
+    {
+        return;
+    }
+
+    if (!g_sl_log.entries.empty() && g_sl_log.entries.back().sample >= sample)
+    {
+        truncate_log(sample);
+    }
+
+    t_sl_hashes hashes;
+    compute_hashes(hashes);
+
+    core_sl_entry entry{.sample = sample};
+    for (uint16_t i = 0; i < hashes.size(); ++i)
+    {
+        if (g_sl_log.entries.empty() || hashes[i] != g_sl_hashes[i])
+        {
+            entry.changes.emplace_back(i, hashes[i]);
+        }
+    }
+
+    g_sl_hashes = hashes;
+    g_sl_log.entries.emplace_back(std::move(entry));
+
+    compare_reference(sample);
+}
+
+bool sl_active()
+{
+    std::scoped_lock lock(g_sl_mutex);
+    return g_sl_active;
+}
+
+void sl_start(const size_t interval)
+{
+    std::scoped_lock lock(g_sl_mutex);
+    g_sl_log = {.interval = (uint32_t)std::max(interval, (size_t)1)};
+    g_sl_hashes = {};
+    g_sl_reference = {};
+    g_sl_reference_index = 0;
+    g_sl_reference_hashes = {};
+    g_sl_divergence = {};
+    g_sl_active = true;
+    g_core->log_info(std::format(L"[SL] Started with interval {}", g_sl_log.interval));
+}
+
+void sl_stop()
+{
+    std::scoped_lock lock(g_sl_mutex);
+    g_sl_active = false;
+    g_core->log_info(std::format(L"[SL] Stopped with {} checkpoints", g_sl_log.entries.size()));
+}
+
+void sl_get_log(core_sl_log &log)
+{
+    std::scoped_lock lock(g_sl_mutex);
+    log = g_sl_log;
+}
+
+void sl_set_reference(const core_sl_log &log)
+{
+    std::scoped_lock lock(g_sl_mutex);
+    g_sl_reference = log;
+    g_sl_reference_index = 0;
+    g_sl_reference_hashes = {};
+    g_sl_divergence = {};
+}
+
+core_sl_divergence sl_get_divergence()
+{
+    std::scoped_lock lock(g_sl_mutex);
+    return g_sl_divergence;
+}
+
+bool sl_save(const std::filesystem::path &path)
+{
+    std::vector<uint8_t> buf;
+
+    {
+        std::scoped_lock lock(g_sl_mutex);
+
+        const auto entry_count = (uint32_t)g_sl_log.entries.size();
+        MiscHelpers::vecwrite(buf, &SL_MAGIC, sizeof(SL_MAGIC));
+        MiscHelpers::vecwrite(buf, &SL_VERSION, sizeof(SL_VERSION));
+        MiscHelpers::vecwrite(buf, &g_sl_log.interval, sizeof(g_sl_log.interval));
+        MiscHelpers::vecwrite(buf, &entry_count, sizeof(entry_count));
+
+        for (const auto &entry : g_sl_log.entries)
+        {
+            const auto change_count = (uint32_t)entry.changes.size();
+            MiscHelpers::vecwrite(buf, &entry.sample, sizeof(entry.sample));
+            MiscHelpers::vecwrite(buf, &change_count, sizeof(change_count));
+            for (const auto &[section, hash] : entry.changes)
+            {
+                MiscHelpers::vecwrite(buf, &section, sizeof(section));
+                MiscHelpers::vecwrite(buf, &hash, sizeof(hash));
+            }
+        }
+    }
+
+    return g_core->io_service->write_file_buffer(path, buf);
+}
+
+bool sl_load(const std::filesystem::path &path, core_sl_log &log)
+{
+    auto buf = g_core->io_service->read_file_buffer(path);
+    uint8_t *ptr = buf.data();
+    const uint8_t *end = buf.data() + buf.size();
+
+    const auto read = [&](void *dest, const size_t len) {
+        if ((size_t)(end - ptr) < len)
+        {
+            return false;
+        }
+        MiscHelpers::memread(&ptr, dest, len);
+        return true;
+    };
+
+    uint32_t magic{}, version{}, entry_count{};
+    core_sl_log result{};
+
+    if (!read(&magic, sizeof(magic)) || magic != SL_MAGIC || !read(&version, sizeof(version)) ||
+        version != SL_VERSION || !read(&result.interval, sizeof(result.interval)) ||
+        !read(&entry_count, sizeof(entry_count)))
+    {
+        g_core->log_error(std::format(L"[SL] {} is not a valid sync log", path.wstring()));
+        return false;
+    }
+
+    for (uint32_t i = 0; i < entry_count; ++i)
+    {
+        core_sl_entry entry{};
+        uint32_t change_count{};
+        if (!read(&entry.sample, sizeof(entry.sample)) || !read(&change_count, sizeof(change_count)))
+        {
+            return false;
+        }
+
+        if ((size_t)(end - ptr) / (sizeof(uint16_t) + sizeof(uint64_t)) < change_count)
+        {
+            return false;
+        }
+
+        entry.changes.resize(change_count);
+        for (auto &[section, hash] : entry.changes)
+        {
+            read(&section, sizeof(section));
+            read(&hash, sizeof(hash));
+        }
+
+        result.entries.emplace_back(std::move(entry));
+    }
+
+    log = std::move(result);
+    return true;
+}
+
+core_sl_divergence sl_find_divergence(const core_sl_log &first, const core_sl_log &second)
+{
+    core_sl_divergence divergence{};
+
+    t_sl_hashes first_hashes{};
+    t_sl_hashes second_hashes{};
+
+    // Both logs are ordered by sample, so walk them in lockstep and only compare samples present in both.
+    size_t i = 0, j = 0;
+    while (i < first.entries.size() && j < second.entries.size())
+    {
+        const auto &a = first.entries[i];
+        const auto &b = second.entries[j];
+
+        if (a.sample < b.sample)
+        {
+            apply_entry(first_hashes, a);
+            ++i;
+            continue;
+        }
+
+        if (b.sample < a.sample)
+        {
+            apply_entry(second_hashes, b);
+            ++j;
+            continue;
+        }
+
+        apply_entry(first_hashes, a);
+        apply_entry(second_hashes, b);
+        ++i;
+        ++j;
+
+        if (first_hashes == second_hashes)
+        {
+            continue;
+        }
+
+        divergence.sample = a.sample;
+        for (uint16_t section = 0; section < core_sl_section_count; ++section)
+        {
+            if (first_hashes[section] != second_hashes[section])
+            {
+                divergence.sections.emplace_back(section);
+            }
+        }
+        break;
+    }
+
+    return divergence;
+}
+
+std::wstring sl_get_section_name(const uint16_t section)
+{
+    if (section < CORE_SL_RDRAM_PAGE_COUNT)
+    {
+        const uint32_t start = section * CORE_SL_RDRAM_PAGE_SIZE;
+        return std::format(L"RDRAM 0x{:06X}-0x{:06X}", start, start + CORE_SL_RDRAM_PAGE_SIZE - 1);
+    }
+
+    switch (section)
+    {
+    case core_sl_section_cpu:
+        return L"CPU registers";
+    case core_sl_section_cop0:
+        return L"COP0 registers";
+    case core_sl_section_cop1:
+        return L"COP1 registers";
+    case core_sl_section_tlb:
+        return L"TLB";
+    case core_sl_section_sp_dmem:
+        return L"SP DMEM";
+    case core_sl_section_sp_imem:
+        return L"SP IMEM";
+    case core_sl_section_pif_ram:
+        return L"PIF RAM";
+    case core_sl_section_rdram_reg:
+        return L"RDRAM registers";
+    case core_sl_section_mi_reg:
+        return L"MI registers";
+    case core_sl_section_pi_reg:
+        return L"PI registers";
+    case core_sl_section_sp_reg:
+        return L"SP registers";
+    case core_sl_section_rsp_reg:
+        return L"RSP registers";
+    case core_sl_section_si_reg:
+        return L"SI registers";
+    case core_sl_section_vi_reg:
+        return L"VI registers";
+    case core_sl_section_ri_reg:
+        return L"RI registers";
+    case core_sl_section_ai_reg:
+        return L"AI registers";
+    case core_sl_section_dpc_reg:
+        return L"DPC registers";
+    case core_sl_section_dps_reg:
+        return L"DPS registers";
+    default:
+        return std::format(L"Unknown section {}", section);
+    }
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+/**
+ * \brief Notifies the sync log about an input poll. Must be called from the emu thread at the point where savestate
+ * work is performed.
+ */
+void sl_on_input_poll();
+
+bool sl_active();
+void sl_start(size_t interval);
+void sl_stop();
+void sl_get_log(core_sl_log &log);
+void sl_set_reference(const core_sl_log &log);
+core_sl_divergence sl_get_divergence();
+bool sl_save(const std::filesystem::path &path);
+bool sl_load(const std::filesystem::path &path, core_sl_log &log);
+core_sl_divergence sl_find_divergence(const core_sl_log &first, const core_sl_log &second);
+std::wstring sl_get_section_name(uint16_t section);
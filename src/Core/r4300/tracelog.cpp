@@ -334,6 +334,7 @@ void tl_start(std::filesystem::path path, bool binary, bool append)
     _wfopen_s(&log_file, path.wstring().c_str(), L"wb");
 
     enabled = true;
+    interp_set_feature(INTERP_FEATURE_TRACELOG, true);
     if (interpcore == 0)
     {
         vr_recompile(UINT32_MAX);
@@ -343,6 +344,7 @@ void tl_start(std::filesystem::path path, bool binary, bool append)
 void tl_stop()
 {
     enabled = false;
+    interp_set_feature(INTERP_FEATURE_TRACELOG, false);
     flush_buf();
     fclose(log_file);
 }
@@ -57,20 +57,21 @@ static void add_jump(uint32_t pc_addr, uint32_t mi_addr)
 void passe2(precomp_instr *dest, int32_t start, int32_t end, precomp_block *block)
 {
     uint32_t i, real_code_length, addr_dest;
-    build_wrappers(dest, start, end, block);
+    build_wrappers(start, end, block);
     real_code_length = code_length;
 
     for (i = 0; i < jumps_number; i++)
     {
         code_length = jumps_table[i].pc_addr;
-        if (dest[(jumps_table[i].mi_addr - dest[0].addr) / 4].reg_cache_infos.need_map)
+        const dyna_instr *target = &block->dyna[(jumps_table[i].mi_addr - dest[0].addr) / 4];
+        if (target->reg_cache_infos.need_map)
         {
-            addr_dest = (uint32_t)dest[(jumps_table[i].mi_addr - dest[0].addr) / 4].reg_cache_infos.jump_wrapper;
+            addr_dest = (uint32_t)target->reg_cache_infos.jump_wrapper;
             put32(addr_dest - ((uint32_t)block->code + code_length) - 4);
         }
         else
         {
-            addr_dest = dest[(jumps_table[i].mi_addr - dest[0].addr) / 4].local_addr;
+            addr_dest = target->local_addr;
             put32(addr_dest - code_length - 4);
         }
     }
@@ -13,7 +13,7 @@
 
 static void gencheck_eax_valid(int32_t stackBase)
 {
-    if (!g_core->cfg->float_exception_emulation) return;
+    if (!g_float_exception_emulation) return;
 
     mov_reg32_imm32(EBX, (uint32_t)&largest_denormal_double);
     fld_preg32_qword(EBX);
@@ -23,7 +23,7 @@ static void gencheck_eax_valid(int32_t stackBase)
 
 static void gencheck_result_valid()
 {
-    if (!g_core->cfg->float_exception_emulation) return;
+    if (!g_float_exception_emulation) return;
 
     mov_reg32_imm32(EBX, (uint32_t)&largest_denormal_double);
     fld_preg32_qword(EBX);
@@ -32,7 +32,7 @@ static void gencheck_result_valid()
 
 static void gencheck_result_valid_s()
 {
-    if (!g_core->cfg->float_exception_emulation) return;
+    if (!g_float_exception_emulation) return;
 
     mov_reg32_imm32(EBX, (uint32_t)&largest_denormal_float);
     fld_preg32_dword(EBX);
@@ -42,7 +42,7 @@ static void gencheck_result_valid_s()
 void genadd_d()
 {
 #ifdef INTERPRET_ADD_D
-    gencallinterp((uint32_t)ADD_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(ADD_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -60,7 +60,7 @@ void genadd_d()
 void gensub_d()
 {
 #ifdef INTERPRET_SUB_D
-    gencallinterp((uint32_t)SUB_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(SUB_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -78,7 +78,7 @@ void gensub_d()
 void genmul_d()
 {
 #ifdef INTERPRET_MUL_D
-    gencallinterp((uint32_t)MUL_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(MUL_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -96,7 +96,7 @@ void genmul_d()
 void gendiv_d()
 {
 #ifdef INTERPRET_DIV_D
-    gencallinterp((uint32_t)DIV_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(DIV_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -114,7 +114,7 @@ void gendiv_d()
 void gensqrt_d()
 {
 #ifdef INTERPRET_SQRT_D
-    gencallinterp((uint32_t)SQRT_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(SQRT_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -130,7 +130,7 @@ void gensqrt_d()
 void genabs_d()
 {
 #ifdef INTERPRET_ABS_D
-    gencallinterp((uint32_t)ABS_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(ABS_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -160,7 +160,7 @@ void genmov_d()
 void genneg_d()
 {
 #ifdef INTERPRET_NEG_D
-    gencallinterp((uint32_t)NEG_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(NEG_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -175,7 +175,7 @@ void genneg_d()
 void genround_l_d()
 {
 #ifdef INTERPRET_ROUND_L_D
-    gencallinterp((uint32_t)ROUND_L_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(ROUND_L_D), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&round_mode);
@@ -193,7 +193,7 @@ void genround_l_d()
 void gentrunc_l_d()
 {
 #ifdef INTERPRET_TRUNC_L_D
-    gencallinterp((uint32_t)TRUNC_L_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(TRUNC_L_D), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&trunc_mode);
@@ -211,7 +211,7 @@ void gentrunc_l_d()
 void genceil_l_d()
 {
 #ifdef INTERPRET_CEIL_L_D
-    gencallinterp((uint32_t)CEIL_L_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CEIL_L_D), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&ceil_mode);
@@ -229,7 +229,7 @@ void genceil_l_d()
 void genfloor_l_d()
 {
 #ifdef INTERPRET_FLOOR_L_D
-    gencallinterp((uint32_t)FLOOR_L_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(FLOOR_L_D), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&floor_mode);
@@ -247,7 +247,7 @@ void genfloor_l_d()
 void genround_w_d()
 {
 #ifdef INTERPRET_ROUND_W_D
-    gencallinterp((uint32_t)ROUND_W_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(ROUND_W_D), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&round_mode);
@@ -265,7 +265,7 @@ void genround_w_d()
 void gentrunc_w_d()
 {
 #ifdef INTERPRET_TRUNC_W_D
-    gencallinterp((uint32_t)TRUNC_W_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(TRUNC_W_D), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&trunc_mode);
@@ -283,7 +283,7 @@ void gentrunc_w_d()
 void genceil_w_d()
 {
 #ifdef INTERPRET_CEIL_W_D
-    gencallinterp((uint32_t)CEIL_W_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CEIL_W_D), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&ceil_mode);
@@ -301,7 +301,7 @@ void genceil_w_d()
 void genfloor_w_d()
 {
 #ifdef INTERPRET_FLOOR_W_D
-    gencallinterp((uint32_t)FLOOR_W_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(FLOOR_W_D), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&floor_mode);
@@ -319,7 +319,7 @@ void genfloor_w_d()
 void gencvt_s_d()
 {
 #ifdef INTERPRET_CVT_S_D
-    gencallinterp((uint32_t)CVT_S_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CVT_S_D), 0);
 #else
     gencheck_cop1_unusable();
     if (g_core->cfg->wii_vc_emulation)
@@ -342,7 +342,7 @@ void gencvt_s_d()
 void gencvt_w_d()
 {
 #ifdef INTERPRET_CVT_W_D
-    gencallinterp((uint32_t)CVT_W_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CVT_W_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -358,7 +358,7 @@ void gencvt_w_d()
 void gencvt_l_d()
 {
 #ifdef INTERPRET_CVT_L_D
-    gencallinterp((uint32_t)CVT_L_D, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CVT_L_D), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_double[dst->f.cf.fs]));
@@ -79,8 +79,8 @@ void gencheck_float_output_valid()
     jp_rj(0); // if unordered (i.e. x is nan), goto FAIL
     uint32_t jump2 = code_length;
 
-    // Replace the (denormal or zero) result by zero (see CHECK_OUTPUT in
-    // cop1_helpers.h for reasoning)
+    // Replace the (denormal or zero) result by zero (see
+    // check_float_result_precise in cop1_helpers.h for reasoning)
 
     fldz();           // push zero
     fucomip_fpreg(1); // compare ST(0) <=> ST(1), pop
@@ -122,7 +122,7 @@ void gencheck_float_output_valid()
  */
 void gencheck_float_conversion_valid()
 {
-    if (!g_core->cfg->float_exception_emulation) return;
+    if (!g_float_exception_emulation) return;
 
     fstsw_ax();
     test_al_imm8(1); // Invalid Operation bit
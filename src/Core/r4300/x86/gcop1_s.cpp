@@ -13,7 +13,7 @@
 
 static void gencheck_eax_valid(int32_t stackBase)
 {
-    if (!g_core->cfg->float_exception_emulation) return;
+    if (!g_float_exception_emulation) return;
 
     mov_reg32_imm32(EBX, (uint32_t)&largest_denormal_float);
     fld_preg32_dword(EBX);
@@ -23,7 +23,7 @@ static void gencheck_eax_valid(int32_t stackBase)
 
 static void gencheck_result_valid()
 {
-    if (!g_core->cfg->float_exception_emulation) return;
+    if (!g_float_exception_emulation) return;
 
     mov_reg32_imm32(EBX, (uint32_t)&largest_denormal_float);
     fld_preg32_dword(EBX);
@@ -33,7 +33,7 @@ static void gencheck_result_valid()
 void genadd_s()
 {
 #ifdef INTERPRET_ADD_S
-    gencallinterp((uint32_t)ADD_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(ADD_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -51,7 +51,7 @@ void genadd_s()
 void gensub_s()
 {
 #ifdef INTERPRET_SUB_S
-    gencallinterp((uint32_t)SUB_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(SUB_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -69,7 +69,7 @@ void gensub_s()
 void genmul_s()
 {
 #ifdef INTERPRET_MUL_S
-    gencallinterp((uint32_t)MUL_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(MUL_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -87,7 +87,7 @@ void genmul_s()
 void gendiv_s()
 {
 #ifdef INTERPRET_DIV_S
-    gencallinterp((uint32_t)DIV_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(DIV_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -105,7 +105,7 @@ void gendiv_s()
 void gensqrt_s()
 {
 #ifdef INTERPRET_SQRT_S
-    gencallinterp((uint32_t)SQRT_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(SQRT_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -121,7 +121,7 @@ void gensqrt_s()
 void genabs_s()
 {
 #ifdef INTERPRET_ABS_S
-    gencallinterp((uint32_t)ABS_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(ABS_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -149,7 +149,7 @@ void genmov_s()
 void genneg_s()
 {
 #ifdef INTERPRET_NEG_S
-    gencallinterp((uint32_t)NEG_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(NEG_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -165,7 +165,7 @@ void genneg_s()
 void genround_l_s()
 {
 #ifdef INTERPRET_ROUND_L_S
-    gencallinterp((uint32_t)ROUND_L_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(ROUND_L_S), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&round_mode);
@@ -183,7 +183,7 @@ void genround_l_s()
 void gentrunc_l_s()
 {
 #ifdef INTERPRET_TRUNC_L_S
-    gencallinterp((uint32_t)TRUNC_L_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(TRUNC_L_S), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&trunc_mode);
@@ -201,7 +201,7 @@ void gentrunc_l_s()
 void genceil_l_s()
 {
 #ifdef INTERPRET_CEIL_L_S
-    gencallinterp((uint32_t)CEIL_L_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CEIL_L_S), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&ceil_mode);
@@ -219,7 +219,7 @@ void genceil_l_s()
 void genfloor_l_s()
 {
 #ifdef INTERPRET_FLOOR_L_S
-    gencallinterp((uint32_t)FLOOR_L_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(FLOOR_L_S), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&floor_mode);
@@ -237,7 +237,7 @@ void genfloor_l_s()
 void genround_w_s()
 {
 #ifdef INTERPRET_ROUND_W_S
-    gencallinterp((uint32_t)ROUND_W_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(ROUND_W_S), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&round_mode);
@@ -255,7 +255,7 @@ void genround_w_s()
 void gentrunc_w_s()
 {
 #ifdef INTERPRET_TRUNC_W_S
-    gencallinterp((uint32_t)TRUNC_W_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(TRUNC_W_S), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&trunc_mode);
@@ -273,7 +273,7 @@ void gentrunc_w_s()
 void genceil_w_s()
 {
 #ifdef INTERPRET_CEIL_W_S
-    gencallinterp((uint32_t)CEIL_W_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CEIL_W_S), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&ceil_mode);
@@ -291,7 +291,7 @@ void genceil_w_s()
 void genfloor_w_s()
 {
 #ifdef INTERPRET_FLOOR_W_S
-    gencallinterp((uint32_t)FLOOR_W_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(FLOOR_W_S), 0);
 #else
     gencheck_cop1_unusable();
     fldcw_m16((uint16_t *)&floor_mode);
@@ -309,7 +309,7 @@ void genfloor_w_s()
 void gencvt_d_s()
 {
 #ifdef INTERPRET_CVT_D_S
-    gencallinterp((uint32_t)CVT_D_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CVT_D_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -323,7 +323,7 @@ void gencvt_d_s()
 void gencvt_w_s()
 {
 #ifdef INTERPRET_CVT_W_S
-    gencallinterp((uint32_t)CVT_W_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CVT_W_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
@@ -339,7 +339,7 @@ void gencvt_w_s()
 void gencvt_l_s()
 {
 #ifdef INTERPRET_CVT_L_S
-    gencallinterp((uint32_t)CVT_L_S, 0);
+    gencallinterp((uint32_t)FLOAT_OP(CVT_L_S), 0);
 #else
     gencheck_cop1_unusable();
     mov_eax_memoffs32((uint32_t *)(&reg_cop1_simple[dst->f.cf.fs]));
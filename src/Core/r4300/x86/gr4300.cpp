@@ -14,6 +14,7 @@
 #include <r4300/recomph.h>
 #include <r4300/x86/assemble.h>
 #include <r4300/x86/regcache.h>
+#include <alloc.h>
 
 extern uint32_t src; // recomp.c
 
@@ -150,6 +151,31 @@ void gencheck_interrupt_reg() // addr is in EAX
     call_reg32(EAX);                                           // 2
 }
 
+/**
+ * \brief Emits a jump to a known address outside the block. Jumps into KSEG0 and KSEG1, whose blocks don't move, get
+ * an exit stub which <c>dyna_link_jump</c> patches into a direct jump once the target is compiled.
+ */
+static void genlink_out(uint32_t addr)
+{
+    if (addr < 0x80000000 || addr >= 0xC0000000)
+    {
+        mov_m32_imm32(&jump_to_address, addr);
+        mov_m32_imm32((uint32_t *)(&PC), (uint32_t)(dst + 1));
+        mov_reg32_imm32(EAX, (uint32_t)jump_to_func);
+        call_reg32(EAX);
+        return;
+    }
+
+    // Room for the link, skipped until it's filled in
+    jmp_imm_short(LINK_BODY_SIZE);
+    for (int32_t i = 0; i < LINK_BODY_SIZE; i++) nop();
+
+    mov_m32_imm32(&jump_to_address, addr);                 // 10
+    mov_m32_imm32((uint32_t *)(&PC), (uint32_t)(dst + 1)); // 10
+    mov_reg32_imm32(EAX, (uint32_t)dyna_link_jump);        // 5
+    call_reg32(EAX);                                       // 2
+}
+
 void gennop()
 {
 }
@@ -196,10 +222,7 @@ void genj_out()
 
     mov_m32_imm32((void *)(&last_addr), naddr);
     gencheck_interrupt_out(naddr);
-    mov_m32_imm32(&jump_to_address, naddr);
-    mov_m32_imm32((uint32_t *)(&PC), (uint32_t)(dst + 1));
-    mov_reg32_imm32(EAX, (uint32_t)jump_to_func);
-    call_reg32(EAX);
+    genlink_out(naddr);
 #endif
 }
 
@@ -283,10 +306,7 @@ void genjal_out()
 
     mov_m32_imm32((void *)(&last_addr), naddr);
     gencheck_interrupt_out(naddr);
-    mov_m32_imm32(&jump_to_address, naddr);
-    mov_m32_imm32((uint32_t *)(&PC), (uint32_t)(dst + 1));
-    mov_reg32_imm32(EAX, (uint32_t)jump_to_func);
-    call_reg32(EAX);
+    genlink_out(naddr);
 #endif
 }
 
@@ -430,10 +450,7 @@ void gentest_out()
     temp = code_length;
     mov_m32_imm32((void *)(&last_addr), dst->addr + (dst - 1)->f.i.immediate * 4);
     gencheck_interrupt_out(dst->addr + (dst - 1)->f.i.immediate * 4);
-    mov_m32_imm32(&jump_to_address, dst->addr + (dst - 1)->f.i.immediate * 4);
-    mov_m32_imm32((uint32_t *)(&PC), (uint32_t)(dst + 1));
-    mov_reg32_imm32(EAX, (uint32_t)jump_to_func);
-    call_reg32(EAX);
+    genlink_out(dst->addr + (dst - 1)->f.i.immediate * 4);
 
     temp2 = code_length;
     code_length = temp - 4;
@@ -819,6 +836,12 @@ void genbgtz_idle()
 #endif
 }
 
+void genidle_loop()
+{
+    // Idle loops spend most of their time skipped rather than executed, so the interpreter's branch is fast enough.
+    gencallinterp((uint32_t)dst->ops, 1);
+}
+
 void genaddi()
 {
 #ifdef INTERPRET_ADDI
@@ -943,6 +966,13 @@ void genlui()
 #endif
 }
 
+void genli(uint32_t gpr, int32_t value)
+{
+    int32_t rt = allocate_register_w((uint32_t *)(reg + gpr));
+
+    mov_reg32_imm32(rt, value);
+}
+
 void gentestl()
 {
     uint32_t temp, temp2;
@@ -993,10 +1023,7 @@ void gentestl_out()
     gendelayslot();
     mov_m32_imm32((void *)(&last_addr), dst->addr + (dst - 1)->f.i.immediate * 4);
     gencheck_interrupt_out(dst->addr + (dst - 1)->f.i.immediate * 4);
-    mov_m32_imm32(&jump_to_address, dst->addr + (dst - 1)->f.i.immediate * 4);
-    mov_m32_imm32((uint32_t *)(&PC), (uint32_t)(dst + 1));
-    mov_reg32_imm32(EAX, (uint32_t)jump_to_func);
-    call_reg32(EAX);
+    genlink_out(dst->addr + (dst - 1)->f.i.immediate * 4);
 
     temp2 = code_length;
     code_length = temp - 4;
@@ -1250,11 +1277,77 @@ void genldr()
     gencallinterp((uint32_t)LDR, 0);
 }
 
+/**
+ * \brief Gets the address accessed by the load or store being recompiled, if its base register is known. Code relying
+ * on the address must call <c>use_known_gpr</c> on the base register.
+ */
+static bool get_known_address(uint32_t *addr)
+{
+    int32_t base;
+    if (!get_known_gpr(dst->f.i.rs, &base)) return false;
+
+    *addr = (uint32_t)base + (int32_t)dst->f.i.immediate;
+    return true;
+}
+
+/**
+ * \brief Gets whether an address is accessed directly in RDRAM, bypassing the memory handlers.
+ */
+static bool is_fast_rdram(uint32_t addr)
+{
+    return fast_memory && (addr & 0xDF800000) == 0x80000000;
+}
+
+/**
+ * \brief Emits a call to a known address' read handler, which reads into the destination of the load being
+ * recompiled.
+ */
+static void genread_known(uint32_t addr, void (**handlers)())
+{
+    free_all_registers();
+    simplify_access();
+    mov_m32_imm32((void *)(&PC), (uint32_t)(dst + 1));
+    mov_m32_imm32((uint32_t *)(&address), addr);
+    mov_m32_imm32((uint32_t *)(&rdword), (uint32_t)dst->f.i.rt);
+    mov_reg32_m32(EBX, &handlers[addr >> 16]);
+    call_reg32(EBX);
+}
+
+/**
+ * \brief Emits the invalidation of the compiled code at a known address written in RDRAM, like the generic stores.
+ */
+static void geninvalidate_known(uint32_t addr)
+{
+    cmp_m8_imm8((unsigned char *)&invalid_code[addr >> 12], 0);        // 7
+    jne_rj(19);                                                        // 2
+    test_m32_imm32(&code_lines[addr >> 11], 1 << ((addr >> 6) & 31)); // 10
+    je_rj(7);                                                          // 2
+    mov_m8_imm8((unsigned char *)&invalid_code[addr >> 12], 1);        // 7
+}
+
 void genlb()
 {
 #ifdef INTERPRET_LB
     gencallinterp((uint32_t)LB, 0);
 #else
+    uint32_t addr;
+    if (get_known_address(&addr))
+    {
+        use_known_gpr(dst->f.i.rs);
+        if (is_fast_rdram(addr))
+        {
+            int32_t rt = allocate_register_w((uint32_t *)dst->f.i.rt);
+            movsx_reg32_m8(rt, (unsigned char *)rdram + ((addr & 0x7FFFFF) ^ 3));
+        }
+        else
+        {
+            genread_known(addr, readmemb);
+            movsx_reg32_m8(EAX, (unsigned char *)dst->f.i.rt);
+            set_register_state(EAX, (uint32_t *)dst->f.i.rt, 1);
+        }
+        return;
+    }
+
     free_all_registers();
     simplify_access();
     mov_eax_memoffs32((uint32_t *)dst->f.i.rs);
@@ -1295,6 +1388,24 @@ void genlh()
 #ifdef INTERPRET_LH
     gencallinterp((uint32_t)LH, 0);
 #else
+    uint32_t addr;
+    if (get_known_address(&addr))
+    {
+        use_known_gpr(dst->f.i.rs);
+        if (is_fast_rdram(addr))
+        {
+            int32_t rt = allocate_register_w((uint32_t *)dst->f.i.rt);
+            movsx_reg32_m16(rt, (uint16_t *)((unsigned char *)rdram + ((addr & 0x7FFFFF) ^ 2)));
+        }
+        else
+        {
+            genread_known(addr, readmemh);
+            movsx_reg32_m16(EAX, (uint16_t *)dst->f.i.rt);
+            set_register_state(EAX, (uint32_t *)dst->f.i.rt, 1);
+        }
+        return;
+    }
+
     free_all_registers();
     simplify_access();
     mov_eax_memoffs32((uint32_t *)dst->f.i.rs);
@@ -1340,6 +1451,24 @@ void genlw()
 #ifdef INTERPRET_LW
     gencallinterp((uint32_t)LW, 0);
 #else
+    uint32_t addr;
+    if (get_known_address(&addr))
+    {
+        use_known_gpr(dst->f.i.rs);
+        if (is_fast_rdram(addr))
+        {
+            int32_t rt = allocate_register_w((uint32_t *)dst->f.i.rt);
+            mov_reg32_m32(rt, (unsigned char *)rdram + (addr & 0x7FFFFF));
+        }
+        else
+        {
+            genread_known(addr, readmem);
+            mov_eax_memoffs32((uint32_t *)(dst->f.i.rt));
+            set_register_state(EAX, (uint32_t *)dst->f.i.rt, 1);
+        }
+        return;
+    }
+
     free_all_registers();
     simplify_access();
     mov_eax_memoffs32((uint32_t *)dst->f.i.rs);
@@ -1379,6 +1508,26 @@ void genlbu()
 #ifdef INTERPRET_LBU
     gencallinterp((uint32_t)LBU, 0);
 #else
+    uint32_t addr;
+    if (get_known_address(&addr))
+    {
+        use_known_gpr(dst->f.i.rs);
+        if (is_fast_rdram(addr))
+        {
+            int32_t rt = allocate_register_w((uint32_t *)dst->f.i.rt);
+            mov_reg32_m32(rt, (unsigned char *)rdram + ((addr & 0x7FFFFF) ^ 3));
+            and_reg32_imm32(rt, 0xFF);
+        }
+        else
+        {
+            genread_known(addr, readmemb);
+            mov_reg32_m32(EAX, (uint32_t *)dst->f.i.rt);
+            and_eax_imm32(0xFF);
+            set_register_state(EAX, (uint32_t *)dst->f.i.rt, 1);
+        }
+        return;
+    }
+
     free_all_registers();
     simplify_access();
     mov_eax_memoffs32((uint32_t *)dst->f.i.rs);
@@ -1421,6 +1570,26 @@ void genlhu()
 #ifdef INTERPRET_LHU
     gencallinterp((uint32_t)LHU, 0);
 #else
+    uint32_t addr;
+    if (get_known_address(&addr))
+    {
+        use_known_gpr(dst->f.i.rs);
+        if (is_fast_rdram(addr))
+        {
+            int32_t rt = allocate_register_w((uint32_t *)dst->f.i.rt);
+            mov_reg32_m32(rt, (unsigned char *)rdram + ((addr & 0x7FFFFF) ^ 2));
+            and_reg32_imm32(rt, 0xFFFF);
+        }
+        else
+        {
+            genread_known(addr, readmemh);
+            mov_reg32_m32(EAX, (uint32_t *)dst->f.i.rt);
+            and_eax_imm32(0xFFFF);
+            set_register_state(EAX, (uint32_t *)dst->f.i.rt, 1);
+        }
+        return;
+    }
+
     free_all_registers();
     simplify_access();
     mov_eax_memoffs32((uint32_t *)dst->f.i.rs);
@@ -1509,6 +1678,16 @@ void gensb()
 #ifdef INTERPRET_SB
     gencallinterp((uint32_t)SB, 0);
 #else
+    uint32_t addr;
+    if (get_known_address(&addr) && is_fast_rdram(addr))
+    {
+        use_known_gpr(dst->f.i.rs);
+        allocate_register_manually(ECX, (uint32_t *)dst->f.i.rt);
+        mov_m8_reg8((unsigned char *)rdram + ((addr & 0x7FFFFF) ^ 3), CL);
+        geninvalidate_known(addr);
+        return;
+    }
+
     free_all_registers();
     simplify_access();
     mov_reg8_m8(CL, (unsigned char *)dst->f.i.rt);
@@ -1545,19 +1724,17 @@ void gensb()
     mov_reg32_reg32(EBX, EAX);
     shr_reg32_imm8(EBX, 12);
     cmp_preg32pimm32_imm8(EBX, (uint32_t)invalid_code, 0);
-    jne_rj(54);
-    mov_reg32_reg32(ECX, EBX);                                                      // 2
-    shl_reg32_imm8(EBX, 2);                                                         // 3
-    mov_reg32_preg32pimm32(EBX, EBX, (uint32_t)blocks);                             // 6
-    mov_reg32_preg32pimm32(EBX, EBX, (int32_t)&actual->block - (int32_t)actual);    // 6
-    and_eax_imm32(0xFFF);                                                           // 5
-    shr_reg32_imm8(EAX, 2);                                                         // 3
-    mov_reg32_imm32(EDX, sizeof(precomp_instr));                                    // 5
-    mul_reg32(EDX);                                                                 // 2
-    mov_reg32_preg32preg32pimm32(EAX, EAX, EBX, (int32_t)&dst->ops - (int32_t)dst); // 7
-    cmp_reg32_imm32(EAX, (uint32_t)NOTCOMPILED);                                    // 6
-    je_rj(7);                                                                       // 2
-    mov_preg32pimm32_imm8(ECX, (uint32_t)invalid_code, 1);                          // 7
+    jne_rj(36);
+    mov_reg32_reg32(EDX, EBX);                                // 2
+    mov_reg32_reg32(EBX, EAX);                                // 2
+    shr_reg32_imm8(EBX, 11);                                  // 3
+    mov_reg32_preg32x4pimm32(EBX, EBX, (uint32_t)code_lines); // 7
+    mov_reg32_reg32(ECX, EAX);                                // 2
+    shr_reg32_imm8(ECX, 6);                                   // 3
+    shr_reg32_cl(EBX);                                        // 2
+    test_reg32_imm32(EBX, 1);                                 // 6
+    je_rj(7);                                                 // 2
+    mov_preg32pimm32_imm8(EDX, (uint32_t)invalid_code, 1);    // 7
 #endif
 }
 
@@ -1566,6 +1743,16 @@ void gensh()
 #ifdef INTERPRET_SH
     gencallinterp((uint32_t)SH, 0);
 #else
+    uint32_t addr;
+    if (get_known_address(&addr) && is_fast_rdram(addr))
+    {
+        use_known_gpr(dst->f.i.rs);
+        int32_t rt = allocate_register((uint32_t *)dst->f.i.rt);
+        mov_m16_reg16((uint16_t *)((unsigned char *)rdram + ((addr & 0x7FFFFF) ^ 2)), rt);
+        geninvalidate_known(addr);
+        return;
+    }
+
     free_all_registers();
     simplify_access();
     mov_reg16_m16(CX, (uint16_t *)dst->f.i.rt);
@@ -1602,19 +1789,17 @@ void gensh()
     mov_reg32_reg32(EBX, EAX);
     shr_reg32_imm8(EBX, 12);
     cmp_preg32pimm32_imm8(EBX, (uint32_t)invalid_code, 0);
-    jne_rj(54);
-    mov_reg32_reg32(ECX, EBX);                                                      // 2
-    shl_reg32_imm8(EBX, 2);                                                         // 3
-    mov_reg32_preg32pimm32(EBX, EBX, (uint32_t)blocks);                             // 6
-    mov_reg32_preg32pimm32(EBX, EBX, (int32_t)&actual->block - (int32_t)actual);    // 6
-    and_eax_imm32(0xFFF);                                                           // 5
-    shr_reg32_imm8(EAX, 2);                                                         // 3
-    mov_reg32_imm32(EDX, sizeof(precomp_instr));                                    // 5
-    mul_reg32(EDX);                                                                 // 2
-    mov_reg32_preg32preg32pimm32(EAX, EAX, EBX, (int32_t)&dst->ops - (int32_t)dst); // 7
-    cmp_reg32_imm32(EAX, (uint32_t)NOTCOMPILED);                                    // 6
-    je_rj(7);                                                                       // 2
-    mov_preg32pimm32_imm8(ECX, (uint32_t)invalid_code, 1);                          // 7
+    jne_rj(36);
+    mov_reg32_reg32(EDX, EBX);                                // 2
+    mov_reg32_reg32(EBX, EAX);                                // 2
+    shr_reg32_imm8(EBX, 11);                                  // 3
+    mov_reg32_preg32x4pimm32(EBX, EBX, (uint32_t)code_lines); // 7
+    mov_reg32_reg32(ECX, EAX);                                // 2
+    shr_reg32_imm8(ECX, 6);                                   // 3
+    shr_reg32_cl(EBX);                                        // 2
+    test_reg32_imm32(EBX, 1);                                 // 6
+    je_rj(7);                                                 // 2
+    mov_preg32pimm32_imm8(EDX, (uint32_t)invalid_code, 1);    // 7
 #endif
 }
 
@@ -1628,6 +1813,16 @@ void gensw()
 #ifdef INTERPRET_SW
     gencallinterp((uint32_t)SW, 0);
 #else
+    uint32_t addr;
+    if (get_known_address(&addr) && is_fast_rdram(addr))
+    {
+        use_known_gpr(dst->f.i.rs);
+        int32_t rt = allocate_register((uint32_t *)dst->f.i.rt);
+        mov_m32_reg32((uint32_t *)((unsigned char *)rdram + (addr & 0x7FFFFF)), rt);
+        geninvalidate_known(addr);
+        return;
+    }
+
     free_all_registers();
     simplify_access();
     mov_reg32_m32(ECX, (uint32_t *)dst->f.i.rt);
@@ -1663,19 +1858,17 @@ void gensw()
     mov_reg32_reg32(EBX, EAX);
     shr_reg32_imm8(EBX, 12);
     cmp_preg32pimm32_imm8(EBX, (uint32_t)invalid_code, 0);
-    jne_rj(54);
-    mov_reg32_reg32(ECX, EBX);                                                      // 2
-    shl_reg32_imm8(EBX, 2);                                                         // 3
-    mov_reg32_preg32pimm32(EBX, EBX, (uint32_t)blocks);                             // 6
-    mov_reg32_preg32pimm32(EBX, EBX, (int32_t)&actual->block - (int32_t)actual);    // 6
-    and_eax_imm32(0xFFF);                                                           // 5
-    shr_reg32_imm8(EAX, 2);                                                         // 3
-    mov_reg32_imm32(EDX, sizeof(precomp_instr));                                    // 5
-    mul_reg32(EDX);                                                                 // 2
-    mov_reg32_preg32preg32pimm32(EAX, EAX, EBX, (int32_t)&dst->ops - (int32_t)dst); // 7
-    cmp_reg32_imm32(EAX, (uint32_t)NOTCOMPILED);                                    // 6
-    je_rj(7);                                                                       // 2
-    mov_preg32pimm32_imm8(ECX, (uint32_t)invalid_code, 1);                          // 7
+    jne_rj(36);
+    mov_reg32_reg32(EDX, EBX);                                // 2
+    mov_reg32_reg32(EBX, EAX);                                // 2
+    shr_reg32_imm8(EBX, 11);                                  // 3
+    mov_reg32_preg32x4pimm32(EBX, EBX, (uint32_t)code_lines); // 7
+    mov_reg32_reg32(ECX, EAX);                                // 2
+    shr_reg32_imm8(ECX, 6);                                   // 3
+    shr_reg32_cl(EBX);                                        // 2
+    test_reg32_imm32(EBX, 1);                                 // 6
+    je_rj(7);                                                 // 2
+    mov_preg32pimm32_imm8(EDX, (uint32_t)invalid_code, 1);    // 7
 #endif
 }
 
@@ -1694,8 +1887,6 @@ void genswr()
     gencallinterp((uint32_t)SWR, 0);
 }
 
-#include <malloc.h>
-
 inline void put8gr(unsigned char octet)
 {
     (*inst_pointer)[code_length] = octet;
@@ -1703,7 +1894,7 @@ inline void put8gr(unsigned char octet)
     if (code_length == max_code_length)
     {
         max_code_length += JUMP_TABLE_SIZE;
-        *inst_pointer = (unsigned char *)realloc(*inst_pointer, max_code_length);
+        *inst_pointer = (unsigned char *)realloc_exec(*inst_pointer, code_length, max_code_length);
     }
 }
 
@@ -1890,19 +2081,17 @@ void genswc1()
     mov_reg32_reg32(EBX, EAX);
     shr_reg32_imm8(EBX, 12);
     cmp_preg32pimm32_imm8(EBX, (uint32_t)invalid_code, 0);
-    jne_rj(54);
-    mov_reg32_reg32(ECX, EBX);                                                      // 2
-    shl_reg32_imm8(EBX, 2);                                                         // 3
-    mov_reg32_preg32pimm32(EBX, EBX, (uint32_t)blocks);                             // 6
-    mov_reg32_preg32pimm32(EBX, EBX, (int32_t)&actual->block - (int32_t)actual);    // 6
-    and_eax_imm32(0xFFF);                                                           // 5
-    shr_reg32_imm8(EAX, 2);                                                         // 3
-    mov_reg32_imm32(EDX, sizeof(precomp_instr));                                    // 5
-    mul_reg32(EDX);                                                                 // 2
-    mov_reg32_preg32preg32pimm32(EAX, EAX, EBX, (int32_t)&dst->ops - (int32_t)dst); // 7
-    cmp_reg32_imm32(EAX, (uint32_t)NOTCOMPILED);                                    // 6
-    je_rj(7);                                                                       // 2
-    mov_preg32pimm32_imm8(ECX, (uint32_t)invalid_code, 1);                          // 7
+    jne_rj(36);
+    mov_reg32_reg32(EDX, EBX);                                // 2
+    mov_reg32_reg32(EBX, EAX);                                // 2
+    shr_reg32_imm8(EBX, 11);                                  // 3
+    mov_reg32_preg32x4pimm32(EBX, EBX, (uint32_t)code_lines); // 7
+    mov_reg32_reg32(ECX, EAX);                                // 2
+    shr_reg32_imm8(ECX, 6);                                   // 3
+    shr_reg32_cl(EBX);                                        // 2
+    test_reg32_imm32(EBX, 1);                                 // 6
+    je_rj(7);                                                 // 2
+    mov_preg32pimm32_imm8(EDX, (uint32_t)invalid_code, 1);    // 7
 #endif
 }
 
@@ -1950,19 +2139,17 @@ void gensdc1()
     mov_reg32_reg32(EBX, EAX);
     shr_reg32_imm8(EBX, 12);
     cmp_preg32pimm32_imm8(EBX, (uint32_t)invalid_code, 0);
-    jne_rj(54);
-    mov_reg32_reg32(ECX, EBX);                                                      // 2
-    shl_reg32_imm8(EBX, 2);                                                         // 3
-    mov_reg32_preg32pimm32(EBX, EBX, (uint32_t)blocks);                             // 6
-    mov_reg32_preg32pimm32(EBX, EBX, (int32_t)&actual->block - (int32_t)actual);    // 6
-    and_eax_imm32(0xFFF);                                                           // 5
-    shr_reg32_imm8(EAX, 2);                                                         // 3
-    mov_reg32_imm32(EDX, sizeof(precomp_instr));                                    // 5
-    mul_reg32(EDX);                                                                 // 2
-    mov_reg32_preg32preg32pimm32(EAX, EAX, EBX, (int32_t)&dst->ops - (int32_t)dst); // 7
-    cmp_reg32_imm32(EAX, (uint32_t)NOTCOMPILED);                                    // 6
-    je_rj(7);                                                                       // 2
-    mov_preg32pimm32_imm8(ECX, (uint32_t)invalid_code, 1);                          // 7
+    jne_rj(36);
+    mov_reg32_reg32(EDX, EBX);                                // 2
+    mov_reg32_reg32(EBX, EAX);                                // 2
+    shr_reg32_imm8(EBX, 11);                                  // 3
+    mov_reg32_preg32x4pimm32(EBX, EBX, (uint32_t)code_lines); // 7
+    mov_reg32_reg32(ECX, EAX);                                // 2
+    shr_reg32_imm8(ECX, 6);                                   // 3
+    shr_reg32_cl(EBX);                                        // 2
+    test_reg32_imm32(EBX, 1);                                 // 6
+    je_rj(7);                                                 // 2
+    mov_preg32pimm32_imm8(EDX, (uint32_t)invalid_code, 1);    // 7
 #endif
 }
 
@@ -2010,19 +2197,17 @@ void gensd()
     mov_reg32_reg32(EBX, EAX);
     shr_reg32_imm8(EBX, 12);
     cmp_preg32pimm32_imm8(EBX, (uint32_t)invalid_code, 0);
-    jne_rj(54);
-    mov_reg32_reg32(ECX, EBX);                                                      // 2
-    shl_reg32_imm8(EBX, 2);                                                         // 3
-    mov_reg32_preg32pimm32(EBX, EBX, (uint32_t)blocks);                             // 6
-    mov_reg32_preg32pimm32(EBX, EBX, (int32_t)&actual->block - (int32_t)actual);    // 6
-    and_eax_imm32(0xFFF);                                                           // 5
-    shr_reg32_imm8(EAX, 2);                                                         // 3
-    mov_reg32_imm32(EDX, sizeof(precomp_instr));                                    // 5
-    mul_reg32(EDX);                                                                 // 2
-    mov_reg32_preg32preg32pimm32(EAX, EAX, EBX, (int32_t)&dst->ops - (int32_t)dst); // 7
-    cmp_reg32_imm32(EAX, (uint32_t)NOTCOMPILED);                                    // 6
-    je_rj(7);                                                                       // 2
-    mov_preg32pimm32_imm8(ECX, (uint32_t)invalid_code, 1);                          // 7
+    jne_rj(36);
+    mov_reg32_reg32(EDX, EBX);                                // 2
+    mov_reg32_reg32(EBX, EAX);                                // 2
+    shr_reg32_imm8(EBX, 11);                                  // 3
+    mov_reg32_preg32x4pimm32(EBX, EBX, (uint32_t)code_lines); // 7
+    mov_reg32_reg32(ECX, EAX);                                // 2
+    shr_reg32_imm8(ECX, 6);                                   // 3
+    shr_reg32_cl(EBX);                                        // 2
+    test_reg32_imm32(EBX, 1);                                 // 6
+    je_rj(7);                                                 // 2
+    mov_preg32pimm32_imm8(EDX, (uint32_t)invalid_code, 1);    // 7
 #endif
 }
 
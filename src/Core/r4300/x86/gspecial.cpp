@@ -140,10 +140,10 @@ void genjr()
 #ifdef INTERPRET_JR
     gencallinterp((uint32_t)JR, 1);
 #else
-    static uint32_t precomp_instr_size = sizeof(precomp_instr);
-    uint32_t diff = (uint32_t)(&dst->local_addr) - (uint32_t)(dst);
-    uint32_t diff_need = (uint32_t)(&dst->reg_cache_infos.need_map) - (uint32_t)(dst);
-    uint32_t diff_wrap = (uint32_t)(&dst->reg_cache_infos.jump_wrapper) - (uint32_t)(dst);
+    static uint32_t dyna_instr_size = sizeof(dyna_instr);
+    uint32_t diff = offsetof(dyna_instr, local_addr);
+    uint32_t diff_need = offsetof(dyna_instr, reg_cache_infos.need_map);
+    uint32_t diff_wrap = offsetof(dyna_instr, reg_cache_infos.jump_wrapper);
     uint32_t temp, temp2;
 
     if (((dst->addr & 0xFFF) == 0xFFC && (dst->addr < 0x80000000 || dst->addr >= 0xC0000000)) ||
@@ -185,16 +185,16 @@ void genjr()
     mov_reg32_reg32(EAX, EBX);
     sub_eax_imm32(dst_block->start);
     shr_reg32_imm8(EAX, 2);
-    mul_m32((uint32_t *)(&precomp_instr_size));
+    mul_m32((uint32_t *)(&dyna_instr_size));
 
-    mov_reg32_preg32pimm32(EBX, EAX, (uint32_t)(dst_block->block) + diff_need);
+    mov_reg32_preg32pimm32(EBX, EAX, (uint32_t)(dst_block->dyna) + diff_need);
     cmp_reg32_imm32(EBX, 1);
     jne_rj(7);
 
-    add_eax_imm32((uint32_t)(dst_block->block) + diff_wrap); // 5
+    add_eax_imm32((uint32_t)(dst_block->dyna) + diff_wrap); // 5
     jmp_reg32(EAX);                                          // 2
 
-    mov_reg32_preg32pimm32(EAX, EAX, (uint32_t)(dst_block->block) + diff);
+    mov_reg32_preg32pimm32(EAX, EAX, (uint32_t)(dst_block->dyna) + diff);
     add_reg32_m32(EAX, (uint32_t *)(&dst_block->code));
 
     jmp_reg32(EAX);
@@ -206,10 +206,10 @@ void genjalr()
 #ifdef INTERPRET_JALR
     gencallinterp((uint32_t)JALR, 0);
 #else
-    static uint32_t precomp_instr_size = sizeof(precomp_instr);
-    uint32_t diff = (uint32_t)(&dst->local_addr) - (uint32_t)(dst);
-    uint32_t diff_need = (uint32_t)(&dst->reg_cache_infos.need_map) - (uint32_t)(dst);
-    uint32_t diff_wrap = (uint32_t)(&dst->reg_cache_infos.jump_wrapper) - (uint32_t)(dst);
+    static uint32_t dyna_instr_size = sizeof(dyna_instr);
+    uint32_t diff = offsetof(dyna_instr, local_addr);
+    uint32_t diff_need = offsetof(dyna_instr, reg_cache_infos.need_map);
+    uint32_t diff_wrap = offsetof(dyna_instr, reg_cache_infos.jump_wrapper);
     uint32_t temp, temp2;
 
     if (((dst->addr & 0xFFF) == 0xFFC && (dst->addr < 0x80000000 || dst->addr >= 0xC0000000)) ||
@@ -257,16 +257,16 @@ void genjalr()
     mov_reg32_reg32(EAX, EBX);
     sub_eax_imm32(dst_block->start);
     shr_reg32_imm8(EAX, 2);
-    mul_m32((uint32_t *)(&precomp_instr_size));
+    mul_m32((uint32_t *)(&dyna_instr_size));
 
-    mov_reg32_preg32pimm32(EBX, EAX, (uint32_t)(dst_block->block) + diff_need);
+    mov_reg32_preg32pimm32(EBX, EAX, (uint32_t)(dst_block->dyna) + diff_need);
     cmp_reg32_imm32(EBX, 1);
     jne_rj(7);
 
-    add_eax_imm32((uint32_t)(dst_block->block) + diff_wrap); // 5
+    add_eax_imm32((uint32_t)(dst_block->dyna) + diff_wrap); // 5
     jmp_reg32(EAX);                                          // 2
 
-    mov_reg32_preg32pimm32(EAX, EAX, (uint32_t)(dst_block->block) + diff);
+    mov_reg32_preg32pimm32(EAX, EAX, (uint32_t)(dst_block->dyna) + diff);
     add_reg32_m32(EAX, (uint32_t *)(&dst_block->code));
 
     jmp_reg32(EAX);
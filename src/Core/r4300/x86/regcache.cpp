@@ -6,10 +6,12 @@
 
 #include "stdafx.h"
 #include "regcache.h"
+#include <r4300/ops.h>
 #include <r4300/r4300.h>
 #include <r4300/recomp.h>
 #include <r4300/recomph.h>
 
+static precomp_block *cache_block;
 static uint32_t *reg_content[8];
 static precomp_instr *last_access[8];
 static precomp_instr *free_since[8];
@@ -17,8 +19,17 @@ static int32_t dirty[8];
 static int32_t r64[8];
 static uint32_t *r0;
 
-void init_cache(precomp_instr *start)
+/**
+ * \brief Gets the register cache state recorded for an instruction of the block being compiled.
+ */
+static reg_cache_struct &cache_infos(const precomp_instr *instr)
 {
+    return get_dyna_instr(cache_block, instr)->reg_cache_infos;
+}
+
+void init_cache(precomp_block *block, precomp_instr *start)
+{
+    cache_block = block;
     int32_t i;
     for (i = 0; i < 8; i++)
     {
@@ -39,7 +50,7 @@ void free_all_registers()
         {
             while (free_since[i] <= dst)
             {
-                free_since[i]->reg_cache_infos.needed_registers[i] = NULL;
+                cache_infos(free_since[i]).needed_registers[i] = NULL;
                 free_since[i]++;
             }
         }
@@ -65,16 +76,16 @@ void free_register(int32_t reg)
     while (last <= dst)
     {
         if (last_access[reg] != NULL && dirty[reg])
-            last->reg_cache_infos.needed_registers[reg] = reg_content[reg];
+            cache_infos(last).needed_registers[reg] = reg_content[reg];
         else
-            last->reg_cache_infos.needed_registers[reg] = NULL;
+            cache_infos(last).needed_registers[reg] = NULL;
 
         if (last_access[reg] != NULL && r64[reg] != -1)
         {
             if (dirty[r64[reg]])
-                last->reg_cache_infos.needed_registers[r64[reg]] = reg_content[r64[reg]];
+                cache_infos(last).needed_registers[r64[reg]] = reg_content[r64[reg]];
             else
-                last->reg_cache_infos.needed_registers[r64[reg]] = NULL;
+                cache_infos(last).needed_registers[r64[reg]] = NULL;
         }
 
         last++;
@@ -155,7 +166,7 @@ int32_t allocate_register(uint32_t *addr)
 
                 while (last <= dst)
                 {
-                    last->reg_cache_infos.needed_registers[i] = reg_content[i];
+                    cache_infos(last).needed_registers[i] = reg_content[i];
                     last++;
                 }
                 last_access[i] = dst;
@@ -165,7 +176,7 @@ int32_t allocate_register(uint32_t *addr)
 
                     while (last <= dst)
                     {
-                        last->reg_cache_infos.needed_registers[r64[i]] = reg_content[r64[i]];
+                        cache_infos(last).needed_registers[r64[i]] = reg_content[r64[i]];
                         last++;
                     }
                     last_access[r64[i]] = dst;
@@ -192,7 +203,7 @@ int32_t allocate_register(uint32_t *addr)
     {
         while (free_since[reg] <= dst)
         {
-            free_since[reg]->reg_cache_infos.needed_registers[reg] = NULL;
+            cache_infos(free_since[reg]).needed_registers[reg] = NULL;
             free_since[reg]++;
         }
     }
@@ -323,7 +334,7 @@ int32_t allocate_register_w(uint32_t *addr)
 
             while (last <= dst)
             {
-                last->reg_cache_infos.needed_registers[i] = NULL;
+                cache_infos(last).needed_registers[i] = NULL;
                 last++;
             }
             last_access[i] = dst;
@@ -333,7 +344,7 @@ int32_t allocate_register_w(uint32_t *addr)
                 last = last_access[r64[i]] + 1;
                 while (last <= dst)
                 {
-                    last->reg_cache_infos.needed_registers[r64[i]] = NULL;
+                    cache_infos(last).needed_registers[r64[i]] = NULL;
                     last++;
                 }
                 free_since[r64[i]] = dst + 1;
@@ -361,7 +372,7 @@ int32_t allocate_register_w(uint32_t *addr)
     {
         while (free_since[reg] <= dst)
         {
-            free_since[reg]->reg_cache_infos.needed_registers[reg] = NULL;
+            cache_infos(free_since[reg]).needed_registers[reg] = NULL;
             free_since[reg]++;
         }
     }
@@ -417,7 +428,7 @@ int32_t allocate_64_register1_w(uint32_t *addr)
     {
         while (free_since[reg2] <= dst)
         {
-            free_since[reg2]->reg_cache_infos.needed_registers[reg2] = NULL;
+            cache_infos(free_since[reg2]).needed_registers[reg2] = NULL;
             free_since[reg2]++;
         }
     }
@@ -473,7 +484,7 @@ int32_t allocate_64_register2_w(uint32_t *addr)
     {
         while (free_since[reg2] <= dst)
         {
-            free_since[reg2]->reg_cache_infos.needed_registers[reg2] = NULL;
+            cache_infos(free_since[reg2]).needed_registers[reg2] = NULL;
             free_since[reg2]++;
         }
     }
@@ -527,14 +538,14 @@ void force_32(int32_t reg)
         while (last <= dst)
         {
             if (dirty[reg])
-                last->reg_cache_infos.needed_registers[reg] = reg_content[reg];
+                cache_infos(last).needed_registers[reg] = reg_content[reg];
             else
-                last->reg_cache_infos.needed_registers[reg] = NULL;
+                cache_infos(last).needed_registers[reg] = NULL;
 
             if (dirty[r64[reg]])
-                last->reg_cache_infos.needed_registers[r64[reg]] = reg_content[r64[reg]];
+                cache_infos(last).needed_registers[r64[reg]] = reg_content[r64[reg]];
             else
-                last->reg_cache_infos.needed_registers[r64[reg]] = NULL;
+                cache_infos(last).needed_registers[r64[reg]] = NULL;
 
             last++;
         }
@@ -561,7 +572,7 @@ void allocate_register_manually(int32_t reg, uint32_t *addr)
 
         while (last <= dst)
         {
-            last->reg_cache_infos.needed_registers[reg] = reg_content[reg];
+            cache_infos(last).needed_registers[reg] = reg_content[reg];
             last++;
         }
         last_access[reg] = dst;
@@ -571,7 +582,7 @@ void allocate_register_manually(int32_t reg, uint32_t *addr)
 
             while (last <= dst)
             {
-                last->reg_cache_infos.needed_registers[r64[reg]] = reg_content[r64[reg]];
+                cache_infos(last).needed_registers[r64[reg]] = reg_content[r64[reg]];
                 last++;
             }
             last_access[r64[reg]] = dst;
@@ -585,7 +596,7 @@ void allocate_register_manually(int32_t reg, uint32_t *addr)
     {
         while (free_since[reg] <= dst)
         {
-            free_since[reg]->reg_cache_infos.needed_registers[reg] = NULL;
+            cache_infos(free_since[reg]).needed_registers[reg] = NULL;
             free_since[reg]++;
         }
     }
@@ -599,7 +610,7 @@ void allocate_register_manually(int32_t reg, uint32_t *addr)
 
             while (last <= dst)
             {
-                last->reg_cache_infos.needed_registers[i] = reg_content[i];
+                cache_infos(last).needed_registers[i] = reg_content[i];
                 last++;
             }
             last_access[i] = dst;
@@ -609,7 +620,7 @@ void allocate_register_manually(int32_t reg, uint32_t *addr)
 
                 while (last <= dst)
                 {
-                    last->reg_cache_infos.needed_registers[r64[i]] = reg_content[r64[i]];
+                    cache_infos(last).needed_registers[r64[i]] = reg_content[r64[i]];
                     last++;
                 }
                 last_access[r64[i]] = dst;
@@ -652,7 +663,7 @@ void allocate_register_manually_w(int32_t reg, uint32_t *addr, int32_t load)
 
         while (last <= dst)
         {
-            last->reg_cache_infos.needed_registers[reg] = reg_content[reg];
+            cache_infos(last).needed_registers[reg] = reg_content[reg];
             last++;
         }
         last_access[reg] = dst;
@@ -663,7 +674,7 @@ void allocate_register_manually_w(int32_t reg, uint32_t *addr, int32_t load)
 
             while (last <= dst)
             {
-                last->reg_cache_infos.needed_registers[r64[reg]] = reg_content[r64[reg]];
+                cache_infos(last).needed_registers[r64[reg]] = reg_content[r64[reg]];
                 last++;
             }
             last_access[r64[reg]] = NULL;
@@ -680,7 +691,7 @@ void allocate_register_manually_w(int32_t reg, uint32_t *addr, int32_t load)
     {
         while (free_since[reg] <= dst)
         {
-            free_since[reg]->reg_cache_infos.needed_registers[reg] = NULL;
+            cache_infos(free_since[reg]).needed_registers[reg] = NULL;
             free_since[reg]++;
         }
     }
@@ -694,7 +705,7 @@ void allocate_register_manually_w(int32_t reg, uint32_t *addr, int32_t load)
 
             while (last <= dst)
             {
-                last->reg_cache_infos.needed_registers[i] = reg_content[i];
+                cache_infos(last).needed_registers[i] = reg_content[i];
                 last++;
             }
             last_access[i] = dst;
@@ -703,7 +714,7 @@ void allocate_register_manually_w(int32_t reg, uint32_t *addr, int32_t load)
                 last = last_access[r64[i]] + 1;
                 while (last <= dst)
                 {
-                    last->reg_cache_infos.needed_registers[r64[i]] = NULL;
+                    cache_infos(last).needed_registers[r64[i]] = NULL;
                     last++;
                 }
                 free_since[r64[i]] = dst + 1;
@@ -750,7 +761,7 @@ void allocate_register_manually_w(int32_t reg, uint32_t *addr, int32_t load)
 // 0x8B (reg<<3)|5 0xXXXXXXXX mov edi, [XXXXXXXX]
 // 0xC3 ret
 // total : 62 bytes
-void build_wrapper(precomp_instr *instr, unsigned char *code, precomp_block *block)
+void build_wrapper(dyna_instr *instr, unsigned char *code, precomp_block *block)
 {
     int32_t i;
     int32_t j = 0;
@@ -796,13 +807,47 @@ void build_wrapper(precomp_instr *instr, unsigned char *code, precomp_block *blo
     code[j++] = 0xC3;
 }
 
-void build_wrappers(precomp_instr *instr, int32_t start, int32_t end, precomp_block *block)
+// 0xC7 0x05 0xXXXXXXXX 0xXXXXXXXX mov [&PC], XXXXXXXX (instruction)
+// 0xB8      0xXXXXXXXX            mov eax, XXXXXXXX (RECOMPILE_ENTRY)
+// 0xFF 0xD0                       call eax
+// total : 17 bytes
+/**
+ * \brief Builds the wrapper of an instruction relying on known register values, which recompiles the block from it
+ * since they may not hold when it's entered from elsewhere.
+ */
+static void build_recompile_wrapper(dyna_instr *instr, unsigned char *code, precomp_block *block)
 {
+    int32_t j = 0;
+
+    code[j++] = 0xC7;
+    code[j++] = 0x05;
+    *((uint32_t *)&code[j]) = (uint32_t)(&PC);
+    j += 4;
+    *((uint32_t *)&code[j]) = (uint32_t)(&block->block[instr - block->dyna]);
+    j += 4;
+
+    code[j++] = 0xB8;
+    *((uint32_t *)&code[j]) = (uint32_t)(RECOMPILE_ENTRY);
+    j += 4;
+
+    code[j++] = 0xFF;
+    code[j++] = 0xD0;
+}
+
+void build_wrappers(int32_t start, int32_t end, precomp_block *block)
+{
+    dyna_instr *instr = block->dyna;
     int32_t i, reg;
     ;
     for (i = start; i < end; i++)
     {
         instr[i].reg_cache_infos.need_map = 0;
+        if (instr[i].const_dependent)
+        {
+            instr[i].reg_cache_infos.need_map = 1;
+            build_recompile_wrapper(&instr[i], instr[i].reg_cache_infos.jump_wrapper, block);
+            continue;
+        }
         for (reg = 0; reg < 8; reg++)
         {
             if (instr[i].reg_cache_infos.needed_registers[reg] != NULL)
@@ -818,6 +863,6 @@ void build_wrappers(precomp_instr *instr, int32_t start, int32_t end, precomp_bl
 void simplify_access()
 {
     int32_t i;
-    dst->local_addr = code_length;
-    for (i = 0; i < 8; i++) dst->reg_cache_infos.needed_registers[i] = NULL;
+    get_dyna_instr(cache_block, dst)->local_addr = code_length;
+    for (i = 0; i < 8; i++) cache_infos(dst).needed_registers[i] = NULL;
 }
@@ -8,15 +8,15 @@
 
 #include <r4300/recomp.h>
 
-void init_cache(precomp_instr *start);
+void init_cache(precomp_block *block, precomp_instr *start);
 void free_all_registers();
 void free_register(int32_t reg);
 int32_t allocate_register(uint32_t *addr);
 int32_t allocate_64_register1(uint32_t *addr);
 int32_t allocate_64_register2(uint32_t *addr);
 int32_t is64(uint32_t *addr);
-void build_wrapper(precomp_instr *, unsigned char *, precomp_block *);
-void build_wrappers(precomp_instr *, int32_t, int32_t, precomp_block *);
+void build_wrapper(dyna_instr *, unsigned char *, precomp_block *);
+void build_wrappers(int32_t, int32_t, precomp_block *);
 int32_t lru_register();
 int32_t allocate_register_w(uint32_t *addr);
 int32_t allocate_64_register1_w(uint32_t *addr);
@@ -6,27 +6,171 @@
 
 #include "stdafx.h"
 #include <Core.h>
+#include <r4300/ops.h>
 #include <r4300/r4300.h>
 #include <r4300/recomp.h>
 #include <r4300/recomph.h>
+#include <alloc.h>
 
 // NOTE: dynarec isn't compatible with the game debugger
 
 void dyna_jump()
 {
-    if (PC->reg_cache_infos.need_map)
-        *return_address = (uint32_t)(PC->reg_cache_infos.jump_wrapper);
+    const dyna_instr *instr = get_dyna_instr(actual, PC);
+    if (instr->reg_cache_infos.need_map)
+        *return_address = (uint32_t)(instr->reg_cache_infos.jump_wrapper);
     else
-        *return_address = (uint32_t)(actual->code + PC->local_addr);
+        *return_address = (uint32_t)(actual->code + instr->local_addr);
+}
+
+/**
+ * \brief A patched exit stub jumping straight from one block's code into another's.
+ */
+struct block_link
+{
+    const precomp_block *source;
+    // The stub's offset in the source's code, which stays valid when the code is moved
+    uint32_t offset;
+    const precomp_block *target;
+};
+
+// The links into and out of each block, so a block is unlinked without walking everyone else's links. precomp_block
+// is allocated with malloc, which is why these live here rather than in the block.
+static std::unordered_map<const precomp_block *, std::vector<block_link>> links_into;
+static std::unordered_map<const precomp_block *, std::vector<block_link>> links_from;
+
+// 0xEB 0x28                            jmp +40 (unlinked), or 0x66 0x90 nop (linked)
+// 0x80 0x3D 0xXXXXXXXX 0x00            cmp byte [XXXXXXXX], 0 (target page's invalid_code)
+// 0x75 0x1F                            jne +31
+// 0x80 0x3D 0xXXXXXXXX 0x00            cmp byte [XXXXXXXX], 0 (target alias page's invalid_code)
+// 0x75 0x16                            jne +22
+// 0xC7 0x05 0xXXXXXXXX 0xXXXXXXXX      mov [&actual], XXXXXXXX (target block)
+// 0xA1      0xXXXXXXXX                 mov eax, [XXXXXXXX] (&target block->code)
+// 0x05      0xXXXXXXXX                 add eax, XXXXXXXX (local_addr)
+// 0xFF 0xE0                            jmp eax
+// ...                                  jump_to_address and PC setup, call dyna_link_jump
+// total : 69 bytes
+static void link_stub(unsigned char *code, const precomp_block *target, const uint32_t addr, const uint32_t local_addr)
+{
+    int32_t j = 2;
+
+    code[j++] = 0x80;
+    code[j++] = 0x3D;
+    *((uint32_t *)&code[j]) = (uint32_t)(&invalid_code[addr >> 12]);
+    j += 4;
+    code[j++] = 0x00;
+    code[j++] = 0x75;
+    code[j++] = 0x1F;
+
+    code[j++] = 0x80;
+    code[j++] = 0x3D;
+    *((uint32_t *)&code[j]) = (uint32_t)(&invalid_code[(addr ^ 0x20000000) >> 12]);
+    j += 4;
+    code[j++] = 0x00;
+    code[j++] = 0x75;
+    code[j++] = 0x16;
+
+    code[j++] = 0xC7;
+    code[j++] = 0x05;
+    *((uint32_t *)&code[j]) = (uint32_t)(&actual);
+    j += 4;
+    *((uint32_t *)&code[j]) = (uint32_t)(target);
+    j += 4;
+
+    code[j++] = 0xA1;
+    *((uint32_t *)&code[j]) = (uint32_t)(&target->code);
+    j += 4;
+
+    code[j++] = 0x05;
+    *((uint32_t *)&code[j]) = local_addr;
+    j += 4;
+
+    code[j++] = 0xFF;
+    code[j++] = 0xE0;
+
+    // The stub is only entered through its first bytes, so they're patched last
+    code[0] = 0x66;
+    code[1] = 0x90;
+}
+
+void dyna_link_jump()
+{
+    precomp_block *source = actual;
+    unsigned char *stub = (unsigned char *)*return_address - LINK_STUB_SIZE;
+    const uint32_t addr = jump_to_address;
+
+    jump_to_func();
+
+    // The target must be compiled, and its code must not rely on registers cached by the code jumping to it
+    if (skip_jump || actual != blocks[addr >> 12] || PC != actual->block + ((addr - actual->start) >> 2) ||
+        PC->ops == NOTCOMPILED || PC->ops == NOTCOMPILED2 || get_dyna_instr(actual, PC)->reg_cache_infos.need_map)
+    {
+        return;
+    }
+    if (stub < source->code || stub >= source->code + source->code_length || stub[0] != 0xEB) return;
+
+    exec_begin_write();
+    link_stub(stub, actual, addr, get_dyna_instr(actual, PC)->local_addr);
+    exec_end_write();
+
+    const block_link link{.source = source, .offset = (uint32_t)(stub - source->code), .target = actual};
+    links_into[link.target].push_back(link);
+    links_from[link.source].push_back(link);
+}
+
+void unlink_block(const precomp_block *block)
+{
+    exec_begin_write();
+
+    // Stubs jumping into the block are restored, and forgotten by their source. Its own stubs are rewritten with it.
+    if (const auto it = links_into.find(block); it != links_into.end())
+    {
+        for (const auto &link : it->second)
+        {
+            if (link.source == block)
+            {
+                continue;
+            }
+
+            unsigned char *stub = link.source->code + link.offset;
+            stub[0] = 0xEB;
+            stub[1] = LINK_BODY_SIZE;
+
+            if (const auto from = links_from.find(link.source); from != links_from.end())
+            {
+                std::erase_if(from->second, [&](const block_link &other) { return other.target == block; });
+            }
+        }
+        links_into.erase(it);
+    }
+
+    // The block's stubs into other blocks disappear with its code.
+    if (const auto it = links_from.find(block); it != links_from.end())
+    {
+        for (const auto &link : it->second)
+        {
+            if (const auto into = links_into.find(link.target); into != links_into.end())
+            {
+                std::erase_if(into->second, [&](const block_link &other) { return other.source == block; });
+            }
+        }
+        links_from.erase(it);
+    }
+
+    exec_end_write();
+}
+
+void clear_block_links()
+{
+    links_into.clear();
+    links_from.clear();
 }
 
 jmp_buf g_jmp_state;
 
 void dyna_start(void (*code)())
 {
-    core_executing = true;
-    g_core->callbacks.core_executing_changed(core_executing);
-    g_core->log_info(std::format(L"core_executing: {}", (bool)core_executing));
+    vr_set_core_executing(true);
     if (setjmp(g_jmp_state) == 0)
     {
         code();
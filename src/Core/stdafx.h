@@ -11,11 +11,13 @@
 #pragma warning(push, 0)
 #include <algorithm>
 #include <any>
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <cctype>
 #include <cfloat>
 #include <cmath>
+#include <condition_variable>
 #include <csetjmp>
 #include <cstdarg>
 #include <cstdint>
@@ -373,7 +373,11 @@ static void handle_config_ini(const bool is_reading, mINI::INIStructure &ini)
     HANDLE_P_VALUE(encoder_type)
     HANDLE_P_VALUE(capture_delay)
     HANDLE_VALUE(ffmpeg_final_options)
+    HANDLE_P_VALUE(ffmpeg_pixel_format)
+    HANDLE_VALUE(ffmpeg_converted_final_options)
     HANDLE_VALUE(ffmpeg_path)
+    HANDLE_P_VALUE(ffmpeg_max_queued_frames)
+    HANDLE_P_VALUE(ffmpeg_backpressure_mode)
     HANDLE_P_VALUE(synchronization_mode)
     HANDLE_P_VALUE(keep_default_working_directory)
     HANDLE_P_VALUE(fast_dispatcher)
@@ -387,6 +391,7 @@ static void handle_config_ini(const bool is_reading, mINI::INIStructure &ini)
     HANDLE_P_VALUE(piano_roll_keep_selection_visible)
     HANDLE_P_VALUE(piano_roll_keep_playhead_visible)
     HANDLE_P_VALUE(core.st_undo_load)
+    HANDLE_P_VALUE(core.st_undo_max_count)
     HANDLE_P_VALUE(core.use_summercart)
     HANDLE_P_VALUE(core.wii_vc_emulation)
     HANDLE_P_VALUE(core.float_exception_emulation)
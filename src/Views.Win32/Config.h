@@ -135,6 +135,8 @@ struct t_config
     /// The delay (in milliseconds) before capturing the window
     /// <para/>
     /// May be useful when capturing other windows alongside mupen
+    /// <para/>
+    /// Only applies to the window and desktop capture modes
     /// </summary>
     int32_t capture_delay;
 
@@ -146,11 +148,44 @@ struct t_config
         L"-f s16le -sample_rate %d -ac 2 -channel_layout stereo -i %s "
         L"-c:v libx264 -preset veryfast -tune zerolatency -crf 23 -c:a aac -b:a 128k -vf \"vflip\" -f mp4 %s";
 
+    /// <summary>
+    /// The pixel format frames are handed to FFmpeg in
+    /// <para/>
+    /// 0 - BGR24, as captured (bottom-up, flipped by FFmpeg)
+    /// 1 - RGB24
+    /// 2 - I420
+    /// 3 - NV12
+    /// </summary>
+    int32_t ffmpeg_pixel_format = 0;
+
+    /// <summary>
+    /// FFmpeg post-stream option format string which is used instead of ffmpeg_final_options when the pixel format
+    /// isn't BGR24. The first placeholder is the pixel format's FFmpeg name, and frames are already top-down.
+    /// </summary>
+    std::wstring ffmpeg_converted_final_options =
+        L"-y -f rawvideo -pixel_format %s -video_size %dx%d -framerate %d -i %s "
+        L"-f s16le -sample_rate %d -ac 2 -channel_layout stereo -i %s "
+        L"-c:v libx264 -preset veryfast -tune zerolatency -crf 23 -c:a aac -b:a 128k -f mp4 %s";
+
     /// <summary>
     /// FFmpeg binary path
     /// </summary>
     std::wstring ffmpeg_path = L"C:\\ffmpeg\\bin\\ffmpeg.exe";
 
+    /// <summary>
+    /// The maximum amount of video frames the FFmpeg encoder buffers in memory
+    /// </summary>
+    int32_t ffmpeg_max_queued_frames = 32;
+
+    /// <summary>
+    /// What the FFmpeg encoder does when its frame buffers are exhausted
+    /// <para/>
+    /// 0 - Block emulation until a buffer is free
+    /// 1 - Drop the frame and repeat the previous one
+    /// 2 - Spill the frame to a temporary file
+    /// </summary>
+    int32_t ffmpeg_backpressure_mode = 0;
+
     /// <summary>
     /// The audio-video synchronization mode
     /// <para/>
@@ -994,14 +994,22 @@ static void CALLBACK invalidate_callback(UINT, UINT, DWORD_PTR, DWORD_PTR, DWORD
 
         if (EncodingManager::is_capturing())
         {
+            std::wstring frame_text = std::format(L"{}", EncodingManager::get_video_frame());
+
+            const auto queued_frames = EncodingManager::get_queued_frames();
+            const auto dropped_frames = EncodingManager::get_dropped_frames();
+            if (queued_frames || dropped_frames)
+            {
+                frame_text += std::format(L", {} queued, {} dropped", queued_frames, dropped_frames);
+            }
+
             if (g_main_ctx.core_ctx->vcr_get_task() == task_idle)
             {
-                Statusbar::post(std::format(L"{}", EncodingManager::get_video_frame()), Statusbar::Section::VCR);
+                Statusbar::post(frame_text, Statusbar::Section::VCR);
             }
             else
             {
-                Statusbar::post(std::format(L"{}({})", get_status_text(), EncodingManager::get_video_frame()),
-                                Statusbar::Section::VCR);
+                Statusbar::post(std::format(L"{}({})", get_status_text(), frame_text), Statusbar::Section::VCR);
             }
         }
         else
@@ -1118,6 +1126,8 @@ static core_result init_core()
     g_main_ctx.core.log_error = [](const auto &str) { g_core_logger->error(str); };
     g_main_ctx.core.load_plugins = PluginUtil::load_plugins;
     g_main_ctx.core.initiate_plugins = PluginUtil::initiate_plugins;
+    g_main_ctx.core.plugins_rom_closed = PluginUtil::rom_closed_plugins;
+    g_main_ctx.core.plugins_rom_open = PluginUtil::rom_open_plugins;
     g_main_ctx.core.submit_task = [](const auto cb) { ThreadPool::submit_task(cb); };
     g_main_ctx.core.get_saves_directory = Config::save_directory;
     g_main_ctx.core.get_backups_directory = Config::backup_directory;
@@ -695,22 +695,33 @@ void PluginUtil::start_plugins()
 
     g_main_ctx.core.rsp_do_rsp_cycles = g_plugin_funcs.rsp_do_rsp_cycles;
 
+    rom_open_plugins();
+}
+
+void PluginUtil::stop_plugins()
+{
+    rom_closed_plugins();
+    g_plugin_funcs.video_close_dll();
+    g_plugin_funcs.audio_close_dll_audio();
+    g_plugin_funcs.input_close_dll();
+    g_plugin_funcs.rsp_close_dll();
+}
+
+void PluginUtil::rom_open_plugins()
+{
     g_plugin_funcs.video_rom_open();
     g_plugin_funcs.input_rom_open();
     g_plugin_funcs.audio_rom_open();
 }
 
-void PluginUtil::stop_plugins()
+void PluginUtil::rom_closed_plugins()
 {
     g_plugin_funcs.video_rom_closed();
     g_plugin_funcs.audio_rom_closed();
     g_plugin_funcs.input_rom_closed();
     g_plugin_funcs.rsp_rom_closed();
-    g_plugin_funcs.video_close_dll();
-    g_plugin_funcs.audio_close_dll_audio();
-    g_plugin_funcs.input_close_dll();
-    g_plugin_funcs.rsp_close_dll();
 }
+
 bool PluginUtil::load_plugins()
 {
     if (video_plugin.get() && audio_plugin.get() && input_plugin.get() && rsp_plugin.get() &&
@@ -174,6 +174,16 @@ void start_plugins();
  */
 void stop_plugins();
 
+/**
+ * \brief Notifies the currently loaded plugins that the ROM was opened.
+ */
+void rom_open_plugins();
+
+/**
+ * \brief Notifies the currently loaded plugins that the ROM was closed, without unloading them.
+ */
+void rom_closed_plugins();
+
 /**
  * \brief Loads the plugins specified in the configuration, filling out the global plugin function registry.
  * \return Whether the operation succeeded.
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * \brief A ring buffer holding a capture session's audio. Each AI DMA is copied into it once as a contiguous chunk,
+ * which consumers then read in place. Chunks must be released in the order they were written.
+ */
+class AudioRing
+{
+  public:
+    ~AudioRing()
+    {
+        destroy();
+    }
+
+    /**
+     * \brief Allocates the ring's storage.
+     * \param capacity The ring's capacity in bytes, which is also the maximum size of a chunk.
+     */
+    void init(const size_t capacity)
+    {
+        destroy();
+
+        std::lock_guard lock(m_mutex);
+        m_buf = static_cast<uint8_t *>(_aligned_malloc(capacity, 64));
+        m_capacity = m_buf ? capacity : 0;
+        m_aborted = false;
+    }
+
+    /**
+     * \brief Frees the ring's storage, invalidating all chunks.
+     */
+    void destroy()
+    {
+        abort();
+
+        std::lock_guard lock(m_mutex);
+        _aligned_free(m_buf);
+        m_buf = nullptr;
+        m_capacity = 0;
+        m_head = 0;
+        m_used = 0;
+        m_chunks.clear();
+    }
+
+    /**
+     * \brief Wakes and fails any pending and future writes.
+     */
+    void abort()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_aborted = true;
+        }
+        m_cv.notify_all();
+    }
+
+    /**
+     * \brief Copies data into a new chunk, waiting for consumers to release older chunks if the ring is full.
+     * \param data The data to copy.
+     * \param length The data's length.
+     * \return The chunk, or nullptr if the data doesn't fit into the ring or the ring was aborted.
+     */
+    uint8_t *write(const void *data, const size_t length)
+    {
+        std::unique_lock lock(m_mutex);
+
+        if (length == 0 || length > m_capacity)
+        {
+            return nullptr;
+        }
+
+        // Chunks are kept contiguous, so a chunk which doesn't fit before the end of the storage skips the remainder.
+        size_t offset{};
+        size_t padding{};
+        const auto fits = [&] {
+            if (m_used == 0)
+            {
+                m_head = 0;
+            }
+            offset = m_head;
+            padding = 0;
+            if (offset + length > m_capacity)
+            {
+                padding = m_capacity - offset;
+                offset = 0;
+            }
+            return m_used + padding + length <= m_capacity;
+        };
+
+        m_cv.wait(lock, [&] { return m_aborted || fits(); });
+
+        if (m_aborted)
+        {
+            return nullptr;
+        }
+
+        memcpy(m_buf + offset, data, length);
+        m_chunks.push_back({.data = m_buf + offset, .span = padding + length});
+        m_head = offset + length;
+        m_used += padding + length;
+
+        return m_buf + offset;
+    }
+
+    /**
+     * \brief Releases the oldest chunk, making its space available for writing.
+     * \param chunk The chunk, which must be the oldest unreleased one.
+     */
+    void release(const uint8_t *chunk)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+
+            if (m_chunks.empty())
+            {
+                return;
+            }
+
+            assert(m_chunks.front().data == chunk);
+            m_used -= m_chunks.front().span;
+            m_chunks.pop_front();
+        }
+        m_cv.notify_one();
+    }
+
+  private:
+    struct Chunk
+    {
+        const uint8_t *data;
+
+        /**
+         * \brief The chunk's length plus the storage it skipped at the end of the ring.
+         */
+        size_t span;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    uint8_t *m_buf{};
+    size_t m_capacity{};
+    size_t m_head{};
+    size_t m_used{};
+    std::deque<Chunk> m_chunks;
+    bool m_aborted{};
+};
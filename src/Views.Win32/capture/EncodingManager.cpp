@@ -33,11 +33,69 @@ long double m_video_frame = 0;
 long double m_audio_frame = 0;
 size_t m_total_frames = 0;
 
-// Video buffer, allocated once when recording starts and freed when it ends.
+// Encoder buffering statistics, refreshed after each appended frame.
+std::atomic<size_t> m_queued_frames = 0;
+std::atomic<size_t> m_dropped_frames = 0;
+
+// Amount of frames which can be in flight between the emulation thread and the capture worker.
+constexpr size_t CAPTURE_SLOT_COUNT = 3;
+
+// Size of the audio ring. Holds several of the biggest possible AI DMAs.
+constexpr size_t AUDIO_RING_SIZE = 0x200000;
+
+/**
+ * \brief A unit of work for the capture worker. Video and audio share one queue, so the encoder sees them in the same
+ * order the core produced them.
+ */
+struct t_capture_item
+{
+    /**
+     * \brief The slot holding the frame, or -1 if the item is audio.
+     */
+    int32_t slot = -1;
+
+    /**
+     * \brief The video plugin's screen buffer which still needs to be resolved into the slot, or null if the slot
+     * already holds the frame.
+     */
+    void *plugin_buf{};
+    int32_t plugin_width{};
+    int32_t plugin_height{};
+
+    /**
+     * \brief The lag count at the VI the frame was captured at.
+     */
+    size_t lag_count{};
+
+    /**
+     * \brief The audio data, which is a chunk of the audio ring.
+     */
+    uint8_t *audio{};
+    size_t audio_length{};
+    int32_t audio_bitrate{};
+};
+
+// Frame buffers, allocated once when recording starts and freed when it ends.
+uint8_t *m_slot_bufs[CAPTURE_SLOT_COUNT]{};
+
+// The frame buffer currently being captured into.
 uint8_t *m_video_buf = nullptr;
 int32_t m_video_width;
 int32_t m_video_height;
 
+std::thread m_capture_thread;
+std::mutex m_capture_mutex;
+std::condition_variable m_capture_cv;
+std::condition_variable m_slot_cv;
+std::deque<t_capture_item> m_capture_queue;
+std::vector<int32_t> m_free_slots;
+bool m_capture_thread_stop = false;
+std::atomic<bool> m_capture_failed = false;
+std::atomic<size_t> m_frame_lag_count = 0;
+
+// The capture session's audio, written once per AI DMA and read in place by the encoder.
+AudioRing m_audio_ring;
+
 std::atomic m_capturing = false;
 t_config::EncoderType m_encoder_type;
 std::unique_ptr<Encoder> m_encoder;
@@ -200,6 +258,131 @@ void readscreen_hybrid()
     });
 }
 
+/**
+ * \brief Resolves and hands queued frames and audio to the encoder, in order.
+ */
+void capture_thread()
+{
+    while (true)
+    {
+        std::unique_lock lock(m_capture_mutex);
+        m_capture_cv.wait(lock, [] { return !m_capture_queue.empty() || m_capture_thread_stop; });
+
+        if (m_capture_queue.empty())
+        {
+            return;
+        }
+
+        auto item = std::move(m_capture_queue.front());
+        m_capture_queue.pop_front();
+        lock.unlock();
+
+        // Audio goes to the encoder even after a failure, since it may still hold older chunks and the ring's chunks
+        // must be released in order.
+        if (item.slot == -1)
+        {
+            if (!m_encoder->append_audio(item.audio, item.audio_length, (uint8_t)item.audio_bitrate))
+            {
+                m_capture_failed = true;
+            }
+            continue;
+        }
+
+        const auto buf = m_slot_bufs[item.slot];
+
+        if (item.plugin_buf)
+        {
+            const auto frame_size = (size_t)m_video_width * m_video_height * 3;
+            const auto plugin_size = (size_t)item.plugin_width * item.plugin_height * 3;
+            memcpy(buf, item.plugin_buf, std::min(frame_size, plugin_size));
+            g_plugin_funcs.video_dll_crt_free(item.plugin_buf);
+        }
+
+        if (!m_capture_failed)
+        {
+            m_frame_lag_count = item.lag_count;
+            if (m_encoder->append_video(buf))
+            {
+                const auto stats = m_encoder->get_stats();
+                m_queued_frames = stats.queued_video;
+                m_dropped_frames = stats.dropped_frames;
+            }
+            else
+            {
+                m_capture_failed = true;
+            }
+        }
+
+        lock.lock();
+        m_free_slots.push_back(item.slot);
+        lock.unlock();
+        m_slot_cv.notify_one();
+    }
+}
+
+/**
+ * \brief Queues an item for the capture worker.
+ */
+void push_capture_item(t_capture_item item)
+{
+    {
+        std::lock_guard lock(m_capture_mutex);
+        m_capture_queue.push_back(std::move(item));
+    }
+    m_capture_cv.notify_one();
+}
+
+/**
+ * \brief Waits for a free frame slot and takes it.
+ */
+int32_t acquire_capture_slot()
+{
+    std::unique_lock lock(m_capture_mutex);
+    m_slot_cv.wait(lock, [] { return !m_free_slots.empty(); });
+    const auto slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    return slot;
+}
+
+void start_capture_thread()
+{
+    const auto frame_size = (size_t)m_video_width * m_video_height * 3;
+    m_free_slots.clear();
+    for (size_t i = 0; i < CAPTURE_SLOT_COUNT; ++i)
+    {
+        m_slot_bufs[i] = (uint8_t *)malloc(frame_size);
+        m_free_slots.push_back((int32_t)i);
+    }
+
+    m_capture_failed = false;
+    m_capture_thread_stop = false;
+    m_capture_thread = std::thread(capture_thread);
+}
+
+/**
+ * \brief Stops the capture worker after it has handed all queued items to the encoder.
+ */
+void stop_capture_thread()
+{
+    {
+        std::lock_guard lock(m_capture_mutex);
+        m_capture_thread_stop = true;
+    }
+    m_capture_cv.notify_all();
+
+    if (m_capture_thread.joinable())
+    {
+        m_capture_thread.join();
+    }
+
+    for (auto &buf : m_slot_bufs)
+    {
+        free(buf);
+        buf = nullptr;
+    }
+    m_video_buf = nullptr;
+}
+
 void read_screen()
 {
     if (g_config.capture_mode == 0)
@@ -273,6 +456,12 @@ void get_video_dimensions(int32_t *width, int32_t *height)
 
 bool stop_capture_impl()
 {
+    // ai_len_changed holds the mutex while waiting for room in the ring, so the wait must be cut short before locking.
+    if (is_capturing())
+    {
+        m_audio_ring.abort();
+    }
+
     std::lock_guard lock(m_mutex);
 
     if (!is_capturing())
@@ -280,7 +469,12 @@ bool stop_capture_impl()
         return true;
     }
 
-    if (!m_encoder->stop())
+    stop_capture_thread();
+
+    const bool stopped = m_encoder->stop();
+    m_audio_ring.destroy();
+
+    if (!stopped)
     {
         DialogService::show_dialog(L"Failed to stop encoding.", L"Capture", fsvc_error);
         return false;
@@ -318,6 +512,12 @@ bool start_capture_impl(std::filesystem::path path, t_config::EncoderType encode
         return false;
     }
 
+    // See stop_capture_impl, which is called below if a capture is already running.
+    if (is_capturing())
+    {
+        m_audio_ring.abort();
+    }
+
     std::lock_guard lock(m_mutex);
 
     g_view_logger->info("[EncodingManager]: Starting capture at {} x {}...", m_video_width, m_video_height);
@@ -355,10 +555,12 @@ bool start_capture_impl(std::filesystem::path path, t_config::EncoderType encode
     m_video_frame = 0.0;
     m_audio_frame = 0.0;
     m_total_frames = 0;
+    m_queued_frames = 0;
+    m_dropped_frames = 0;
 
-    free(m_video_buf);
     get_video_dimensions(&m_video_width, &m_video_height);
-    m_video_buf = (uint8_t *)malloc(m_video_width * m_video_height * 3);
+
+    m_audio_ring.init(AUDIO_RING_SIZE);
 
     const auto result = m_encoder->start(Encoder::Params{
         .path = m_current_path,
@@ -367,10 +569,12 @@ bool start_capture_impl(std::filesystem::path path, t_config::EncoderType encode
         .fps = g_main_ctx.core_ctx->vr_get_vis_per_second(g_main_ctx.core_ctx->vr_get_rom_header()->Country_code),
         .arate = (uint32_t)m_audio_freq,
         .ask_for_encoding_settings = ask_for_encoding_settings,
+        .audio_ring = &m_audio_ring,
     });
 
     if (result.has_value())
     {
+        m_audio_ring.destroy();
         const auto &str = result.value();
         if (!str.empty())
         {
@@ -379,6 +583,8 @@ bool start_capture_impl(std::filesystem::path path, t_config::EncoderType encode
         return false;
     }
 
+    start_capture_thread();
+
     m_capturing = true;
     g_config.core.render_throttling = false;
 
@@ -414,40 +620,68 @@ void stop_capture(const std::function<void(bool)> &callback)
     });
 }
 
+/**
+ * \brief Snapshots the current frame and queues it for the capture worker.
+ * \remarks The snapshot stays on the emulator thread, and only the resolving and encoding is left to the worker. Every
+ * source shows state which the emulator thread replaces as soon as this returns: the plugin's readscreen reads from a
+ * GL context bound to the emulator thread, MGE's buffer is overwritten on the next present, and the window, desktop and
+ * hybrid captures grab what the plugin and Lua drew for this VI. A readback on the worker would race the next frame and
+ * capture duplicated or skipped frames.
+ */
 void at_vi()
 {
-    std::lock_guard lock(m_mutex);
-
     if (!m_capturing)
     {
         return;
     }
 
-    if (g_config.capture_delay)
+    // The delay lets other windows catch up before the window or desktop is grabbed, so it has to precede the snapshot
+    // and stall emulation. The mutex isn't held while waiting so a stop request doesn't wait on it, and other modes
+    // don't read anything the delay could affect.
+    if (g_config.capture_delay && (g_config.capture_mode == 1 || g_config.capture_mode == 2))
     {
         Sleep(g_config.capture_delay);
     }
 
-    read_screen();
+    std::lock_guard lock(m_mutex);
 
-    if (m_encoder->append_video(m_video_buf))
+    if (!m_capturing)
     {
-        m_total_frames++;
         return;
     }
 
-    DialogService::show_dialog(L"Failed to append frame to video.\nPerhaps you ran out of memory?", L"Capture",
-                               fsvc_error);
-    stop_capture();
+    if (m_capture_failed)
+    {
+        DialogService::show_dialog(L"Failed to append data to the capture.\nCapture will be stopped.", L"Capture",
+                                   fsvc_error);
+        stop_capture();
+        return;
+    }
+
+    // Only the snapshot happens here, resolving the pixels and encoding is left to the capture worker. Waits if the
+    // worker is too many frames behind.
+    t_capture_item item{.slot = acquire_capture_slot(), .lag_count = g_main_ctx.core_ctx->vr_get_lag_count()};
+    m_video_buf = m_slot_bufs[item.slot];
+
+    if (g_config.capture_mode == 0 && !PluginUtil::mge_available())
+    {
+        g_plugin_funcs.video_read_screen(&item.plugin_buf, &item.plugin_width, &item.plugin_height);
+    }
+    else
+    {
+        read_screen();
+    }
+
+    push_capture_item(std::move(item));
+    m_total_frames++;
 }
 
 void ai_len_changed()
 {
     std::lock_guard lock(m_mutex);
 
-    const auto p = reinterpret_cast<short *>((char *)g_main_ctx.core_ctx->rdram +
-                                             (g_main_ctx.core_ctx->ai_register->ai_dram_addr & 0xFFFFFF));
-    const auto buf = (char *)p;
+    const auto buf =
+        (uint8_t *)g_main_ctx.core_ctx->rdram + (g_main_ctx.core_ctx->ai_register->ai_dram_addr & 0xFFFFFF);
     const int ai_len = (int)g_main_ctx.core_ctx->ai_register->ai_len;
 
     m_audio_bitrate = (int)g_main_ctx.core_ctx->ai_register->ai_bitrate + 1;
@@ -459,11 +693,18 @@ void ai_len_changed()
 
     if (ai_len <= 0) return;
 
-    if (!m_encoder->append_audio(reinterpret_cast<uint8_t *>(buf), ai_len, m_audio_bitrate))
+    // This is the only copy the audio goes through before the encoder. Waits if the encoder is too far behind.
+    const auto chunk = m_audio_ring.write(buf, ai_len);
+    if (!chunk)
     {
-        DialogService::show_dialog(L"Failed to append audio data.\nCapture will be stopped.", L"Capture", fsvc_error);
-        stop_capture();
+        return;
     }
+
+    push_capture_item(t_capture_item{
+        .audio = chunk,
+        .audio_length = (size_t)ai_len,
+        .audio_bitrate = m_audio_bitrate,
+    });
 }
 
 void ai_dacrate_changed(std::any data)
@@ -500,6 +741,21 @@ size_t get_video_frame()
     return m_total_frames;
 }
 
+size_t get_frame_lag_count()
+{
+    return m_frame_lag_count;
+}
+
+size_t get_queued_frames()
+{
+    return m_queued_frames;
+}
+
+size_t get_dropped_frames()
+{
+    return m_dropped_frames;
+}
+
 std::filesystem::path get_current_path()
 {
     return m_current_path;
@@ -79,6 +79,25 @@ void ai_len_changed();
  */
 size_t get_video_frame();
 
+/**
+ * Gets the lag count at the VI whose frame is currently being handed to the encoder. Encoders must use this instead of
+ * querying the core, which may already be several frames ahead.
+ * \remarks This method is thread-safe.
+ */
+size_t get_frame_lag_count();
+
+/**
+ * Gets the amount of video frames waiting to be written by the encoder.
+ * \remarks This method is thread-safe.
+ */
+size_t get_queued_frames();
+
+/**
+ * Gets the amount of video frames the encoder dropped because it couldn't keep up.
+ * \remarks This method is thread-safe.
+ */
+size_t get_dropped_frames();
+
 /**
  * Gets the current output path.
  */
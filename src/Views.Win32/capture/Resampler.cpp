@@ -7,12 +7,13 @@
 #include "stdafx.h"
 #include "Resampler.h"
 #include <speex/speex_resampler.h>
+#include <emmintrin.h>
 
-const auto RESAMP_BUFFER_SIZE = 44100 * 2 * 2;
+// Amount of frames converted into the scratch buffer per resampler call.
+constexpr size_t SCRATCH_FRAMES = 44100;
 
 static SpeexResamplerState *speex_ctx{};
-static short in_samps[RESAMP_BUFFER_SIZE]{};
-static short out_samps[RESAMP_BUFFER_SIZE]{};
+static int16_t in_samps[SCRATCH_FRAMES * 2]{};
 
 static int rates_changed(const int cur_in, const int cur_out)
 {
@@ -22,39 +23,30 @@ static int rates_changed(const int cur_in, const int cur_out)
     return in != (unsigned int)cur_in || out != (unsigned int)cur_out;
 }
 
-int Resampler::get_resample_len(const int dst_freq, const int src_freq, const int src_bitrate, int src_len)
+void Resampler::swap_channels(const int16_t *src, int16_t *dst, const size_t frames)
 {
-    // convert bitrate to 16 bits
-    if (src_bitrate != 16)
-    {
-        if (src_bitrate != 4 && src_bitrate != 8) return -1; // unknown result
-
-        src_len = src_len * (16 / src_bitrate);
-    }
-
-    const long double ratio = src_freq / (long double)dst_freq;
-    const int dst_len = src_len / ratio;
-
-    return dst_len;
-}
+    size_t i = 0;
 
-int Resampler::resample(short **dst, const int dst_freq, const short *src, const int src_freq, const int src_bitrate,
-                        const int src_len)
-{
-    if (src_bitrate != 16)
+    // SSE2 is part of the x86-64 baseline and the x86 build's target, so no runtime dispatch is needed.
+    for (; i + 4 <= frames; i += 4)
     {
-        g_view_logger->error("rsmp_resample bitrate is {} bits when it should be {} bits", src_bitrate, 16);
-        return -1;
+        auto v = _mm_loadu_si128((const __m128i *)(src + i * 2));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128((__m128i *)(dst + i * 2), v);
     }
 
-    // for some reason channels are swapped in src (endianess weirdness?)
-    // fix it here
-    for (unsigned i = 0, samps = src_len >> 1; i < samps; i += 2)
+    for (; i < frames; ++i)
     {
-        in_samps[i + 1] = src[i + 0];
-        in_samps[i + 0] = src[i + 1];
+        const auto first = src[i * 2];
+        dst[i * 2] = src[i * 2 + 1];
+        dst[i * 2 + 1] = first;
     }
+}
 
+void Resampler::resample(const int dst_freq, const int src_freq, const int16_t *src, size_t &src_frames, int16_t *dst,
+                         size_t &dst_frames)
+{
     if (!speex_ctx)
     {
         int err = 0;
@@ -66,10 +58,14 @@ int Resampler::resample(short **dst, const int dst_freq, const short *src, const
         speex_resampler_set_rate(speex_ctx, src_freq, dst_freq);
     }
 
-    spx_uint32_t in_pos = (spx_uint32_t)src_len / 4;
-    spx_uint32_t out_pos = sizeof(out_samps) / 4;
-    speex_resampler_process_interleaved_int(speex_ctx, in_samps, &in_pos, out_samps, &out_pos);
+    // The channels are swapped in the AI's output, so fix them up while staging the input for speex.
+    const size_t frames = std::min(src_frames, SCRATCH_FRAMES);
+    swap_channels(src, in_samps, frames);
+
+    spx_uint32_t in_len = (spx_uint32_t)frames;
+    spx_uint32_t out_len = (spx_uint32_t)std::min(dst_frames, (size_t)UINT32_MAX);
+    speex_resampler_process_interleaved_int(speex_ctx, in_samps, &in_len, dst, &out_len);
 
-    *dst = out_samps;
-    return (int)out_pos * 4;
+    src_frames = in_len;
+    dst_frames = out_len;
 }
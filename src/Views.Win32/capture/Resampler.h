@@ -12,20 +12,24 @@
 namespace Resampler
 {
 /**
- * \brief Resamples audio data from one frequency to another.
- * \param dst Pointer to the destination buffer. This buffer is statically allocated and doesn't need to be freed by the
- * caller. \param dst_freq The destination frequency. \param src Pointer to the source buffer. \param src_freq The
- * source frequency. \param src_bitrate The source bitrate. \param src_len The length of the source buffer in bytes.
- * \return The amount of bytes written to the destination buffer.
- * \remark This function is not thread-safe.
+ * \brief Swaps the channels of interleaved 16-bit stereo frames, converting between the AI's channel order and
+ * left-right order.
+ * \param src The source frames.
+ * \param dst The destination frames. May be the same as the source.
+ * \param frames The amount of frames.
  */
-int resample(short **dst, int dst_freq, const short *src, int src_freq, int src_bitrate, int src_len);
+void swap_channels(const int16_t *src, int16_t *dst, size_t frames);
 
 /**
- * \brief Calculates the length of the destination buffer based on the source buffer's length and the desired
- * destination frequency. \param dst_freq The destination frequency. \param src_freq The source frequency. \param
- * src_bitrate The source bitrate. \param src_len The length of the source buffer in bytes. \return The length of the
- * destination buffer in bytes.
+ * \brief Resamples interleaved 16-bit stereo audio from one frequency to another. The resampler keeps its state between
+ * calls, so a stream can be fed in arbitrarily sized pieces.
+ * \param dst_freq The destination frequency.
+ * \param src_freq The source frequency.
+ * \param src The source frames, in the AI's channel order.
+ * \param src_frames The amount of source frames. Receives the amount of source frames consumed.
+ * \param dst The destination buffer, which receives frames in left-right order.
+ * \param dst_frames The destination buffer's capacity in frames. Receives the amount of frames written.
+ * \remark This function is not thread-safe.
  */
-int get_resample_len(int dst_freq, int src_freq, int src_bitrate, int src_len);
+void resample(int dst_freq, int src_freq, const int16_t *src, size_t &src_frames, int16_t *dst, size_t &dst_frames);
 } // namespace Resampler
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <capture/AudioRing.h>
+
 class Encoder
 {
   public:
@@ -35,6 +37,26 @@ class Encoder
          * \brief Ask the user for encoding settings
          */
         bool ask_for_encoding_settings;
+        /**
+         * \brief The capture session's audio ring, which the buffers passed to append_audio live in
+         */
+        AudioRing *audio_ring;
+    };
+
+    struct Stats
+    {
+        /**
+         * \brief The amount of video frames waiting to be written
+         */
+        size_t queued_video;
+        /**
+         * \brief The amount of audio buffers waiting to be written
+         */
+        size_t queued_audio;
+        /**
+         * \brief The amount of video frames which were dropped and replaced by a repeat of the previous frame
+         */
+        size_t dropped_frames;
     };
 
     /**
@@ -65,10 +87,20 @@ class Encoder
 
     /**
      * \brief Adds samples of audio data
-     * \param audio The audio buffer. Must be freed with the provided audio free function.
+     * \param audio The audio buffer, which is a chunk of the audio ring. The encoder reads it in place and must release
+     * it back to the ring once it's done with it, regardless of the operation's result.
      * \param length The audio length
      * \param bitrate The audio bitrate
      * \return Whether the operation succeeded
      */
     virtual bool append_audio(uint8_t *audio, size_t length, uint8_t bitrate) = 0;
+
+    /**
+     * \brief Gets the encoder's buffering statistics
+     * \remarks This method is thread-safe.
+     */
+    virtual Stats get_stats()
+    {
+        return {};
+    }
 };
@@ -8,6 +8,66 @@
 #include "FFmpegEncoder.h"
 #include <DialogService.h>
 #include <Config.h>
+#include <capture/EncodingManager.h>
+#include <PixelConversion.h>
+
+// Alignment of the pooled buffers.
+constexpr size_t BUFFER_ALIGNMENT = 64;
+
+// FFmpeg's names for the pixel formats selectable with ffmpeg_pixel_format.
+constexpr const wchar_t *PIXEL_FORMAT_NAMES[] = {L"bgr24", L"rgb24", L"yuv420p", L"nv12"};
+
+void FFmpegEncoder::pool_init(BufferPool &pool, const size_t count, const size_t buffer_size)
+{
+    pool.buffer_size = buffer_size;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto buf = static_cast<uint8_t *>(_aligned_malloc(buffer_size, BUFFER_ALIGNMENT));
+        if (!buf)
+        {
+            break;
+        }
+        pool.all.push_back(buf);
+    }
+    pool.free = pool.all;
+}
+
+void FFmpegEncoder::pool_destroy(BufferPool &pool)
+{
+    for (const auto buf : pool.all)
+    {
+        _aligned_free(buf);
+    }
+    pool.all.clear();
+    pool.free.clear();
+}
+
+uint8_t *FFmpegEncoder::pool_acquire(BufferPool &pool, const bool wait)
+{
+    std::unique_lock lock(pool.mutex);
+    if (wait)
+    {
+        pool.cv.wait(lock, [&] { return !pool.free.empty() || m_stop_thread; });
+    }
+
+    if (pool.free.empty())
+    {
+        return nullptr;
+    }
+
+    const auto buf = pool.free.back();
+    pool.free.pop_back();
+    return buf;
+}
+
+void FFmpegEncoder::pool_release(BufferPool &pool, uint8_t *buffer)
+{
+    {
+        std::lock_guard lock(pool.mutex);
+        pool.free.push_back(buffer);
+    }
+    pool.cv.notify_one();
+}
 
 std::optional<std::wstring> FFmpegEncoder::start(Params params)
 {
@@ -42,8 +102,19 @@ std::optional<std::wstring> FFmpegEncoder::start(Params params)
     static wchar_t options[4096]{};
     memset(options, 0, sizeof(options));
 
-    wsprintf(options, g_config.ffmpeg_final_options.data(), m_params.width, m_params.height, m_params.fps,
-             VIDEO_PIPE_NAME, m_params.arate, AUDIO_PIPE_NAME, m_params.path.wstring().data());
+    m_pixel_format = std::clamp(g_config.ffmpeg_pixel_format, 0, (int32_t)std::size(PIXEL_FORMAT_NAMES) - 1);
+
+    if (m_pixel_format == 0)
+    {
+        wsprintf(options, g_config.ffmpeg_final_options.data(), m_params.width, m_params.height, m_params.fps,
+                 VIDEO_PIPE_NAME, m_params.arate, AUDIO_PIPE_NAME, m_params.path.wstring().data());
+    }
+    else
+    {
+        wsprintf(options, g_config.ffmpeg_converted_final_options.data(), PIXEL_FORMAT_NAMES[m_pixel_format],
+                 m_params.width, m_params.height, m_params.fps, VIDEO_PIPE_NAME, m_params.arate, AUDIO_PIPE_NAME,
+                 m_params.path.wstring().data());
+    }
 
     g_view_logger->info(L"[FFmpegEncoder] Starting encode with commandline:");
     g_view_logger->info(L"[FFmpegEncoder] {}", options);
@@ -60,10 +131,42 @@ std::optional<std::wstring> FFmpegEncoder::start(Params params)
         return std::format(L"Failed to start ffmpeg process! Does ffmpeg exist on disk at '{}'?", g_config.ffmpeg_path);
     }
 
+    const size_t pixels = m_params.width * m_params.height;
+    const size_t chroma_size = ((m_params.width + 1) / 2) * ((m_params.height + 1) / 2);
+    m_frame_size = m_pixel_format >= 2 ? pixels + chroma_size * 2 : pixels * 3;
     m_silence_buffer = static_cast<uint8_t *>(calloc(params.arate, 1));
-    m_blank_buffer = static_cast<uint8_t *>(calloc(m_params.width * m_params.height * 3, 1));
+    m_blank_buffer = static_cast<uint8_t *>(calloc(m_frame_size, 1));
     m_dropped_frames = 0;
 
+    // A zeroed YUV frame is green rather than black, so the blank frame goes through the conversion too.
+    if (m_pixel_format >= 2)
+    {
+        const std::vector<uint8_t> black(pixels * 3);
+        convert_frame(black.data(), m_blank_buffer);
+    }
+
+    // At least two frames are needed, as the video thread holds on to the last written frame for repeating it.
+    pool_init(m_video_pool, std::max(g_config.ffmpeg_max_queued_frames, 2), m_frame_size);
+
+    if (g_config.ffmpeg_backpressure_mode == 2)
+    {
+        // The D mode flag makes the file temporary, so it's deleted once closed.
+        wchar_t temp_dir[MAX_PATH]{};
+        wchar_t spill_path[MAX_PATH]{};
+        GetTempPath(std::size(temp_dir), temp_dir);
+        GetTempFileName(temp_dir, L"mfs", 0, spill_path);
+        m_spill_file = _wfopen(spill_path, L"w+bD");
+        m_spill_read_buffer = static_cast<uint8_t *>(_aligned_malloc(m_frame_size, BUFFER_ALIGNMENT));
+        m_spill_write_buffer = static_cast<uint8_t *>(_aligned_malloc(m_frame_size, BUFFER_ALIGNMENT));
+        m_spill_write_offset = 0;
+        m_spilled_frames = 0;
+
+        if (!m_spill_file)
+        {
+            g_view_logger->error(L"[FFmpegEncoder] Failed to create spill file at {}", spill_path);
+        }
+    }
+
     m_video_thread = std::thread(&FFmpegEncoder::write_video_thread, this);
     m_audio_thread = std::thread(&FFmpegEncoder::write_audio_thread, this);
 
@@ -77,6 +180,7 @@ bool FFmpegEncoder::stop()
     m_stop_thread = true;
     m_video_cv.notify_all();
     m_audio_cv.notify_all();
+    m_video_pool.cv.notify_all();
 
     // HACK: Give it some time to maybe accept the last writes...
     Sleep(500);
@@ -103,13 +207,27 @@ bool FFmpegEncoder::stop()
 
     if (m_dropped_frames > 0)
     {
-        DialogService::show_dialog(std::format(L"{} frames were dropped during capture to avoid out-of-memory "
-                                               L"errors.\nThe capture might contain empty frames.",
-                                               m_dropped_frames)
+        DialogService::show_dialog(std::format(L"{} frames were dropped during capture because the encoder couldn't "
+                                               L"keep up.\nThe capture will contain repeated frames.",
+                                               m_dropped_frames.load())
                                        .c_str(),
                                    L"FFmpeg");
     }
 
+    m_video_queue = {};
+    m_audio_queue = {};
+    pool_destroy(m_video_pool);
+
+    if (m_spill_file)
+    {
+        fclose(m_spill_file);
+        m_spill_file = nullptr;
+    }
+    _aligned_free(m_spill_read_buffer);
+    m_spill_read_buffer = nullptr;
+    _aligned_free(m_spill_write_buffer);
+    m_spill_write_buffer = nullptr;
+
     free(m_silence_buffer);
     free(m_blank_buffer);
     return true;
@@ -131,24 +249,91 @@ static bool write_pipe_checked(const HANDLE pipe, const char *buffer, const unsi
 
 bool FFmpegEncoder::append_audio_impl(uint8_t *audio, size_t length)
 {
-    uint8_t *buf = m_silence_buffer;
-    if (audio != m_silence_buffer)
-    {
-        buf = static_cast<uint8_t *>(malloc(length));
-        memcpy(buf, audio, length);
-    }
-
     m_last_write_was_video = false;
 
+    // Audio is written to the pipe straight from the audio ring, and silence from the silence buffer. The ring chunk is
+    // released by the audio thread once written.
     {
         std::lock_guard lock(m_audio_queue_mutex);
-        this->m_audio_queue.emplace(buf, length);
+        m_audio_queue.push(QueueItem{.buffer = audio, .length = length});
     }
     m_audio_cv.notify_one();
 
     return true;
 }
 
+void FFmpegEncoder::push_video(const QueueItem &item)
+{
+    {
+        std::lock_guard lock(m_video_queue_mutex);
+        m_video_queue.push(item);
+    }
+    m_video_cv.notify_one();
+}
+
+bool FFmpegEncoder::spill_video(uint8_t *image, QueueItem &item)
+{
+    std::lock_guard lock(m_spill_mutex);
+
+    if (!m_spill_file)
+    {
+        return false;
+    }
+
+    // The file is rewound whenever the video thread caught up with it, so it only grows as far as the backlog does.
+    if (m_spilled_frames == 0)
+    {
+        m_spill_write_offset = 0;
+    }
+
+    const uint8_t *frame = image;
+    if (m_pixel_format != 0)
+    {
+        convert_frame(image, m_spill_write_buffer);
+        frame = m_spill_write_buffer;
+    }
+
+    _fseeki64(m_spill_file, m_spill_write_offset, SEEK_SET);
+    if (fwrite(frame, 1, m_frame_size, m_spill_file) != m_frame_size)
+    {
+        return false;
+    }
+
+    item.spill_offset = m_spill_write_offset;
+    m_spill_write_offset += m_frame_size;
+    m_spilled_frames++;
+    return true;
+}
+
+void FFmpegEncoder::convert_frame(const uint8_t *image, uint8_t *dst) const
+{
+    using namespace PixelConversion;
+
+    // Captured frames are bottom-up BGR24, which is passed through as-is and flipped by FFmpeg's vflip filter. The
+    // other formats are flipped here, which spares FFmpeg the extra filter pass.
+    const size_t width = m_params.width;
+    const size_t height = m_params.height;
+    const size_t pixels = width * height;
+    const size_t chroma_size = ((width + 1) / 2) * ((height + 1) / 2);
+
+    switch (m_pixel_format)
+    {
+    case 1:
+        swap_rb24(image, dst, pixels);
+        flip_vertical(dst, width * 3, height);
+        break;
+    case 2:
+        rgb24_to_i420(image, width, height, ByteOrder::BGR, true, dst, dst + pixels, dst + pixels + chroma_size);
+        break;
+    case 3:
+        rgb24_to_nv12(image, width, height, ByteOrder::BGR, true, dst, dst + pixels);
+        break;
+    default:
+        memcpy(dst, image, m_frame_size);
+        break;
+    }
+}
+
 bool FFmpegEncoder::append_video(uint8_t *image)
 {
     if (g_config.synchronization_mode == 1)
@@ -160,49 +345,60 @@ bool FFmpegEncoder::append_video(uint8_t *image)
     }
     else if (g_config.synchronization_mode == 2)
     {
-        if (g_main_ctx.core_ctx->vr_get_lag_count() > 2)
+        if (EncodingManager::get_frame_lag_count() > 2)
         {
             const auto samples_per_frame = static_cast<double>(m_params.arate) / 64;
-            append_audio_impl(m_silence_buffer, static_cast<size_t>(round(samples_per_frame)));
+            append_audio_impl(nullptr, static_cast<size_t>(round(samples_per_frame)));
         }
     }
 
     m_last_write_was_video = true;
 
-    auto buf = static_cast<uint8_t *>(malloc(m_params.width * m_params.height * 3));
+    QueueItem item{.buffer = pool_acquire(m_video_pool, g_config.ffmpeg_backpressure_mode == 0),
+                   .length = m_frame_size};
 
-    // HACK: If we run out of memory, we start writing empty video frames
-    // This can happen when encoding at high resolutions, as ffmpeg might not start processing the pipe writes in time
-    if (!buf)
+    if (item.buffer)
     {
-        g_view_logger->error("[FFmpegEncoder] Out of memory, writing blank video frame");
-        ++m_dropped_frames;
-
-        {
-            std::lock_guard lock(m_video_queue_mutex);
-            m_video_queue.emplace(m_blank_buffer, false);
-        }
-        m_video_cv.notify_one();
+        convert_frame(image, item.buffer);
+        push_video(item);
         return true;
     }
 
-    memcpy(buf, image, m_params.width * m_params.height * 3);
+    if (m_stop_thread)
+    {
+        return false;
+    }
 
+    // The pool is exhausted because ffmpeg isn't keeping up. Park the frame on disk if allowed, otherwise drop it and
+    // repeat the previous one to keep the stream's timing intact.
+    if (g_config.ffmpeg_backpressure_mode == 2 && spill_video(image, item))
     {
-        std::lock_guard lock(m_video_queue_mutex);
-        m_video_queue.emplace(buf, true);
+        push_video(item);
+        return true;
     }
-    m_video_cv.notify_one();
 
+    ++m_dropped_frames;
+    push_video(item);
     return true;
 }
 
 bool FFmpegEncoder::append_audio(uint8_t *audio, size_t length, uint8_t)
 {
-    auto buf = static_cast<uint8_t *>(malloc(length));
-    memcpy(buf, audio, length);
+    return append_audio_impl(audio, length);
+}
 
-    return append_audio_impl(buf, length);
+Encoder::Stats FFmpegEncoder::get_stats()
+{
+    Stats stats{.dropped_frames = m_dropped_frames};
+    {
+        std::lock_guard lock(m_video_queue_mutex);
+        stats.queued_video = m_video_queue.size();
+    }
+    {
+        std::lock_guard lock(m_audio_queue_mutex);
+        stats.queued_audio = m_audio_queue.size();
+    }
+    return stats;
 }
 
 void FFmpegEncoder::write_audio_thread()
@@ -216,17 +412,14 @@ void FFmpegEncoder::write_audio_thread()
 
         if (this->m_audio_queue.empty()) continue;
 
-        auto tuple = this->m_audio_queue.front();
+        const auto item = this->m_audio_queue.front();
         this->m_audio_queue.pop();
         lock.unlock();
 
-        const auto buf = std::get<0>(tuple);
-        const auto len = std::get<1>(tuple);
-
-        write_pipe_checked(m_audio_pipe, (char *)buf, len, false);
-        if (buf != m_silence_buffer)
+        write_pipe_checked(m_audio_pipe, (char *)(item.buffer ? item.buffer : m_silence_buffer), item.length, false);
+        if (item.buffer)
         {
-            free(buf);
+            m_params.audio_ring->release(item.buffer);
         }
     }
 }
@@ -235,6 +428,11 @@ void FFmpegEncoder::write_video_thread()
 {
     g_view_logger->trace("[FFmpegEncoder] Video thread ready");
 
+    // The last written frame, kept around for repeating it when frames are dropped. Holds on to its pooled buffer until
+    // a newer frame arrives.
+    const uint8_t *last_frame = m_blank_buffer;
+    uint8_t *last_pooled_frame = nullptr;
+
     while (!this->m_stop_thread)
     {
         std::unique_lock lock(m_video_queue_mutex);
@@ -242,14 +440,36 @@ void FFmpegEncoder::write_video_thread()
 
         if (m_video_queue.empty()) continue;
 
-        auto pair = this->m_video_queue.front();
+        const auto item = this->m_video_queue.front();
         this->m_video_queue.pop();
         lock.unlock();
 
-        write_pipe_checked(m_video_pipe, (char *)pair.first, m_params.width * m_params.height * 3, true);
-        if (pair.second)
+        const uint8_t *frame = last_frame;
+
+        if (item.buffer)
+        {
+            frame = item.buffer;
+        }
+        else if (item.spill_offset >= 0)
+        {
+            std::lock_guard spill_lock(m_spill_mutex);
+            _fseeki64(m_spill_file, item.spill_offset, SEEK_SET);
+            frame = fread(m_spill_read_buffer, 1, m_frame_size, m_spill_file) == m_frame_size ? m_spill_read_buffer
+                                                                                             : m_blank_buffer;
+            m_spilled_frames--;
+        }
+
+        write_pipe_checked(m_video_pipe, (char *)frame, m_frame_size, true);
+
+        if (frame != last_frame && last_pooled_frame)
+        {
+            pool_release(m_video_pool, last_pooled_frame);
+            last_pooled_frame = nullptr;
+        }
+        if (item.buffer)
         {
-            free(pair.first);
+            last_pooled_frame = item.buffer;
         }
+        last_frame = frame;
     }
 }
@@ -15,13 +15,59 @@ class FFmpegEncoder : public Encoder
     bool stop() override;
     bool append_video(uint8_t *image) override;
     bool append_audio(uint8_t *audio, size_t length, uint8_t bitrate) override;
+    Stats get_stats() override;
 
   private:
+    /**
+     * \brief A chunk of data queued for writing to one of the pipes.
+     */
+    struct QueueItem
+    {
+        /**
+         * \brief The buffer holding the data, which is pooled for video items and an audio ring chunk for audio items,
+         * or null if the data lives elsewhere.
+         */
+        uint8_t *buffer;
+
+        /**
+         * \brief The data's length.
+         */
+        size_t length;
+
+        /**
+         * \brief The data's offset in the spill file, or -1 if it isn't spilled. A null buffer without spilled data
+         * means silence for audio items and a repeat of the previous frame for video items.
+         */
+        int64_t spill_offset = -1;
+    };
+
+    /**
+     * \brief A fixed set of recycled, aligned buffers.
+     */
+    struct BufferPool
+    {
+        std::vector<uint8_t *> all;
+        std::vector<uint8_t *> free;
+        size_t buffer_size{};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    static void pool_init(BufferPool &pool, size_t count, size_t buffer_size);
+    static void pool_destroy(BufferPool &pool);
+    uint8_t *pool_acquire(BufferPool &pool, bool wait);
+    static void pool_release(BufferPool &pool, uint8_t *buffer);
+
     bool append_audio_impl(uint8_t *audio, size_t length);
+    void push_video(const QueueItem &item);
+    bool spill_video(uint8_t *image, QueueItem &item);
+    void convert_frame(const uint8_t *image, uint8_t *dst) const;
     void write_video_thread();
     void write_audio_thread();
 
     Params m_params{};
+    int32_t m_pixel_format{};
+    size_t m_frame_size{};
 
     STARTUPINFO m_si{};
     PROCESS_INFORMATION m_pi{};
@@ -30,7 +76,16 @@ class FFmpegEncoder : public Encoder
 
     uint8_t *m_silence_buffer{};
     uint8_t *m_blank_buffer{};
-    size_t m_dropped_frames = 0;
+    std::atomic<size_t> m_dropped_frames = 0;
+
+    BufferPool m_video_pool{};
+
+    std::mutex m_spill_mutex{};
+    FILE *m_spill_file{};
+    int64_t m_spill_write_offset{};
+    size_t m_spilled_frames{};
+    uint8_t *m_spill_read_buffer{};
+    uint8_t *m_spill_write_buffer{};
 
     bool m_stop_thread = false;
     bool m_last_write_was_video = false;
@@ -38,10 +93,10 @@ class FFmpegEncoder : public Encoder
     std::thread m_audio_thread;
     std::mutex m_audio_queue_mutex{};
     std::condition_variable m_audio_cv{};
-    std::queue<std::tuple<uint8_t *, size_t>> m_audio_queue;
+    std::queue<QueueItem> m_audio_queue;
 
     std::thread m_video_thread;
     std::mutex m_video_queue_mutex{};
     std::condition_variable m_video_cv{};
-    std::queue<std::pair<uint8_t *, bool>> m_video_queue;
+    std::queue<QueueItem> m_video_queue;
 };
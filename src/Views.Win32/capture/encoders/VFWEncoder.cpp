@@ -119,7 +119,7 @@ std::optional<std::wstring> VFWEncoder::start(Params params)
     }
 
     memset(m_sound_buf_empty, 0, sizeof(m_sound_buf_empty));
-    memset(m_sound_buf, 0, sizeof(m_sound_buf));
+    sound_buf_pos = 0;
     last_sound = 0;
 
     return std::nullopt;
@@ -127,7 +127,7 @@ std::optional<std::wstring> VFWEncoder::start(Params params)
 
 bool VFWEncoder::stop_impl(const bool fail_stop)
 {
-    write_sound(nullptr, 0, RESAMPLED_FREQ, RESAMPLED_FREQ * 2, TRUE, 16);
+    write_sound(nullptr, 0, true, 16);
 
     if (m_compressed_video_stream)
     {
@@ -223,8 +223,6 @@ bool VFWEncoder::append_video(uint8_t *image)
 
 bool VFWEncoder::append_audio(uint8_t *audio, size_t length, uint8_t bitrate)
 {
-    const int write_size = m_params.arate * 2;
-
     if (g_config.synchronization_mode == static_cast<int>(EncodingManager::Sync::Video) ||
         g_config.synchronization_mode == static_cast<int>(EncodingManager::Sync::None))
     {
@@ -251,16 +249,16 @@ bool VFWEncoder::append_audio(uint8_t *audio, size_t length, uint8_t bitrate)
                                                   g_main_ctx.core_ctx->vr_get_rom_header()->Country_code)) *
                        (int)desync;
             len3 <<= 2;
-            const int empty_size = len3 > write_size ? write_size : len3;
+            const int empty_size = len3 > SOUND_BUF_SIZE ? SOUND_BUF_SIZE : len3;
 
             for (int i = 0; i < empty_size; i += 4) *reinterpret_cast<long *>(m_sound_buf_empty + i) = last_sound;
 
-            while (len3 > write_size)
+            while (len3 > SOUND_BUF_SIZE)
             {
-                write_sound(m_sound_buf_empty, write_size, m_params.arate, write_size, FALSE, bitrate);
-                len3 -= write_size;
+                write_sound(m_sound_buf_empty, SOUND_BUF_SIZE, false, bitrate);
+                len3 -= SOUND_BUF_SIZE;
             }
-            write_sound(m_sound_buf_empty, len3, m_params.arate, write_size, FALSE, bitrate);
+            write_sound(m_sound_buf_empty, len3, false, bitrate);
         }
         else if (desync <= -10.0)
         {
@@ -268,72 +266,91 @@ bool VFWEncoder::append_audio(uint8_t *audio, size_t length, uint8_t bitrate)
         }
     }
 
-    write_sound(audio, length, m_params.arate, write_size, FALSE, bitrate);
+    const bool result = write_sound(audio, (int)length, false, bitrate);
     last_sound = *(reinterpret_cast<long *>(audio + length) - 1);
 
+    m_params.audio_ring->release(audio);
+
+    return result;
+}
+
+bool VFWEncoder::flush_sound()
+{
+    if (sound_buf_pos == 0)
+    {
+        return true;
+    }
+
+    if ((sound_buf_pos % 4) != 0)
+    {
+        g_view_logger->info("[EncodingManager]: Warning: Possible stereo sound error detected.\n");
+    }
+
+    const BOOL ok = (0 == AVIStreamWrite(m_sound_stream, m_sample, sound_buf_pos / m_sound_format.nBlockAlign,
+                                         m_sound_buf, sound_buf_pos, 0, NULL, NULL));
+    m_sample += sound_buf_pos / m_sound_format.nBlockAlign;
+    m_avi_file_size += sound_buf_pos;
+    sound_buf_pos = 0;
+
+    if (!ok)
+    {
+        DialogService::show_dialog(L"Audio output failure!\nA call to addAudioData() (AVIStreamWrite) "
+                                   L"failed.\nPerhaps you ran out of memory?",
+                                   L"AVI Encoder", fsvc_error);
+        return false;
+    }
+
     return true;
 }
 
-bool VFWEncoder::write_sound(uint8_t *buf, int len, const int min_write_size, const int max_write_size,
-                             const BOOL force, uint8_t bitrate)
+bool VFWEncoder::write_sound(const uint8_t *buf, const int len, const bool force, const uint8_t bitrate)
 {
-    if ((len <= 0 && !force) || len > max_write_size) return false;
+    if (len > 0 && bitrate != 16)
+    {
+        g_view_logger->error("[AVIEncoder] Audio bitrate is {} bits when it should be {} bits", bitrate, 16);
+        return true;
+    }
 
-    if (sound_buf_pos + len > min_write_size || force)
+    // The input is resampled straight from the caller's buffer, so only the resampled output is staged here.
+    auto src = reinterpret_cast<const int16_t *>(buf);
+    size_t frames = len > 0 ? len / 4 : 0;
+    while (frames > 0)
     {
-        int len2 = Resampler::get_resample_len(RESAMPLED_FREQ, m_params.arate, bitrate, sound_buf_pos);
-        if ((len2 % 8) == 0 || len > max_write_size)
+        size_t consumed = frames;
+        size_t written = (SOUND_BUF_SIZE - sound_buf_pos) / 4;
+        Resampler::resample(RESAMPLED_FREQ, m_params.arate, src, consumed,
+                            reinterpret_cast<int16_t *>(m_sound_buf + sound_buf_pos), written);
+
+        src += consumed * 2;
+        frames -= consumed;
+        sound_buf_pos += (int)written * 4;
+
+        if (consumed == 0 && written == 0 && sound_buf_pos == 0)
         {
-            static short *buf2 = nullptr;
-            len2 = Resampler::resample(&buf2, RESAMPLED_FREQ, reinterpret_cast<short *>(m_sound_buf), m_params.arate,
-                                       bitrate, sound_buf_pos);
+            break;
+        }
 
-            if (len2 > 0)
+        if (sound_buf_pos >= SOUND_FLUSH_SIZE || (consumed == 0 && written == 0))
+        {
+            if (!flush_sound())
             {
-                if ((len2 % 4) != 0)
-                {
-                    g_view_logger->info("[EncodingManager]: Warning: Possible stereo sound error detected.\n");
-                    fprintf(stderr, "[EncodingManager]: Warning: Possible stereo sound error detected.\n");
-                }
-
-                const BOOL ok = (0 == AVIStreamWrite(m_sound_stream, m_sample, len2 / m_sound_format.nBlockAlign, buf2,
-                                                     len2, 0, NULL, NULL));
-                m_sample += len2 / m_sound_format.nBlockAlign;
-                m_avi_file_size += len2;
-
-                if (!ok)
-                {
-                    DialogService::show_dialog(L"Audio output failure!\nA call to addAudioData() (AVIStreamWrite) "
-                                               L"failed.\nPerhaps you ran out of memory?",
-                                               L"AVI Encoder", fsvc_error);
-                    return false;
-                }
+                return false;
             }
-            sound_buf_pos = 0;
         }
     }
 
-    if (len <= 0)
+    if (len > 0)
     {
-        return true;
+        m_audio_frame +=
+            ((len / 4) / (long double)m_params.arate) *
+            g_main_ctx.core_ctx->vr_get_vis_per_second(g_main_ctx.core_ctx->vr_get_rom_header()->Country_code);
     }
 
-    if (static_cast<unsigned int>(sound_buf_pos + len) > SOUND_BUF_SIZE * sizeof(char))
+    if (force)
     {
-        DialogService::show_dialog(L"Sound buffer overflow!\nCapture will be stopped.", L"AVI Encoder", fsvc_error);
-        return false;
+        return flush_sound();
     }
 
-#ifdef _DEBUG
-    long double pro = (long double)(sound_buf_pos + len) * 100 / (SOUND_BUF_SIZE * sizeof(char));
-    if (pro > 75) g_view_logger->warn("Audio buffer almost full ({:.0f}%)!", pro);
-#endif
-
-    memcpy(m_sound_buf + sound_buf_pos, (char *)buf, len);
-    sound_buf_pos += len;
-    m_audio_frame += ((len / 4) / (long double)m_params.arate) *
-                     g_main_ctx.core_ctx->vr_get_vis_per_second(g_main_ctx.core_ctx->vr_get_rom_header()->Country_code);
-
     return true;
 }
 
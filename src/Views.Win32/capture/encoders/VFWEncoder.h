@@ -19,12 +19,16 @@ class VFWEncoder final : public Encoder
     bool append_audio(uint8_t *audio, size_t length, uint8_t bitrate) override;
 
   private:
-    // 44100=1s sample, soundbuffer capable of holding 4s future data in circular buffer
+    // 44100=1s sample, soundbuffer capable of holding 1s of resampled data
     static constexpr auto SOUND_BUF_SIZE = 44100 * 2 * 2;
     static constexpr auto MAX_AVI_SIZE = 0x7B9ACA00;
     static constexpr auto RESAMPLED_FREQ = 44100;
 
-    bool write_sound(uint8_t *buf, int len, int min_write_size, int max_write_size, BOOL force, uint8_t bitrate);
+    // Amount of resampled data to accumulate before writing it to the stream
+    static constexpr auto SOUND_FLUSH_SIZE = RESAMPLED_FREQ;
+
+    bool write_sound(const uint8_t *buf, int len, bool force, uint8_t bitrate);
+    bool flush_sound();
     bool append_video_impl(uint8_t *image);
     bool save_options() const;
     bool load_options();
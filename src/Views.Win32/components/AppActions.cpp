@@ -347,18 +347,14 @@ static void undo_load_state()
     ThreadPool::submit_task([=] {
         g_main_ctx.core_ctx->vr_wait_decrement();
 
-        std::vector<uint8_t> buf{};
-        g_main_ctx.core_ctx->st_get_undo_savestate(buf);
-
-        if (buf.empty())
+        if (g_main_ctx.core_ctx->st_get_undo_count() == 0)
         {
             Statusbar::post(L"No load to undo");
             return;
         }
 
-        (void)g_main_ctx.core_ctx->st_do_memory(
-            buf, core_st_job_load,
-            [](const core_st_callback_info &info, auto) {
+        (void)g_main_ctx.core_ctx->st_undo(
+            1, [](const core_st_callback_info &info, auto) {
                 if (info.result == Res_Ok)
                 {
                     Statusbar::post(L"Undid load");
@@ -371,8 +367,7 @@ static void undo_load_state()
                 }
 
                 Statusbar::post(L"Failed to undo load");
-            },
-            false);
+            });
     });
 }
 
@@ -8,53 +8,110 @@
 #include "Compare.h"
 
 static uint8_t compare_mode = 0;
-static size_t compare_interval = 0;
 
-void Compare::start(bool control, size_t interval)
+// Whether the expected log was loaded and is being compared against, and whether a difference was already reported.
+static bool has_reference = false;
+static bool reported = false;
+
+static std::filesystem::path get_log_path(const bool control)
 {
-    compare_mode = control ? 1 : 2;
-    compare_interval = interval;
+    return Config::save_directory() / (control ? L"cmp_expected.synclog" : L"cmp_actual.synclog");
 }
 
-void Compare::compare(size_t current_sample)
+/**
+ * \brief Reports the first difference from the expected log, if one was found since the last call.
+ */
+static void report_divergence()
 {
-    if (compare_mode == 0)
+    if (!has_reference || reported)
     {
         return;
     }
 
-    if (current_sample % compare_interval != 0)
+    const auto divergence = g_main_ctx.core_ctx->sl_get_divergence();
+    if (divergence.sample == SIZE_MAX)
     {
         return;
     }
 
-    const auto save_dir = Config::save_directory();
+    reported = true;
+    g_view_logger->error("DIFFERENCE at frame {} in {} sections", divergence.sample, divergence.sections.size());
+    for (const auto section : divergence.sections)
+    {
+        g_view_logger->error(L"  {}", g_main_ctx.core_ctx->sl_get_section_name(section));
+    }
+}
+
+static void finish()
+{
+    const bool control = compare_mode == 1;
+    compare_mode = 0;
+
+    g_main_ctx.core_ctx->sl_stop();
 
-    if (compare_mode == 2)
+    const auto path = get_log_path(control);
+    if (!g_main_ctx.core_ctx->sl_save(path))
     {
-        if (current_sample > compare_interval * 2)
-        {
-            const auto expected_path = save_dir / std::format(L"cmp_expected_{}.st", current_sample - compare_interval);
-            const auto actual_path = save_dir / std::format(L"cmp_actual_{}.st", current_sample - compare_interval);
+        g_view_logger->error(L"Failed to write sync log to {}", path.wstring());
+        return;
+    }
 
-            if (g_main_ctx.io_service.files_are_equal(expected_path, actual_path))
-            {
-                g_view_logger->info("MATCH at frame {}", current_sample - compare_interval);
-            }
-            else
-            {
-                g_view_logger->error("DIFFERENCE at frame {}", current_sample - compare_interval);
-            }
-        }
+    if (control)
+    {
+        g_view_logger->info(L"Wrote expected sync log to {}", path.wstring());
+        return;
+    }
 
-        const auto actual_path = save_dir / std::format(L"cmp_actual_{}.st", current_sample);
-        g_main_ctx.core_ctx->st_do_file(actual_path.c_str(), core_st_job_save, nullptr, true);
+    report_divergence();
+    if (!has_reference || reported)
+    {
+        return;
+    }
 
+    core_sl_log actual{};
+    g_main_ctx.core_ctx->sl_get_log(actual);
+    g_view_logger->info("MATCH across {} checkpoints", actual.entries.size());
+}
+
+void Compare::start(bool control, size_t interval)
+{
+    compare_mode = control ? 1 : 2;
+    has_reference = false;
+    reported = false;
+    g_main_ctx.core_ctx->sl_start(interval);
+
+    if (control)
+    {
+        return;
+    }
+
+    // Checkpoints are compared against the expected log as they're taken, so a difference is reported right away.
+    core_sl_log expected{};
+    if (!g_main_ctx.core_ctx->sl_load(get_log_path(true), expected))
+    {
+        g_view_logger->error("Failed to read the expected sync log");
+        return;
+    }
+
+    g_main_ctx.core_ctx->sl_set_reference(expected);
+    has_reference = true;
+}
+
+void Compare::compare(size_t current_sample)
+{
+    if (compare_mode == 0)
+    {
+        return;
+    }
+
+    report_divergence();
+
+    if (current_sample < g_main_ctx.core_ctx->vcr_get_length_samples())
+    {
         return;
     }
 
-    const auto path = save_dir / std::format(L"cmp_expected_{}.st", current_sample);
-    g_main_ctx.core_ctx->st_do_file(path.c_str(), core_st_job_save, nullptr, true);
+    finish();
 }
 
 bool Compare::active()
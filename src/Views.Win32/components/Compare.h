@@ -7,23 +7,28 @@
 #pragma once
 
 /**
- * A module responsible for comparison of expected and actual savestates during movie playback. Used for regression
+ * A module responsible for comparison of expected and actual machine states during movie playback. Used for regression
  * testing.
+ *
+ * Both runs record a sync log of per-section machine state hashes via the core. When the movie ends, the control run
+ * writes its log to the saves directory, while the actual run diffs its log against it and reports the first divergent
+ * frame along with the differing sections.
  */
 namespace Compare
 {
 /**
  * \brief Starts a comparison.
- * \param control Whether the comparison is deemed the control (the correct sequence of savestates).
+ * \param control Whether the comparison is deemed the control (the correct sequence of machine states).
  * \param interval The comparison interval.
  */
 void start(bool control, size_t interval);
 
 /**
- * \brief Performs the comparison between the expected and actual savestates at the current sample.
+ * \brief Notifies the comparison system about the current sample changing. Finishes the comparison once the movie's
+ * last sample is reached.
  * \param current_sample The VCR's current sample.
- * \warning Requires corresponding savestates to be present in the saves directory. Note that they are not checked for
- * ROM or movie congruence.
+ * \warning The actual run requires the control run's sync log to be present in the saves directory. Note that it is
+ * not checked for ROM or movie congruence.
  */
 void compare(size_t current_sample);
 
@@ -745,7 +745,8 @@ std::vector<t_options_group> get_static_option_groups()
         .type = t_options_item::Type::Number,
         .group_id = capture_group.id,
         .name = L"Delay",
-        .tooltip = L"Miliseconds to wait before capturing a frame. Useful for syncing with external programs.",
+        .tooltip = L"Miliseconds to wait before capturing a frame. Useful for syncing with external programs.\nOnly "
+                   L"applies to the Window and Desktop capture modes.",
         GENPROPS(int32_t, capture_delay),
     });
     capture_group.items.emplace_back(t_options_item{
@@ -818,6 +819,57 @@ std::vector<t_options_group> get_static_option_groups()
         GENPROPS(std::wstring, ffmpeg_final_options),
         .is_readonly = [] { return EncodingManager::is_capturing(); },
     });
+    capture_group.items.emplace_back(t_options_item{
+        .type = t_options_item::Type::Enum,
+        .group_id = capture_group.id,
+        .name = L"FFmpeg Pixel Format",
+        .tooltip = L"The pixel format frames are handed to FFmpeg in.\nBGR24 - Frames are passed as captured and "
+                   L"FFmpeg flips them\nRGB24, I420, NV12 - Frames are converted and flipped before being passed, "
+                   L"using the Converted Arguments",
+        GENPROPS(int32_t, ffmpeg_pixel_format),
+        .possible_values =
+            {
+                std::make_pair(L"BGR24", 0),
+                std::make_pair(L"RGB24", 1),
+                std::make_pair(L"I420", 2),
+                std::make_pair(L"NV12", 3),
+            },
+        .is_readonly = [] { return EncodingManager::is_capturing(); },
+    });
+    capture_group.items.emplace_back(t_options_item{
+        .type = t_options_item::Type::String,
+        .group_id = capture_group.id,
+        .name = L"FFmpeg Converted Arguments",
+        .tooltip = L"The argument format string to be passed to FFmpeg when capturing with a pixel format other than "
+                   L"BGR24.\nThe first placeholder receives the pixel format's name.",
+        GENPROPS(std::wstring, ffmpeg_converted_final_options),
+        .is_readonly = [] { return EncodingManager::is_capturing(); },
+    });
+    capture_group.items.emplace_back(t_options_item{
+        .type = t_options_item::Type::Number,
+        .group_id = capture_group.id,
+        .name = L"FFmpeg Max Queued Frames",
+        .tooltip = L"The maximum amount of video frames buffered in memory while FFmpeg is busy.\nHigher numbers "
+                   L"absorb longer encoder stalls at the cost of memory usage.",
+        GENPROPS(int32_t, ffmpeg_max_queued_frames),
+        .is_readonly = [] { return EncodingManager::is_capturing(); },
+    });
+    capture_group.items.emplace_back(t_options_item{
+        .type = t_options_item::Type::Enum,
+        .group_id = capture_group.id,
+        .name = L"FFmpeg Backpressure",
+        .tooltip = L"What to do when FFmpeg can't keep up and all frame buffers are in use.\nBlock - Emulation waits "
+                   L"for FFmpeg\nDrop - The frame is dropped and the previous one is repeated\nSpill - The frame is "
+                   L"buffered in a temporary file",
+        GENPROPS(int32_t, ffmpeg_backpressure_mode),
+        .possible_values =
+            {
+                std::make_pair(L"Block", 0),
+                std::make_pair(L"Drop", 1),
+                std::make_pair(L"Spill", 2),
+            },
+        .is_readonly = [] { return EncodingManager::is_capturing(); },
+    });
 
     core_group.items.emplace_back(t_options_item{
         .type = t_options_item::Type::Enum,
@@ -842,6 +894,14 @@ std::vector<t_options_group> get_static_option_groups()
         .tooltip = L"Whether undo savestate load functionality is enabled.",
         GENPROPS(int32_t, core.st_undo_load),
     });
+    core_group.items.emplace_back(t_options_item{
+        .type = t_options_item::Type::Number,
+        .group_id = core_group.id,
+        .name = L"Undo Savestate Max Count",
+        .tooltip = L"The maximum amount of savestate loads which can be undone.\nUndo savestates are compressed and "
+                   L"share identical data, but higher numbers will still increase memory usage.",
+        GENPROPS(int32_t, core.st_undo_max_count),
+    });
     core_group.items.emplace_back(t_options_item{
         .type = t_options_item::Type::Number,
         .group_id = core_group.id,
@@ -869,6 +929,7 @@ std::vector<t_options_group> get_static_option_groups()
         .name = L"Emulate Float Crashes",
         .tooltip = L"Emulate float operation-related crashes which would also crash on real hardware",
         GENPROPS(int32_t, core.float_exception_emulation),
+        .is_readonly = [] { return g_main_ctx.core_ctx->vr_get_launched(); },
     });
     core_group.items.emplace_back(t_options_item{
         .type = t_options_item::Type::Number,
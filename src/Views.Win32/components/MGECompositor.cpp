@@ -8,6 +8,7 @@
 #include <components/MGECompositor.h>
 #include <Plugin.h>
 #include <Messenger.h>
+#include <PixelConversion.h>
 
 using Microsoft::WRL::ComPtr;
 constexpr auto CONTROL_CLASS_NAME = L"game_control";
@@ -267,25 +268,9 @@ static void render_and_present()
 
 static void copy_rgb24_buffer_to_rgb32()
 {
-    const auto src = static_cast<const uint8_t *>(mge_context.buffer);
-    const auto dst = static_cast<uint8_t *>(mge_context.rgba_buffer);
-
-    const int width = mge_context.width;
-    const int height = mge_context.height;
-
-    for (int y = 0; y < height; ++y)
-    {
-        const uint8_t *srow = src + y * width * 3;
-        uint8_t *drow = dst + y * width * 4;
-
-        for (int x = 0; x < width; ++x)
-        {
-            std::memcpy(drow, srow, 3);
-
-            srow += 3;
-            drow += 4;
-        }
-    }
+    PixelConversion::rgb24_to_rgba32(static_cast<const uint8_t *>(mge_context.buffer),
+                                     static_cast<uint8_t *>(mge_context.rgba_buffer),
+                                     (size_t)mge_context.width * mge_context.height);
 }
 
 static void recreate_mge_context_d3d()
@@ -15,6 +15,12 @@ namespace PianoRoll
 #pragma region Variables
 const auto JOYSTICK_CLASS = L"PianoRollJoystick";
 
+// Unchanged runs shorter than this are folded into the surrounding edit when diffing inputs.
+constexpr size_t HISTORY_EDIT_MERGE_GAP = 16;
+
+// Every n-th history entry stores a full copy of the inputs, which bounds the cost of jumping far through the history.
+constexpr size_t HISTORY_CHECKPOINT_INTERVAL = 50;
+
 // The piano roll dispatcher.
 std::shared_ptr<Dispatcher> g_piano_roll_dispatcher;
 
@@ -45,6 +51,35 @@ struct PianoRollState
     std::vector<size_t> selected_indicies;
 };
 
+// A contiguous range of inputs replaced by an edit.
+struct PianoRollEdit
+{
+    // The index of the first replaced input.
+    size_t start;
+
+    // The inputs in the range before and after the edit. The sizes differ if inputs were inserted or deleted.
+    std::vector<core_buttons> before;
+    std::vector<core_buttons> after;
+};
+
+// An entry in the piano roll history.
+struct PianoRollHistoryEntry
+{
+    // The edits which turn the previous entry's inputs into this entry's inputs, in ascending order. Unused for the
+    // oldest entry.
+    std::vector<PianoRollEdit> edits;
+
+    // Selected indicies at the time of the entry.
+    std::vector<size_t> selected_indicies;
+
+    // A full copy of this entry's inputs, or empty if this entry isn't a checkpoint.
+    std::optional<std::vector<core_buttons>> checkpoint;
+
+    // The number of entries pushed before this one since the history was started. Unlike the entry's index, this
+    // doesn't shift when old entries are evicted, so checkpoints keep being spaced evenly.
+    size_t sequence;
+};
+
 // Whether the current copy of the VCR inputs is desynced from the remote one.
 bool g_inputs_different;
 
@@ -93,12 +128,15 @@ bool g_joy_drag = false;
 // The current piano roll state.
 PianoRollState g_piano_roll_state;
 
-// State history for the piano roll. Used by undo/redo.
-std::deque<PianoRollState> g_piano_roll_history;
+// State history for the piano roll, stored as edits between consecutive states. Used by undo/redo.
+std::deque<PianoRollHistoryEntry> g_piano_roll_history;
 
-// Stack index for the piano roll undo/redo stack. 0 = top, 1 = 2nd from top, etc...
+// Index of the current entry in the piano roll history. 0 = oldest.
 size_t g_piano_roll_state_index;
 
+// The inputs of the current history entry, which the history's edits are applied to when moving through it.
+std::vector<core_buttons> g_piano_roll_history_inputs;
+
 // Copy of seek savestate frame map from VCR.
 std::unordered_map<size_t, bool> g_seek_savestate_frames;
 
@@ -391,6 +429,155 @@ void update_history_listbox()
     SetWindowRedraw(g_hist_hwnd, true);
 }
 
+/**
+ * Computes the edits which turn one input buffer into another.
+ */
+std::vector<PianoRollEdit> diff_inputs(const std::vector<core_buttons> &before, const std::vector<core_buttons> &after)
+{
+    const auto equal = [](const core_buttons &a, const core_buttons &b) { return a.value == b.value; };
+
+    std::vector<PianoRollEdit> edits;
+
+    if (before.size() != after.size())
+    {
+        // Inserts and deletes shift everything behind them, so we describe those as one edit between the common
+        // prefix and suffix.
+        const size_t min_size = std::min(before.size(), after.size());
+
+        size_t prefix = 0;
+        while (prefix < min_size && equal(before[prefix], after[prefix]))
+        {
+            ++prefix;
+        }
+
+        size_t suffix = 0;
+        while (suffix < min_size - prefix &&
+               equal(before[before.size() - 1 - suffix], after[after.size() - 1 - suffix]))
+        {
+            ++suffix;
+        }
+
+        edits.push_back({.start = prefix,
+                         .before = {before.begin() + prefix, before.end() - suffix},
+                         .after = {after.begin() + prefix, after.end() - suffix}});
+        return edits;
+    }
+
+    size_t i = 0;
+    while (i < before.size())
+    {
+        if (equal(before[i], after[i]))
+        {
+            ++i;
+            continue;
+        }
+
+        const size_t start = i;
+        size_t end = i + 1;
+        for (size_t j = end; j < before.size() && j - end < HISTORY_EDIT_MERGE_GAP; ++j)
+        {
+            if (!equal(before[j], after[j]))
+            {
+                end = j + 1;
+            }
+        }
+
+        edits.push_back({.start = start,
+                         .before = {before.begin() + start, before.begin() + end},
+                         .after = {after.begin() + start, after.begin() + end}});
+        i = end;
+    }
+
+    return edits;
+}
+
+/**
+ * Applies edits to an input buffer, either forwards (before -> after) or backwards (after -> before).
+ */
+void apply_edits(std::vector<core_buttons> &inputs, const std::vector<PianoRollEdit> &edits, const bool forward)
+{
+    const auto apply = [&](const PianoRollEdit &edit) {
+        const auto &from = forward ? edit.before : edit.after;
+        const auto &to = forward ? edit.after : edit.before;
+
+        const auto it = inputs.begin() + edit.start;
+        if (from.size() == to.size())
+        {
+            std::ranges::copy(to, it);
+            return;
+        }
+
+        inputs.insert(inputs.erase(it, it + from.size()), to.begin(), to.end());
+    };
+
+    if (forward)
+    {
+        std::ranges::for_each(edits, apply);
+    }
+    else
+    {
+        std::ranges::for_each(edits | std::views::reverse, apply);
+    }
+}
+
+/**
+ * Gets the amount of inputs touched when moving through the history from one index to another.
+ */
+size_t get_history_walk_cost(const size_t from, const size_t to)
+{
+    size_t cost = 0;
+    for (size_t i = std::min(from, to) + 1; i <= std::max(from, to); ++i)
+    {
+        for (const auto &edit : g_piano_roll_history[i].edits)
+        {
+            cost += edit.before.size() + edit.after.size();
+        }
+    }
+    return cost;
+}
+
+/**
+ * Moves g_piano_roll_history_inputs to the specified history index, starting from the cheaper of the current index and
+ * the nearest checkpoint.
+ */
+void seek_history_inputs(const size_t index)
+{
+    size_t from = g_piano_roll_state_index;
+    size_t cost = get_history_walk_cost(from, index);
+
+    for (size_t i = 0; i < g_piano_roll_history.size(); ++i)
+    {
+        const auto &checkpoint = g_piano_roll_history[i].checkpoint;
+        if (!checkpoint.has_value())
+        {
+            continue;
+        }
+
+        const size_t checkpoint_cost = checkpoint->size() + get_history_walk_cost(i, index);
+        if (checkpoint_cost < cost)
+        {
+            from = i;
+            cost = checkpoint_cost;
+        }
+    }
+
+    if (from != g_piano_roll_state_index)
+    {
+        g_piano_roll_history_inputs = g_piano_roll_history[from].checkpoint.value();
+    }
+
+    for (size_t i = from; i < index; ++i)
+    {
+        apply_edits(g_piano_roll_history_inputs, g_piano_roll_history[i + 1].edits, true);
+    }
+    for (size_t i = from; i > index; --i)
+    {
+        apply_edits(g_piano_roll_history_inputs, g_piano_roll_history[i].edits, false);
+    }
+
+    g_piano_roll_state_index = index;
+}
+
 /**
  * Pushes the current piano roll state to the history. Should be called after operations which change the piano roll
  * state.
@@ -399,13 +586,38 @@ void push_state_to_history()
 {
     g_view_logger->info("[PianoRoll] Pushing state to undo stack...");
 
-    if (g_piano_roll_history.size() > g_config.piano_roll_undo_stack_size)
+    PianoRollHistoryEntry entry{.selected_indicies = g_piano_roll_state.selected_indicies};
+
+    if (g_piano_roll_history.empty())
+    {
+        g_piano_roll_history_inputs = g_piano_roll_state.inputs;
+        entry.sequence = 0;
+    }
+    else
+    {
+        // Pushing a new state discards the states which were undone.
+        g_piano_roll_history.erase(g_piano_roll_history.begin() + g_piano_roll_state_index + 1,
+                                   g_piano_roll_history.end());
+
+        entry.edits = diff_inputs(g_piano_roll_history_inputs, g_piano_roll_state.inputs);
+        apply_edits(g_piano_roll_history_inputs, entry.edits, true);
+        entry.sequence = g_piano_roll_history.back().sequence + 1;
+    }
+
+    if (entry.sequence % HISTORY_CHECKPOINT_INTERVAL == HISTORY_CHECKPOINT_INTERVAL - 1)
+    {
+        entry.checkpoint = g_piano_roll_history_inputs;
+    }
+
+    g_piano_roll_history.push_back(std::move(entry));
+
+    while (g_piano_roll_history.size() > (size_t)std::max(g_config.piano_roll_undo_stack_size, 1))
     {
-        g_piano_roll_history.pop_back();
+        g_piano_roll_history.pop_front();
+        g_piano_roll_history.front().edits.clear();
     }
 
-    g_piano_roll_history.push_back(g_piano_roll_state);
-    g_piano_roll_state_index = std::min(g_piano_roll_state_index + 1, g_piano_roll_history.size() - 1);
+    g_piano_roll_state_index = g_piano_roll_history.size() - 1;
 
     g_view_logger->info("[PianoRoll] Undo stack size: {}. Current index: {}.", g_piano_roll_history.size(),
                         g_piano_roll_state_index);
@@ -493,8 +705,9 @@ bool shift_history(int offset)
         return false;
     }
 
-    g_piano_roll_state_index = new_index;
-    set_piano_roll_state(g_piano_roll_history[g_piano_roll_state_index]);
+    seek_history_inputs(new_index);
+    set_piano_roll_state({.inputs = g_piano_roll_history_inputs,
+                          .selected_indicies = g_piano_roll_history[new_index].selected_indicies});
 
     return true;
 }
@@ -1415,8 +1628,9 @@ LRESULT CALLBACK dialog_proc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
                 break;
             }
 
-            g_piano_roll_state_index = index;
-            set_piano_roll_state(g_piano_roll_history[index]);
+            seek_history_inputs(index);
+            set_piano_roll_state({.inputs = g_piano_roll_history_inputs,
+                                  .selected_indicies = g_piano_roll_history[index].selected_indicies});
         }
         break;
     case WM_NOTIFY: {
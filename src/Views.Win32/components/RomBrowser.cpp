@@ -12,6 +12,7 @@
 #include <components/Statusbar.h>
 #include <components/AppActions.h>
 #include <Messenger.h>
+#include <BS_thread_pool.hpp>
 
 using t_rombrowser_entry = struct s_rombrowser_entry
 {
@@ -20,13 +21,195 @@ using t_rombrowser_entry = struct s_rombrowser_entry
     core_rom_header rom_header;
 };
 
+/**
+ * \brief An entry in the rombrowser index, which remembers the headers of previously scanned ROMs.
+ */
+struct t_rom_index_entry
+{
+    uint64_t size;
+    uint64_t write_time;
+    uint8_t header[0x40];
+};
+
+constexpr auto ROM_INDEX_FILE_NAME = L"rombrowser.idx";
+constexpr uint32_t ROM_INDEX_MAGIC = 0x58444952; // RIDX
+constexpr uint32_t ROM_INDEX_VERSION = 1;
+
+// Header reads are IO-bound, especially on network shares, so the scan uses more threads than the shared pool.
+constexpr size_t SCAN_THREAD_COUNT = 8;
+
+// Interval at which scanned ROMs are added to the list while a scan is running.
+constexpr auto SCAN_FLUSH_INTERVAL = std::chrono::milliseconds(100);
+
 HWND rombrowser_hwnd = nullptr;
 std::vector<t_rombrowser_entry *> rombrowser_entries;
 
+std::unordered_map<std::wstring, t_rom_index_entry> rom_index;
+std::mutex rom_index_mutex;
+bool rom_index_loaded = false;
+bool rom_index_dirty = false;
+
 namespace RomBrowser
 {
 std::mutex rombrowser_mutex;
 
+static std::filesystem::path get_rom_index_path()
+{
+    return g_main_ctx.app_path / ROM_INDEX_FILE_NAME;
+}
+
+/**
+ * \brief Loads the rombrowser index from disk if that hasn't happened yet. The caller must hold rom_index_mutex.
+ */
+static void load_rom_index()
+{
+    if (rom_index_loaded)
+    {
+        return;
+    }
+    rom_index_loaded = true;
+
+    auto buf = g_main_ctx.io_service.read_file_buffer(get_rom_index_path());
+    if (buf.size() < sizeof(uint32_t) * 3)
+    {
+        return;
+    }
+
+    uint8_t *ptr = buf.data();
+    const uint8_t *end = buf.data() + buf.size();
+
+    uint32_t magic, version, count;
+    MiscHelpers::memread(&ptr, &magic, sizeof(magic));
+    MiscHelpers::memread(&ptr, &version, sizeof(version));
+    MiscHelpers::memread(&ptr, &count, sizeof(count));
+
+    if (magic != ROM_INDEX_MAGIC || version != ROM_INDEX_VERSION)
+    {
+        g_view_logger->info("[Rombrowser] Ignoring incompatible index");
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t path_len;
+        if ((size_t)(end - ptr) < sizeof(path_len))
+        {
+            break;
+        }
+        MiscHelpers::memread(&ptr, &path_len, sizeof(path_len));
+
+        if ((size_t)(end - ptr) < path_len * sizeof(wchar_t) + sizeof(t_rom_index_entry))
+        {
+            break;
+        }
+
+        std::wstring path(path_len, L'\0');
+        MiscHelpers::memread(&ptr, path.data(), path_len * sizeof(wchar_t));
+
+        t_rom_index_entry entry{};
+        MiscHelpers::memread(&ptr, &entry, sizeof(entry));
+
+        rom_index[path] = entry;
+    }
+
+    g_view_logger->info("[Rombrowser] Loaded index with {} entries", rom_index.size());
+}
+
+/**
+ * \brief Writes the rombrowser index to disk if it changed. The caller must hold rom_index_mutex.
+ */
+static void save_rom_index()
+{
+    if (!rom_index_dirty)
+    {
+        return;
+    }
+    rom_index_dirty = false;
+
+    std::vector<uint8_t> buf;
+    const auto count = (uint32_t)rom_index.size();
+    MiscHelpers::vecwrite(buf, &ROM_INDEX_MAGIC, sizeof(ROM_INDEX_MAGIC));
+    MiscHelpers::vecwrite(buf, &ROM_INDEX_VERSION, sizeof(ROM_INDEX_VERSION));
+    MiscHelpers::vecwrite(buf, &count, sizeof(count));
+
+    for (const auto &[path, entry] : rom_index)
+    {
+        const auto path_len = (uint32_t)path.size();
+        MiscHelpers::vecwrite(buf, &path_len, sizeof(path_len));
+        MiscHelpers::vecwrite(buf, path.data(), path_len * sizeof(wchar_t));
+        MiscHelpers::vecwrite(buf, &entry, sizeof(entry));
+    }
+
+    if (!g_main_ctx.io_service.write_file_buffer(get_rom_index_path(), buf))
+    {
+        g_view_logger->error("[Rombrowser] Failed to write index");
+    }
+}
+
+/**
+ * \brief Reads the size and header of a ROM. The file is only opened if it changed since it was last indexed.
+ * \param path The ROM's path.
+ * \param entry The entry to fill in. Only the part of the header before the boot code is filled in.
+ * \return Whether the ROM could be read.
+ */
+static bool read_rom_entry(const std::wstring &path, t_rombrowser_entry &entry)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes{};
+    if (!GetFileAttributesEx(path.c_str(), GetFileExInfoStandard, &attributes))
+    {
+        g_view_logger->info(L"[Rombrowser] Failed to read file '{}'. Skipping!\n", path.c_str());
+        return false;
+    }
+
+    t_rom_index_entry index_entry{};
+    index_entry.size = (uint64_t)attributes.nFileSizeHigh << 32 | attributes.nFileSizeLow;
+    index_entry.write_time =
+        (uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32 | attributes.ftLastWriteTime.dwLowDateTime;
+
+    entry.path = path;
+    entry.size = index_entry.size;
+    entry.rom_header = {};
+
+    {
+        std::lock_guard lock(rom_index_mutex);
+        load_rom_index();
+
+        const auto it = rom_index.find(path);
+        if (it != rom_index.end() && it->second.size == index_entry.size &&
+            it->second.write_time == index_entry.write_time)
+        {
+            memcpy(&entry.rom_header, it->second.header, sizeof(it->second.header));
+            return true;
+        }
+    }
+
+    FILE *f = nullptr;
+    if (_wfopen_s(&f, path.c_str(), L"rb"))
+    {
+        g_view_logger->info(L"[Rombrowser] Failed to read file '{}'. Skipping!\n", path.c_str());
+        return false;
+    }
+
+    if (index_entry.size > sizeof(core_rom_header) &&
+        fread(index_entry.header, sizeof(index_entry.header), 1, f) == 1)
+    {
+        g_main_ctx.core_ctx->vr_byteswap(index_entry.header);
+        memcpy(&entry.rom_header, index_entry.header, sizeof(index_entry.header));
+    }
+    else
+    {
+        memset(index_entry.header, 0, sizeof(index_entry.header));
+    }
+
+    fclose(f);
+
+    std::lock_guard lock(rom_index_mutex);
+    rom_index[path] = index_entry;
+    rom_index_dirty = true;
+
+    return true;
+}
+
 std::vector<std::wstring> find_available_roms()
 {
     std::vector<std::wstring> rom_paths;
@@ -197,6 +380,29 @@ int32_t rombrowser_country_code_to_image_index(uint16_t country_code)
     }
 }
 
+/**
+ * \brief Appends entries to the rombrowser. Must be called on the UI thread.
+ */
+static void add_entries(const std::vector<t_rombrowser_entry *> &entries)
+{
+    LV_ITEM lv_item = {0};
+    lv_item.mask = LVIF_TEXT | LVIF_IMAGE | LVIF_PARAM;
+    lv_item.pszText = LPSTR_TEXTCALLBACK;
+
+    for (const auto entry : entries)
+    {
+        const int32_t i = rombrowser_entries.size();
+        rombrowser_entries.push_back(entry);
+
+        lv_item.lParam = i;
+        lv_item.iItem = i;
+        lv_item.iImage = rombrowser_country_code_to_image_index(entry->rom_header.Country_code);
+        ListView_InsertItem(rombrowser_hwnd, &lv_item);
+    }
+
+    rombrowser_update_sort();
+}
+
 void build_impl()
 {
     std::unique_lock lock(rombrowser_mutex, std::try_to_lock);
@@ -208,70 +414,74 @@ void build_impl()
 
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    // we disable redrawing because it would repaint after every added rom
-    // otherwise, which is slow and causes flicker
-    SendMessage(rombrowser_hwnd, WM_SETREDRAW, FALSE, 0);
-
-    ListView_DeleteAllItems(rombrowser_hwnd);
-    for (auto entry : rombrowser_entries)
-    {
-        delete entry;
-    }
-    rombrowser_entries.clear();
-
-    auto rom_paths = find_available_roms();
-
-    LV_ITEM lv_item = {0};
-    lv_item.mask = LVIF_TEXT | LVIF_IMAGE | LVIF_PARAM;
-    lv_item.pszText = LPSTR_TEXTCALLBACK;
-
-    int32_t i = 0;
-    for (auto &path : rom_paths)
-    {
-        FILE *f = nullptr;
-        if (_wfopen_s(&f, path.c_str(), L"rb"))
+    g_main_ctx.dispatcher->invoke([] {
+        ListView_DeleteAllItems(rombrowser_hwnd);
+        for (auto entry : rombrowser_entries)
         {
-            g_view_logger->info(L"[Rombrowser] Failed to read file '{}'. Skipping!\n", path.c_str());
-            continue;
+            delete entry;
         }
+        rombrowser_entries.clear();
+    });
 
-        fseek(f, 0, SEEK_END);
-        const size_t len = ftell(f);
-        fseek(f, 0, SEEK_SET);
+    const auto rom_paths = find_available_roms();
 
-        auto rombrowser_entry = new t_rombrowser_entry;
-        rombrowser_entry->path = path;
-        rombrowser_entry->size = len;
-        rombrowser_entry->rom_header = {};
+    // The headers are read in parallel, and the results are added to the list in batches while the scan is running.
+    std::vector<t_rombrowser_entry *> pending_entries;
+    std::mutex pending_entries_mutex;
 
-        if (len > sizeof(core_rom_header))
+    const auto flush_pending_entries = [&] {
+        std::vector<t_rombrowser_entry *> entries;
         {
-            core_rom_header header{};
-            fread(&header, sizeof(core_rom_header), 1, f);
-
-            g_main_ctx.core_ctx->vr_byteswap((uint8_t *)&header);
+            std::lock_guard pending_lock(pending_entries_mutex);
+            entries.swap(pending_entries);
+        }
 
-            MiscHelpers::strtrim((char *)header.nom, sizeof(header.nom));
+        if (!entries.empty())
+        {
+            g_main_ctx.dispatcher->invoke([&] { add_entries(entries); });
+        }
+    };
 
-            // We need this for later, because listview assumes it has a nul
-            // terminator
-            header.nom[sizeof(header.nom) - 1] = '\0';
+    {
+        BS::thread_pool pool(SCAN_THREAD_COUNT);
 
-            rombrowser_entry->rom_header = header;
+        for (const auto &path : rom_paths)
+        {
+            pool.detach_task([&] {
+                auto entry = new t_rombrowser_entry;
+                if (!read_rom_entry(path, *entry))
+                {
+                    delete entry;
+                    return;
+                }
+
+                MiscHelpers::strtrim((char *)entry->rom_header.nom, sizeof(entry->rom_header.nom));
+
+                // We need this for later, because listview assumes it has a nul
+                // terminator
+                entry->rom_header.nom[sizeof(entry->rom_header.nom) - 1] = '\0';
+
+                std::lock_guard pending_lock(pending_entries_mutex);
+                pending_entries.push_back(entry);
+            });
         }
 
-        lv_item.lParam = i;
-        lv_item.iItem = i;
-        lv_item.iImage = rombrowser_country_code_to_image_index(rombrowser_entry->rom_header.Country_code);
-        ListView_InsertItem(rombrowser_hwnd, &lv_item);
+        while (!pool.wait_for(SCAN_FLUSH_INTERVAL))
+        {
+            flush_pending_entries();
+        }
+    }
 
-        fclose(f);
+    flush_pending_entries();
 
-        rombrowser_entries.push_back(rombrowser_entry);
-        i++;
+    {
+        // Drop index entries for ROMs which are gone, so the index doesn't grow forever.
+        std::lock_guard index_lock(rom_index_mutex);
+        const std::unordered_set<std::wstring> found_paths(rom_paths.begin(), rom_paths.end());
+        rom_index_dirty |=
+            std::erase_if(rom_index, [&](const auto &pair) { return !found_paths.contains(pair.first); }) > 0;
+        save_rom_index();
     }
-    rombrowser_update_sort();
-    SendMessage(rombrowser_hwnd, WM_SETREDRAW, TRUE, 0);
 
     g_view_logger->info("Rombrowser loading took {}ms",
                         static_cast<int>((std::chrono::high_resolution_clock::now() - start_time).count() / 1'000'000));
@@ -393,41 +603,28 @@ notify(LPARAM lparam)
 
 std::wstring find_available_rom(const std::function<bool(const core_rom_header &)> &predicate)
 {
+    std::wstring result;
+
     auto rom_paths = find_available_roms();
     for (auto rom_path : rom_paths)
     {
-        FILE *f = nullptr;
-        if (_wfopen_s(&f, rom_path.c_str(), L"rb"))
+        t_rombrowser_entry entry{};
+        if (!read_rom_entry(rom_path, entry) || entry.size <= sizeof(core_rom_header))
         {
-            g_view_logger->info(L"[Rombrowser] Failed to read file '{}'. Skipping!\n", rom_path.c_str());
             continue;
         }
 
-        fseek(f, 0, SEEK_END);
-        uint64_t len = ftell(f);
-        fseek(f, 0, SEEK_SET);
-
-        if (len > sizeof(core_rom_header))
+        if (predicate(entry.rom_header))
         {
-            auto header = (core_rom_header *)malloc(sizeof(core_rom_header));
-            fread(header, sizeof(core_rom_header), 1, f);
-
-            g_main_ctx.core_ctx->vr_byteswap((uint8_t *)header);
-
-            if (predicate(*header))
-            {
-                free(header);
-                fclose(f);
-                return rom_path;
-            }
-
-            free(header);
+            result = rom_path;
+            break;
         }
-
-        fclose(f);
     }
 
-    return L"";
+    std::lock_guard lock(rom_index_mutex);
+    save_rom_index();
+
+    return result;
 }
 
 void emu_launched_changed(std::any data)
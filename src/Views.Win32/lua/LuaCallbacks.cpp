@@ -26,6 +26,15 @@ struct t_atwindowmessage_context
 static t_atwindowmessage_context atwindowmessage_ctx{};
 static int current_input_n = 0;
 
+constexpr size_t CALLBACK_KEY_COUNT = LuaCallbacks::REG_ATWARPMODIFYSTATUSCHANGED + 1;
+
+// Amount of registered callbacks per key, split by whether they run on the UI thread (0) or directly on the emulation
+// thread (1). Lets the emulation thread skip the hop to the UI thread for events nobody is listening to.
+static std::atomic<int32_t> g_listener_counts[2][CALLBACK_KEY_COUNT]{};
+
+// Whether any environment has text in its pending_output.
+static std::atomic<bool> g_has_pending_output{};
+
 static int pcall_no_params(lua_State *L)
 {
     return lua_pcall(L, 0, 0, 0);
@@ -66,10 +75,233 @@ core_buttons LuaCallbacks::get_last_controller_data(int index)
     return g_last_controller_data[index];
 }
 
+/**
+ * \brief Gets whether the callbacks for a key may run directly on the emulation thread.
+ */
+static bool is_direct_key(const LuaCallbacks::callback_key key)
+{
+    switch (key)
+    {
+    case LuaCallbacks::REG_ATVI:
+    case LuaCallbacks::REG_ATINPUT:
+    case LuaCallbacks::REG_ATPLAYMOVIE:
+    case LuaCallbacks::REG_ATSTOPMOVIE:
+    case LuaCallbacks::REG_ATLOADSTATE:
+    case LuaCallbacks::REG_ATSAVESTATE:
+    case LuaCallbacks::REG_ATRESET:
+    case LuaCallbacks::REG_ATSEEKCOMPLETED:
+    case LuaCallbacks::REG_ATWARPMODIFYSTATUSCHANGED:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool runs_direct(const t_lua_environment *lua, const LuaCallbacks::callback_key key)
+{
+    return lua->direct_callbacks && is_direct_key(key);
+}
+
+static bool has_listeners(const LuaCallbacks::callback_key key, const bool direct)
+{
+    return g_listener_counts[direct][key].load(std::memory_order_relaxed) > 0;
+}
+
+static void adjust_listener_count(const t_lua_environment *lua, const LuaCallbacks::callback_key key,
+                                  const int32_t delta)
+{
+    g_listener_counts[runs_direct(lua, key)][key] += delta;
+}
+
+/**
+ * \brief Adds or removes all callbacks currently registered by an environment to or from the listener counts.
+ */
+static void adjust_listener_counts(const t_lua_environment *lua, const int32_t sign)
+{
+    lua_State *L = lua->L;
+
+    for (LuaCallbacks::callback_key key = 1; key < CALLBACK_KEY_COUNT; ++key)
+    {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, key);
+        if (lua_istable(L, -1))
+        {
+            adjust_listener_count(lua, key, sign * (int32_t)luaL_len(L, -1));
+        }
+        lua_pop(L, 1);
+    }
+}
+
+/**
+ * \brief Passes the text printed by direct callbacks to the environments' print callbacks. Must be called on the UI
+ * thread.
+ */
+static void flush_pending_output()
+{
+    if (!g_has_pending_output.exchange(false))
+    {
+        return;
+    }
+
+    std::lock_guard lock(g_lua_mutex);
+
+    for (const auto &lua : g_lua_environments)
+    {
+        if (lua->pending_output.empty())
+        {
+            continue;
+        }
+
+        const auto text = std::move(lua->pending_output);
+        lua->pending_output.clear();
+        lua->print(lua, text);
+    }
+}
+
+static bool invoke_callbacks_with_key_impl(const t_lua_environment *lua,
+                                           const std::function<int(lua_State *)> &function,
+                                           LuaCallbacks::callback_key key)
+{
+    RT_ASSERT(is_on_gui_thread() || runs_direct(lua, key), L"not on GUI thread");
+
+    std::lock_guard lock(g_lua_mutex);
+
+    lua_State *L = lua->L;
+
+    lua_rawgeti(L, LUA_REGISTRYINDEX, key);
+    if (lua_isnil(L, -1))
+    {
+        lua_pop(L, 1);
+        return true;
+    }
+
+    const lua_Integer n = luaL_len(L, -1);
+
+    for (lua_Integer i = 0; i < n; i++)
+    {
+        lua_pushinteger(L, 1 + i);
+        lua_gettable(L, -2);
+        if (function(L))
+        {
+            const char *str = lua_tostring(L, -1);
+            lua->print(lua, g_main_ctx.io_service.string_to_wstring(str) + L"\r\n");
+            g_view_logger->info("Lua error: {}", str);
+            return false;
+        }
+    }
+    lua_pop(L, 1);
+    return true;
+}
+
+/**
+ * \brief Invokes the callbacks with the specified key on all Lua instances.
+ * \param key The callback key.
+ * \param skip_direct Whether to skip the instances which already ran their callbacks for this key on the emulation
+ * thread.
+ */
+static void invoke_callbacks_on_instances(const LuaCallbacks::callback_key key, const bool skip_direct)
+{
+    // OPTIMIZATION: Store destruction-queued scripts in queue and destroy them after iteration to avoid having to clone
+    // the queue OPTIMIZATION: Make the destruction queue static to avoid allocating it every entry
+    static std::queue<t_lua_environment *> destruction_queue;
+
+    assert(destruction_queue.empty());
+
+    const auto function = get_function_for_callback(key);
+
+    for (const auto &lua : g_lua_environments)
+    {
+        if (skip_direct && runs_direct(lua, key))
+        {
+            continue;
+        }
+
+        if (!invoke_callbacks_with_key_impl(lua, function, key))
+        {
+            destruction_queue.push(lua);
+        }
+    }
+
+    while (!destruction_queue.empty())
+    {
+        LuaManager::destroy_environment(destruction_queue.front());
+        destruction_queue.pop();
+    }
+}
+
+/**
+ * \brief Invokes the callbacks with the specified key on all direct instances on the calling thread.
+ */
+static void invoke_direct_callbacks(const LuaCallbacks::callback_key key)
+{
+    if (!has_listeners(key, true))
+    {
+        return;
+    }
+
+    std::vector<t_lua_environment *> failed;
+    {
+        std::lock_guard lock(g_lua_mutex);
+
+        const auto function = get_function_for_callback(key);
+
+        for (const auto &lua : g_lua_environments)
+        {
+            if (!runs_direct(lua, key))
+            {
+                continue;
+            }
+
+            if (!invoke_callbacks_with_key_impl(lua, function, key))
+            {
+                failed.push_back(lua);
+            }
+        }
+    }
+
+    if (failed.empty())
+    {
+        return;
+    }
+
+    // Environments can only be torn down on the UI thread. The lock must not be held while waiting for it, as the UI
+    // thread might be about to run callbacks itself.
+    g_main_ctx.dispatcher->invoke([=] {
+        flush_pending_output();
+        for (const auto &lua : failed)
+        {
+            if (std::ranges::find(g_lua_environments, lua) != g_lua_environments.end())
+            {
+                LuaManager::destroy_environment(lua);
+            }
+        }
+    });
+}
+
+/**
+ * \brief Invokes the callbacks with the specified key, first on the direct instances on the calling thread and then on
+ * the remaining ones on the UI thread.
+ */
+static void invoke_callbacks(const LuaCallbacks::callback_key key)
+{
+    invoke_direct_callbacks(key);
+
+    if (!has_listeners(key, false))
+    {
+        return;
+    }
+
+    g_main_ctx.dispatcher->invoke([=] { invoke_callbacks_on_instances(key, true); });
+}
+
 void LuaCallbacks::call_window_message(void *wnd, unsigned int msg, unsigned int w, long l)
 {
     RET_IF_EMPTY;
 
+    if (!has_listeners(REG_WINDOWMESSAGE, false))
+    {
+        return;
+    }
+
     atwindowmessage_ctx = {.wnd = (HWND)wnd, .msg = msg, .w_param = w, .l_param = l};
 
     g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_WINDOWMESSAGE); });
@@ -77,8 +309,22 @@ void LuaCallbacks::call_window_message(void *wnd, unsigned int msg, unsigned int
 
 void LuaCallbacks::call_vi()
 {
+    g_vi_count++;
+
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_ATVI); });
+
+    invoke_direct_callbacks(REG_ATVI);
+
+    // The UI-bound atvi callbacks and the output of the direct callbacks since the last VI share a single hop.
+    if (!has_listeners(REG_ATVI, false) && !g_has_pending_output)
+    {
+        return;
+    }
+
+    g_main_ctx.dispatcher->invoke([] {
+        flush_pending_output();
+        invoke_callbacks_on_instances(REG_ATVI, true);
+    });
 }
 
 void LuaCallbacks::call_input(core_buttons *input, int index)
@@ -89,11 +335,18 @@ void LuaCallbacks::call_input(core_buttons *input, int index)
 
     RET_IF_EMPTY;
 
-    g_main_ctx.dispatcher->invoke([=] {
-        current_input_n = index;
-        invoke_callbacks_with_key_on_all_instances(REG_ATINPUT);
-        g_input_count++;
-    });
+    current_input_n = index;
+    invoke_direct_callbacks(REG_ATINPUT);
+
+    if (has_listeners(REG_ATINPUT, false))
+    {
+        g_main_ctx.dispatcher->invoke([=] {
+            current_input_n = index;
+            invoke_callbacks_on_instances(REG_ATINPUT, true);
+        });
+    }
+
+    g_input_count++;
 
     if (g_overwrite_controller_data[index])
     {
@@ -106,81 +359,59 @@ void LuaCallbacks::call_input(core_buttons *input, int index)
 void LuaCallbacks::call_interval()
 {
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_ATINTERVAL); });
+
+    // NOTE: No VIs arrive while paused, so the pending output is also flushed here.
+    if (!has_listeners(REG_ATINTERVAL, false) && !g_has_pending_output)
+    {
+        return;
+    }
+
+    g_main_ctx.dispatcher->invoke([] {
+        flush_pending_output();
+        invoke_callbacks_with_key_on_all_instances(REG_ATINTERVAL);
+    });
 }
 
 void LuaCallbacks::call_play_movie()
 {
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_ATPLAYMOVIE); });
+    invoke_callbacks(REG_ATPLAYMOVIE);
 }
 
 void LuaCallbacks::call_stop_movie()
 {
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_ATSTOPMOVIE); });
+    invoke_callbacks(REG_ATSTOPMOVIE);
 }
 
 void LuaCallbacks::call_load_state()
 {
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_ATLOADSTATE); });
+    invoke_callbacks(REG_ATLOADSTATE);
 }
 
 void LuaCallbacks::call_save_state()
 {
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_ATSAVESTATE); });
+    invoke_callbacks(REG_ATSAVESTATE);
 }
 
 void LuaCallbacks::call_reset()
 {
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_ATRESET); });
+    invoke_callbacks(REG_ATRESET);
 }
 
 void LuaCallbacks::call_seek_completed()
 {
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([] { invoke_callbacks_with_key_on_all_instances(REG_ATSEEKCOMPLETED); });
+    invoke_callbacks(REG_ATSEEKCOMPLETED);
 }
 
 void LuaCallbacks::call_warp_modify_status_changed(const int32_t status)
 {
     RET_IF_EMPTY;
-    g_main_ctx.dispatcher->invoke([=] { invoke_callbacks_with_key_on_all_instances(REG_ATWARPMODIFYSTATUSCHANGED); });
-}
-
-bool invoke_callbacks_with_key_impl(const t_lua_environment *lua, const std::function<int(lua_State *)> &function,
-                                    LuaCallbacks::callback_key key)
-{
-    RT_ASSERT(is_on_gui_thread(), L"not on GUI thread");
-
-    lua_State *L = lua->L;
-
-    lua_rawgeti(L, LUA_REGISTRYINDEX, key);
-    if (lua_isnil(L, -1))
-    {
-        lua_pop(L, 1);
-        return true;
-    }
-
-    const lua_Integer n = luaL_len(L, -1);
-
-    for (lua_Integer i = 0; i < n; i++)
-    {
-        lua_pushinteger(L, 1 + i);
-        lua_gettable(L, -2);
-        if (function(L))
-        {
-            const char *str = lua_tostring(L, -1);
-            lua->print(lua, g_main_ctx.io_service.string_to_wstring(str) + L"\r\n");
-            g_view_logger->info("Lua error: {}", str);
-            return false;
-        }
-    }
-    lua_pop(L, 1);
-    return true;
+    invoke_callbacks(REG_ATWARPMODIFYSTATUSCHANGED);
 }
 
 bool LuaCallbacks::invoke_callbacks_with_key(const t_lua_environment *lua, const callback_key key)
@@ -191,27 +422,34 @@ bool LuaCallbacks::invoke_callbacks_with_key(const t_lua_environment *lua, const
 
 void LuaCallbacks::invoke_callbacks_with_key_on_all_instances(callback_key key)
 {
-    // OPTIMIZATION: Store destruction-queued scripts in queue and destroy them after iteration to avoid having to clone
-    // the queue OPTIMIZATION: Make the destruction queue static to avoid allocating it every entry
-    static std::queue<t_lua_environment *> destruction_queue;
-
-    assert(destruction_queue.empty());
+    invoke_callbacks_on_instances(key, false);
+}
 
-    const auto function = get_function_for_callback(key);
+void LuaCallbacks::set_direct_callbacks(t_lua_environment *lua, const bool enabled)
+{
+    std::lock_guard lock(g_lua_mutex);
 
-    for (const auto &lua : g_lua_environments)
+    if (lua->direct_callbacks == enabled)
     {
-        if (!invoke_callbacks_with_key_impl(lua, function, key))
-        {
-            destruction_queue.push(lua);
-        }
+        return;
     }
 
-    while (!destruction_queue.empty())
-    {
-        LuaManager::destroy_environment(destruction_queue.front());
-        destruction_queue.pop();
-    }
+    adjust_listener_counts(lua, -1);
+    lua->direct_callbacks = enabled;
+    adjust_listener_counts(lua, 1);
+}
+
+void LuaCallbacks::queue_output(const t_lua_environment *lua, const std::wstring &text)
+{
+    std::lock_guard lock(g_lua_mutex);
+    lua->pending_output += text;
+    g_has_pending_output = true;
+}
+
+void LuaCallbacks::release_listeners(const t_lua_environment *lua)
+{
+    std::lock_guard lock(g_lua_mutex);
+    adjust_listener_counts(lua, -1);
 }
 
 static int register_function(lua_State *L, LuaCallbacks::callback_key key)
@@ -229,6 +467,7 @@ static int register_function(lua_State *L, LuaCallbacks::callback_key key)
     lua_pushvalue(L, -3); //
     lua_settable(L, -3);
     lua_pop(L, 1);
+    adjust_listener_count(LuaManager::get_environment_for_state(L), key, 1);
     return i;
 }
 
@@ -254,6 +493,7 @@ static void unregister_function(lua_State *L, LuaCallbacks::callback_key key)
             lua_pushinteger(L, 1 + i);
             lua_call(L, 2, 0);
             lua_pop(L, 2);
+            adjust_listener_count(LuaManager::get_environment_for_state(L), key, -1);
             return;
         }
         lua_pop(L, 1);
@@ -108,6 +108,27 @@ bool invoke_callbacks_with_key(const t_lua_environment *lua, callback_key key);
  */
 void invoke_callbacks_with_key_on_all_instances(callback_key key);
 
+/**
+ * \brief Sets whether the core event callbacks of a Lua environment run directly on the emulation thread.
+ * \param lua The Lua environment.
+ * \param enabled Whether direct callbacks are enabled.
+ */
+void set_direct_callbacks(t_lua_environment *lua, bool enabled);
+
+/**
+ * \brief Queues text printed by a Lua environment off the UI thread. The text is passed to the environment's print
+ * callback on the next VI.
+ * \param lua The Lua environment.
+ * \param text The printed text.
+ */
+void queue_output(const t_lua_environment *lua, const std::wstring &text);
+
+/**
+ * \brief Forgets all callbacks registered by a Lua environment. Must be called before the environment is destroyed.
+ * \param lua The Lua environment.
+ */
+void release_listeners(const t_lua_environment *lua);
+
 /**
  * \brief Subscribes to or unsubscribes from the specified callback based on the input parameters.
  * If the second value on the Lua stack is true, the function is unregistered. Otherwise, it is registered.
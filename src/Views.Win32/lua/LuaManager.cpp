@@ -16,7 +16,8 @@
 core_buttons g_last_controller_data[4]{};
 core_buttons g_new_controller_data[4]{};
 bool g_overwrite_controller_data[4]{};
-size_t g_input_count{};
+std::atomic<size_t> g_input_count{};
+std::atomic<size_t> g_vi_count{};
 
 std::string g_mupen_api_lua_code{};
 std::string g_inspect_lua_code{};
@@ -24,6 +25,7 @@ std::string g_shims_lua_code{};
 std::string g_sandbox_lua_code{};
 
 std::vector<t_lua_environment *> g_lua_environments{};
+std::recursive_mutex g_lua_mutex{};
 std::unordered_map<lua_State *, t_lua_environment *> g_lua_env_map{};
 std::unordered_map<void *, bool> g_valid_callback_tokens{};
 
@@ -171,7 +173,14 @@ std::expected<t_lua_environment *, std::wstring> LuaManager::create_environment(
 
     lua->path = path;
     lua->destroying = destroying_callback;
-    lua->print = print_callback;
+    lua->print = [=](const t_lua_environment *env, const std::wstring &text) {
+        if (!is_on_gui_thread())
+        {
+            LuaCallbacks::queue_output(env, text);
+            return;
+        }
+        print_callback(env, text);
+    };
     lua->rctx = LuaRenderer::default_rendering_context();
     lua->L = luaL_newstate();
 
@@ -189,6 +198,8 @@ std::expected<void, std::wstring> LuaManager::start_environment(t_lua_environmen
         return std::unexpected(L"Lua environment already started");
     }
 
+    std::lock_guard lock(g_lua_mutex);
+
     // We need to put it in the environment list before executing any user code so calls into the Mupen API...
     g_lua_environments.push_back(env);
     rebuild_lua_env_map();
@@ -255,6 +266,8 @@ void LuaManager::destroy_environment(t_lua_environment *lua)
 {
     RT_ASSERT(lua && lua->L, L"LuaManager::destroy_environment: Lua environment is already destroyed");
 
+    std::lock_guard lock(g_lua_mutex);
+
     LuaCallbacks::invoke_callbacks_with_key(lua, LuaCallbacks::REG_ATSTOP);
 
     lua->destroying(lua);
@@ -268,6 +281,8 @@ void LuaManager::destroy_environment(t_lua_environment *lua)
     }
     ActionManager::end_batch_work();
 
+    LuaCallbacks::release_listeners(lua);
+
     // NOTE: We must do this *after* calling atstop, as the lua environment still has to exist for that.
     // After this point, it's game over and no callbacks will be called anymore.
     std::erase_if(g_lua_environments, [=](const t_lua_environment *v) { return v == lua; });
@@ -113,6 +113,12 @@ bool luaL_checkboolean(lua_State *L, int i);
 
 extern std::vector<t_lua_environment *> g_lua_environments;
 
+/**
+ * \brief Guards the Lua states and the environment list against concurrent access by direct callbacks running on the
+ * emulation thread. Must be held whenever Lua code is executed.
+ */
+extern std::recursive_mutex g_lua_mutex;
+
 /**
  * \brief The controller data at time of the last input poll
  */
@@ -129,6 +135,11 @@ extern core_buttons g_new_controller_data[4];
 extern bool g_overwrite_controller_data[4];
 
 /**
- * \brief Amount of call_input calls.
+ * \brief Amount of call_input calls. Incremented on the emulation thread.
+ */
+extern std::atomic<size_t> g_input_count;
+
+/**
+ * \brief Amount of call_vi calls. Incremented on the emulation thread.
  */
-extern size_t g_input_count;
+extern std::atomic<size_t> g_vi_count;
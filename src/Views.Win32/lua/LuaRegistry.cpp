@@ -47,6 +47,7 @@ const luaL_Reg EMU_FUNCS[] = {{"console", LuaCore::Emu::ConsoleWriteLua},
                               {"atreset", LuaCore::Emu::subscribe_atreset},
                               {"atseekcompleted", LuaCore::Emu::subscribe_atseekcompleted},
                               {"atwarpmodifystatuschanged", LuaCore::Emu::subscribe_atwarpmodifystatuschanged},
+                              {"set_direct_callbacks", LuaCore::Emu::SetDirectCallbacks},
 
                               {"framecount", LuaCore::Emu::GetVICount},
                               {"samplecount", LuaCore::Emu::GetSampleCount},
@@ -100,6 +101,15 @@ const luaL_Reg MEMORY_FUNCS[] = {
     {"writedouble", LuaCore::Memory::write_double},
     {"writesize", LuaCore::Memory::write_size},
 
+    {"readrange", LuaCore::Memory::read_range},
+    {"writerange", LuaCore::Memory::write_range},
+    {"readarray", LuaCore::Memory::read_array},
+    {"readstruct", LuaCore::Memory::read_struct},
+
+    {"addwatch", LuaCore::Memory::add_watch},
+    {"clearwatches", LuaCore::Memory::clear_watches},
+    {"getwatches", LuaCore::Memory::get_watches},
+
     {"recompile", LuaCore::Memory::recompile},
     {"recompilenextall", LuaCore::Memory::recompile_all},
 
@@ -228,6 +238,39 @@ const luaL_Reg CLIPBOARD_FUNCS[] = {{"get", LuaCore::Clipboard::get},
 
 const std::pair<std::string, lua_CFunction> OVERRIDE_FUNCS[] = {{"os.exit", LuaCore::Global::Exit}};
 
+// Packages and functions which don't touch UI state and can thus be called from direct callbacks on the emulation
+// thread. All other functions are wrapped in ui_function_guard.
+const std::unordered_set<std::string> DIRECT_SAFE_PACKAGES = {"memory", "joypad"};
+const std::unordered_set<std::string> DIRECT_SAFE_FUNCS = {
+    "print", "tostringex", "stop", "emu.console", "emu.framecount", "emu.samplecount", "emu.inputcount",
+    "emu.getversion", "emu.getpause", "emu.getspeed", "emu.get_ff", "emu.getaddress", "emu.atvi", "emu.atinput",
+    "emu.atloadstate", "emu.atsavestate", "emu.atreset", "emu.atplaymovie", "emu.atstopmovie", "emu.atseekcompleted",
+    "emu.atwarpmodifystatuschanged"};
+
+static int ui_function_guard(lua_State *L)
+{
+    if (!is_on_gui_thread())
+    {
+        luaL_error(L, "%s can't be called from direct callbacks", lua_tostring(L, lua_upvalueindex(2)));
+    }
+    return lua_tocfunction(L, lua_upvalueindex(1))(L);
+}
+
+static void push_function(lua_State *L, const char *package, const char *name, const lua_CFunction func)
+{
+    const auto qualified_name = package ? std::format("{}.{}", package, name) : std::string(name);
+
+    lua_pushcfunction(L, func);
+
+    if ((package && DIRECT_SAFE_PACKAGES.contains(package)) || DIRECT_SAFE_FUNCS.contains(qualified_name))
+    {
+        return;
+    }
+
+    lua_pushstring(L, qualified_name.c_str());
+    lua_pushcclosure(L, ui_function_guard, 2);
+}
+
 void register_as_package(lua_State *lua_state, const char *name, const luaL_Reg regs[])
 {
     if (name == nullptr)
@@ -235,11 +278,18 @@ void register_as_package(lua_State *lua_state, const char *name, const luaL_Reg
         const luaL_Reg *p = regs;
         do
         {
-            lua_register(lua_state, p->name, p->func);
+            push_function(lua_state, nullptr, p->name, p->func);
+            lua_setglobal(lua_state, p->name);
         } while ((++p)->func);
         return;
     }
-    luaL_newlib(lua_state, regs);
+
+    lua_newtable(lua_state);
+    for (const luaL_Reg *p = regs; p->func; ++p)
+    {
+        push_function(lua_state, name, p->name, p->func);
+        lua_setfield(lua_state, -2, p->name);
+    }
     lua_setglobal(lua_state, name);
 }
 
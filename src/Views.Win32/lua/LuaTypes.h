@@ -69,6 +69,20 @@ struct t_lua_rendering_context
     int bkmode{};
 };
 
+/**
+ * \brief Describes a memory address watched by a Lua environment.
+ */
+struct t_lua_memory_watch
+{
+    uint32_t address;
+
+    // The value's type, as a memory.readstruct type character.
+    char type;
+
+    // The raw value at the time of the last snapshot.
+    uint64_t value;
+};
+
 /**
  * \brief Describes a Lua instance.
  */
@@ -82,6 +96,19 @@ struct t_lua_environment
     t_lua_rendering_context rctx;
     bool started{};
 
+    // Whether core event callbacks (atinput, atvi, ...) run directly on the emulation thread instead of on the UI thread.
+    // Set via emu.set_direct_callbacks. UI functions raise an error when called from such callbacks.
+    bool direct_callbacks{};
+
+    // Text printed from direct callbacks, which is flushed to the print callback on the UI thread once per VI.
+    mutable std::wstring pending_output{};
+
+    // The memory watches added via memory.addwatch.
+    std::vector<t_lua_memory_watch> memory_watches{};
+
+    // The VI count at the time the memory watches were last snapshotted.
+    size_t memory_watches_vi = SIZE_MAX;
+
     // All the actions registered by the script. Stored so we can remove them when the script is destroyed.
     std::vector<ActionManager::action_path> registered_actions{};
 
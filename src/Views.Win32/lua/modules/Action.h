@@ -32,6 +32,8 @@ static ActionManager::t_action_params check_action_params(lua_State *L, int inde
     if (on_press)
     {
         params.on_press = [=] {
+            std::lock_guard lock(g_lua_mutex);
+
             if (!LuaManager::get_environment_for_state(L))
             {
                 return;
@@ -50,6 +52,8 @@ static ActionManager::t_action_params check_action_params(lua_State *L, int inde
     if (on_release)
     {
         params.on_release = [=] {
+            std::lock_guard lock(g_lua_mutex);
+
             if (!LuaManager::get_environment_for_state(L))
             {
                 return;
@@ -68,6 +72,8 @@ static ActionManager::t_action_params check_action_params(lua_State *L, int inde
     if (get_display_name)
     {
         params.get_display_name = [=] -> std::wstring {
+            std::lock_guard lock(g_lua_mutex);
+
             if (!LuaManager::get_environment_for_state(L))
             {
                 return L"";
@@ -90,6 +96,8 @@ static ActionManager::t_action_params check_action_params(lua_State *L, int inde
     if (get_enabled)
     {
         params.get_enabled = [=] -> bool {
+            std::lock_guard lock(g_lua_mutex);
+
             if (!LuaManager::get_environment_for_state(L))
             {
                 return false;
@@ -117,6 +125,8 @@ static ActionManager::t_action_params check_action_params(lua_State *L, int inde
     if (get_active)
     {
         params.get_active = [=] -> bool {
+            std::lock_guard lock(g_lua_mutex);
+
             if (!LuaManager::get_environment_for_state(L))
             {
                 return false;
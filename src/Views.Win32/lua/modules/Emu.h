@@ -116,6 +116,13 @@ static int subscribe_atwarpmodifystatuschanged(lua_State *L)
     return 0;
 }
 
+static int SetDirectCallbacks(lua_State *L)
+{
+    auto lua = LuaManager::get_environment_for_state(L);
+    LuaCallbacks::set_direct_callbacks(lua, luaL_checkboolean(L, 1));
+    return 0;
+}
+
 static int Screenshot(lua_State *L)
 {
     g_plugin_funcs.video_capture_screen((char *)luaL_checkstring(L, 1));
@@ -277,6 +277,306 @@ template <> static ULONGLONG CheckT<ULONGLONG>(lua_State *L, int i)
     return LuaCheckQWord(L, i);
 }
 
+// Bulk functions
+
+// Upper bound for the length of a single bulk access, which is the size of the largest RDRAM configuration.
+constexpr size_t MAX_BULK_LENGTH = CORE_ADDR_MASK + 1;
+
+/**
+ * \brief Gets the size of a memory.readstruct type character, or 0 if the character isn't a valid type.
+ */
+static size_t get_type_size(const char type)
+{
+    switch (type)
+    {
+    case 'x':
+    case 'b':
+    case 'B':
+        return 1;
+    case 'h':
+    case 'H':
+        return 2;
+    case 'i':
+    case 'I':
+    case 'f':
+        return 4;
+    case 'q':
+    case 'Q':
+    case 'd':
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * \brief Reads a value of the specified size from RDRAM. 8-byte values are composed of two words in the N64's order.
+ */
+static uint64_t load_sized(const uint32_t addr, const size_t size)
+{
+    const auto rdram = (uint8_t *)g_main_ctx.core_ctx->rdram;
+    switch (size)
+    {
+    case 1:
+        return core_rdram_load<uint8_t>(rdram, addr);
+    case 2:
+        return core_rdram_load<uint16_t>(rdram, addr);
+    case 4:
+        return core_rdram_load<uint32_t>(rdram, addr);
+    default:
+        return (uint64_t)core_rdram_load<uint32_t>(rdram, addr) << 32 | core_rdram_load<uint32_t>(rdram, addr + 4);
+    }
+}
+
+/**
+ * \brief Pushes a raw value as the Lua value for the specified type.
+ */
+static void push_typed(lua_State *L, const char type, const uint64_t raw)
+{
+    switch (type)
+    {
+    case 'b':
+        lua_pushinteger(L, (int8_t)raw);
+        break;
+    case 'h':
+        lua_pushinteger(L, (int16_t)raw);
+        break;
+    case 'i':
+        lua_pushinteger(L, (int32_t)raw);
+        break;
+    case 'f':
+        lua_pushnumber(L, std::bit_cast<float>((uint32_t)raw));
+        break;
+    case 'd':
+        lua_pushnumber(L, std::bit_cast<double>(raw));
+        break;
+    default:
+        lua_pushinteger(L, (lua_Integer)raw);
+        break;
+    }
+}
+
+/**
+ * \brief Gets the type character at the given index in the Lua stack. Errors if it's not a valid type.
+ */
+static char check_type(lua_State *L, const int i)
+{
+    const char *str = luaL_checkstring(L, i);
+    if (str[0] == '\0' || str[1] != '\0' || str[0] == 'x' || !get_type_size(str[0]))
+    {
+        luaL_error(L, "Invalid type '%s' at argument %d", str, i);
+    }
+    return str[0];
+}
+
+/**
+ * \brief Parses a memory.readstruct format string into its fields. Errors if the format is invalid.
+ * \param L The Lua state.
+ * \param i The index of the format string in the Lua stack.
+ * \param size Receives the size of the struct in bytes.
+ * \return The type character of every field, including padding.
+ */
+static std::vector<char> check_format(lua_State *L, const int i, size_t &size)
+{
+    const char *format = luaL_checkstring(L, i);
+
+    std::vector<char> fields;
+    size = 0;
+
+    for (const char *p = format; *p;)
+    {
+        size_t repeat = 1;
+        if (isdigit(*p))
+        {
+            repeat = strtoul(p, (char **)&p, 10);
+        }
+
+        if (!get_type_size(*p) || repeat == 0 || repeat > MAX_BULK_LENGTH)
+        {
+            luaL_error(L, "Invalid format '%s' at argument %d", format, i);
+        }
+
+        fields.insert(fields.end(), repeat, *p);
+        size += repeat * get_type_size(*p);
+        ++p;
+    }
+
+    if (size == 0 || size > MAX_BULK_LENGTH)
+    {
+        luaL_error(L, "Invalid format '%s' at argument %d", format, i);
+    }
+
+    return fields;
+}
+
+/**
+ * \brief Reads a struct from RDRAM into a new table on top of the Lua stack.
+ */
+static void push_struct(lua_State *L, uint32_t addr, const std::vector<char> &fields)
+{
+    lua_createtable(L, (int)fields.size(), 0);
+
+    lua_Integer n = 0;
+    for (const char type : fields)
+    {
+        const size_t size = get_type_size(type);
+        if (type != 'x')
+        {
+            push_typed(L, type, load_sized(addr, size));
+            lua_rawseti(L, -2, ++n);
+        }
+        addr += size;
+    }
+}
+
+static int read_range(lua_State *L)
+{
+    const uint32_t addr = luaL_checkinteger(L, 1);
+    const lua_Integer length = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, length >= 0 && (uint64_t)length <= MAX_BULK_LENGTH, 2, "length out of range");
+
+    const auto rdram = (uint8_t *)g_main_ctx.core_ctx->rdram;
+
+    luaL_Buffer buf;
+    const auto dst = (uint8_t *)luaL_buffinitsize(L, &buf, length);
+
+    // Bytes are stored in host order within each word, so whole words are swapped at once.
+    lua_Integer i = 0;
+    for (; i < length && (addr + i) % 4 != 0; ++i)
+    {
+        dst[i] = core_rdram_load<uint8_t>(rdram, addr + i);
+    }
+    for (; i + 4 <= length; i += 4)
+    {
+        const uint32_t word = std::byteswap(core_rdram_load<uint32_t>(rdram, addr + i));
+        memcpy(dst + i, &word, sizeof(word));
+    }
+    for (; i < length; ++i)
+    {
+        dst[i] = core_rdram_load<uint8_t>(rdram, addr + i);
+    }
+
+    luaL_pushresultsize(&buf, length);
+    return 1;
+}
+
+static int write_range(lua_State *L)
+{
+    const uint32_t addr = luaL_checkinteger(L, 1);
+    size_t length;
+    const auto src = (const uint8_t *)luaL_checklstring(L, 2, &length);
+    luaL_argcheck(L, length <= MAX_BULK_LENGTH, 2, "data too long");
+
+    const auto rdram = (uint8_t *)g_main_ctx.core_ctx->rdram;
+
+    size_t i = 0;
+    for (; i < length && (addr + i) % 4 != 0; ++i)
+    {
+        core_rdram_store<uint8_t>(rdram, addr + i, src[i]);
+    }
+    for (; i + 4 <= length; i += 4)
+    {
+        uint32_t word;
+        memcpy(&word, src + i, sizeof(word));
+        core_rdram_store<uint32_t>(rdram, addr + i, std::byteswap(word));
+    }
+    for (; i < length; ++i)
+    {
+        core_rdram_store<uint8_t>(rdram, addr + i, src[i]);
+    }
+
+    return 0;
+}
+
+static int read_array(lua_State *L)
+{
+    const uint32_t addr = luaL_checkinteger(L, 1);
+    const char type = check_type(L, 2);
+    const lua_Integer count = luaL_checkinteger(L, 3);
+    const size_t size = get_type_size(type);
+    const lua_Integer stride = luaL_optinteger(L, 4, size);
+    luaL_argcheck(L, count >= 0 && (uint64_t)count <= MAX_BULK_LENGTH / size, 3, "count out of range");
+
+    lua_createtable(L, (int)count, 0);
+    for (lua_Integer i = 0; i < count; ++i)
+    {
+        push_typed(L, type, load_sized(addr + (uint32_t)(i * stride), size));
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+}
+
+static int read_struct(lua_State *L)
+{
+    const uint32_t addr = luaL_checkinteger(L, 1);
+    size_t size;
+    const auto fields = check_format(L, 2, size);
+
+    if (lua_isnoneornil(L, 3))
+    {
+        push_struct(L, addr, fields);
+        return 1;
+    }
+
+    const lua_Integer count = luaL_checkinteger(L, 3);
+    const lua_Integer stride = luaL_optinteger(L, 4, size);
+    luaL_argcheck(L, count >= 0 && (uint64_t)count <= MAX_BULK_LENGTH / size, 3, "count out of range");
+
+    lua_createtable(L, (int)count, 0);
+    for (lua_Integer i = 0; i < count; ++i)
+    {
+        push_struct(L, addr + (uint32_t)(i * stride), fields);
+        lua_rawseti(L, -2, i + 1);
+    }
+    return 1;
+}
+
+// Watch functions
+
+static int add_watch(lua_State *L)
+{
+    auto lua = LuaManager::get_environment_for_state(L);
+
+    const uint32_t addr = luaL_checkinteger(L, 1);
+    const char type = check_type(L, 2);
+
+    lua->memory_watches.push_back({addr, type, load_sized(addr, get_type_size(type))});
+
+    lua_pushinteger(L, (lua_Integer)lua->memory_watches.size());
+    return 1;
+}
+
+static int clear_watches(lua_State *L)
+{
+    auto lua = LuaManager::get_environment_for_state(L);
+    lua->memory_watches.clear();
+    return 0;
+}
+
+static int get_watches(lua_State *L)
+{
+    auto lua = LuaManager::get_environment_for_state(L);
+
+    // The values are snapshotted by the first call in every VI, so all reads during a frame see the same memory.
+    if (lua->memory_watches_vi != g_vi_count)
+    {
+        for (auto &watch : lua->memory_watches)
+        {
+            watch.value = load_sized(watch.address, get_type_size(watch.type));
+        }
+        lua->memory_watches_vi = g_vi_count;
+    }
+
+    lua_createtable(L, (int)lua->memory_watches.size(), 0);
+    for (size_t i = 0; i < lua->memory_watches.size(); ++i)
+    {
+        const auto &watch = lua->memory_watches[i];
+        push_typed(L, watch.type, watch.value);
+        lua_rawseti(L, -2, (lua_Integer)i + 1);
+    }
+    return 1;
+}
+
 static int recompile(lua_State *L)
 {
     g_main_ctx.core_ctx->vr_recompile(luaL_checkinteger(L, 1));
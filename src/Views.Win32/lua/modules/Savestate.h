@@ -57,6 +57,8 @@ static int do_file(lua_State *L)
             path, job,
             [=](const core_st_callback_info &info, const std::vector<uint8_t> &buf) {
                 g_main_ctx.dispatcher->invoke([=] {
+                    std::lock_guard lock(g_lua_mutex);
+
                     if (!LuaManager::get_environment_for_state(L))
                     {
                         return;
@@ -86,6 +88,8 @@ static int do_slot(lua_State *L)
             get_st_with_slot_path(slot), job,
             [=](const core_st_callback_info &info, const std::vector<uint8_t> &buf) {
                 g_main_ctx.dispatcher->invoke([=] {
+                    std::lock_guard lock(g_lua_mutex);
+
                     if (!LuaManager::get_environment_for_state(L))
                     {
                         return;
@@ -117,6 +121,8 @@ static int do_memory(lua_State *L)
             buffer, job,
             [=](const core_st_callback_info &info, const std::vector<uint8_t> &buf) {
                 g_main_ctx.dispatcher->invoke([=] {
+                    std::lock_guard lock(g_lua_mutex);
+
                     if (!LuaManager::get_environment_for_state(L))
                     {
                         return;
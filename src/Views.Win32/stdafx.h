@@ -57,6 +57,7 @@ extern "C"
 #include <stacktrace>
 #include <expected>
 #include <ranges>
+#include <bit>
 #include <set>
 #include <cwctype>
 #pragma warning pop
@@ -495,6 +495,13 @@ function emu.atseekcompleted(f, unregister) end
 ---@return nil
 function emu.atwarpmodifystatuschanged(f, unregister) end
 
+---Sets whether the script's core event callbacks (`atvi`, `atinput`, `atloadstate`, `atsavestate`, `atreset`, `atplaymovie`, `atstopmovie`, `atseekcompleted` and `atwarpmodifystatuschanged`) run directly on the emulation thread.
+---This avoids a round-trip to the UI thread for every event, which speeds up emulation considerably.
+---Only the `memory` and `joypad` modules and non-UI `emu` functions can be called from such callbacks, all other functions raise an error. Printed text is shown on the next VI.
+---@param enabled boolean Whether direct callbacks are enabled.
+---@return nil
+function emu.set_direct_callbacks(enabled) end
+
 ---Returns the number of VIs since the last movie was played.
 ---This should match the statusbar.
 ---If no movie has been played, it returns the number of VIs since the emulator was started, not reset.
@@ -751,6 +758,57 @@ function memory.writedouble(address, data) end
 ---@return nil
 function memory.writesize(address, size, data) end
 
+---Reads `length` bytes from memory starting at `address` and returns them as a string in the N64's (big-endian) byte order.
+---Use `string.unpack` with a `>` format to decode values from the string.
+---@nodiscard
+---@param address integer
+---@param length integer
+---@return string
+function memory.readrange(address, length) end
+
+---Writes the bytes of `data` to memory starting at `address`, in the N64's (big-endian) byte order.
+---@param address integer
+---@param data string
+---@return nil
+function memory.writerange(address, data) end
+
+---Reads `count` values of `type` starting at `address` and returns them as an array.
+---The type is one of `b`/`B` (signed/unsigned byte), `h`/`H` (word), `i`/`I` (dword), `q`/`Q` (qword), `f` (float) and `d` (double).
+---@nodiscard
+---@param address integer
+---@param type "b"|"B"|"h"|"H"|"i"|"I"|"q"|"Q"|"f"|"d"
+---@param count integer
+---@param stride integer? The distance in bytes between two values. Defaults to the size of `type`.
+---@return number[]
+function memory.readarray(address, type, count, stride) end
+
+---Reads a struct described by `format` at `address` and returns its fields as an array.
+---The format is a sequence of `memory.readarray` type characters and `x` (one byte of padding), each optionally preceded by a repeat count, e.g. `"3fxxxxH"`. Fields are not aligned implicitly.
+---If `count` is specified, `count` structs are read and returned as an array of arrays.
+---@nodiscard
+---@param address integer
+---@param format string
+---@param count integer?
+---@param stride integer? The distance in bytes between two structs. Defaults to the size of the struct.
+---@return number[]|number[][]
+function memory.readstruct(address, format, count, stride) end
+
+---Adds a value of `type` at `address` to the script's watch list and returns its index.
+---@param address integer
+---@param type "b"|"B"|"h"|"H"|"i"|"I"|"q"|"Q"|"f"|"d"
+---@return integer
+function memory.addwatch(address, type) end
+
+---Removes all values from the script's watch list.
+---@return nil
+function memory.clearwatches() end
+
+---Returns the values of the script's watch list, in the order they were added.
+---The values are read once per VI, so all calls during a frame return the same values.
+---@nodiscard
+---@return number[]
+function memory.getwatches() end
+
 ---Queues up a recompilation of the block at the specified address.
 ---@param addr integer
 function memory.recompile(addr) end
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+// Standalone throughput benchmark for PixelConversion. Has no dependencies besides the header, so it also runs on
+// Linux:
+//
+//     g++ -std=c++20 -O2 -Isrc test/bench/pixel_conversion_bench.cpp -o pixel_conversion_bench
+//     ./pixel_conversion_bench [width] [height]
+
+#include <Common/PixelConversion.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+using namespace PixelConversion;
+
+static const char *level_name(const Level level)
+{
+    switch (level)
+    {
+    case Level::SSSE3:
+        return "ssse3";
+    case Level::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+static void run(const char *name, const size_t bytes, const std::function<void()> &func)
+{
+    using clock = std::chrono::steady_clock;
+
+    // Warm up caches and page in the buffers before timing.
+    func();
+
+    size_t iterations = 0;
+    const auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    while (elapsed < std::chrono::milliseconds(500))
+    {
+        func();
+        ++iterations;
+        elapsed = clock::now() - start;
+    }
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf("%-8s %-20s %8.3f ms/frame %10.1f MB/s\n", level_name(get_level()), name, seconds * 1000 / iterations,
+                bytes * iterations / seconds / (1024 * 1024));
+}
+
+int main(const int argc, char **argv)
+{
+    const size_t width = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 3840;
+    const size_t height = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2160;
+    const size_t pixels = width * height;
+    const size_t chroma_size = ((width + 1) / 2) * ((height + 1) / 2);
+
+    std::printf("%zux%zu, detected level: %s\n", width, height, level_name(get_level()));
+
+    std::vector<uint8_t> rgb(pixels * 3);
+    std::vector<uint8_t> rgb_out(pixels * 3);
+    std::vector<uint8_t> rgba(pixels * 4);
+    std::vector<uint8_t> y(pixels), u(chroma_size), v(chroma_size), uv(chroma_size * 2);
+    for (size_t i = 0; i < rgb.size(); ++i)
+    {
+        rgb[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    for (const auto level : {Level::Scalar, Level::SSSE3, Level::AVX2})
+    {
+        set_level(level);
+        if (get_level() != level)
+        {
+            continue;
+        }
+
+        run("rgb24_to_rgba32", pixels * 3, [&] { rgb24_to_rgba32(rgb.data(), rgba.data(), pixels); });
+        run("rgba32_to_rgb24", pixels * 4, [&] { rgba32_to_rgb24(rgba.data(), rgb_out.data(), pixels); });
+        run("swap_rb24", pixels * 3, [&] { swap_rb24(rgb.data(), rgb_out.data(), pixels); });
+    }
+
+    run("flip_vertical", pixels * 3, [&] { flip_vertical(rgb_out.data(), width * 3, height); });
+    run("rgb24_to_i420", pixels * 3,
+        [&] { rgb24_to_i420(rgb.data(), width, height, ByteOrder::BGR, true, y.data(), u.data(), v.data()); });
+    run("rgb24_to_nv12", pixels * 3,
+        [&] { rgb24_to_nv12(rgb.data(), width, height, ByteOrder::BGR, true, y.data(), uv.data()); });
+
+    return 0;
+}
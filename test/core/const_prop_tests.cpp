@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <stdafx.h>
+#include <random>
+#include <Core/r4300/const_prop.h>
+#include <Core/r4300/r4300.h>
+#include <Core/r4300/recomp.h>
+
+extern void (*interp_ops[])(void);
+
+static const uint32_t SPECIAL_FUNCTS[] = {0x00, 0x02, 0x03, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x2A, 0x2B};
+
+/**
+ * \brief Generates an arithmetic instruction tracked by the analysis. Results go to a few GPRs, including k0 which is
+ * never tracked, so values get overwritten and read often.
+ */
+static uint32_t random_alu(std::mt19937 &rng)
+{
+    static const uint32_t dests[] = {1, 2, 3, 4, 5, 26};
+    const uint32_t rs = rng() % 6;
+    const uint32_t rt = rng() % 6;
+    const uint32_t dest = dests[rng() % std::size(dests)];
+
+    if (rng() % 2)
+    {
+        const uint32_t funct = SPECIAL_FUNCTS[rng() % std::size(SPECIAL_FUNCTS)];
+        return (rs << 21) | (rt << 16) | (dest << 11) | ((rng() % 32) << 6) | funct;
+    }
+    return ((8 + rng() % 8) << 26) | (rs << 21) | (dest << 16) | (rng() & 0xFFFF);
+}
+
+/**
+ * \brief Runs an instruction through the pure interpreter.
+ */
+static void interpret(const uint32_t op)
+{
+    static precomp_instr instr;
+
+    dynacore = 0;
+    PC = &instr;
+    vr_op = op;
+    prefetch_opcode(op);
+    interp_ops[(op >> 26) & 0x3F]();
+}
+
+/**
+ * \brief Fills the GPRs with random values, which aren't necessarily sign-extended.
+ */
+static void randomize_gprs(std::mt19937 &rng)
+{
+    reg[0] = 0;
+    for (size_t i = 1; i < 32; ++i)
+    {
+        reg[i] = (int64_t)(((uint64_t)rng() << 32) | rng());
+    }
+}
+
+TEST_CASE("known_gprs_match_interpreter", "const_prop")
+{
+    std::mt19937 rng(1234);
+
+    for (size_t run = 0; run < 500; ++run)
+    {
+        randomize_gprs(rng);
+
+        const_state state;
+        const_prop_reset(state);
+
+        for (size_t i = 0; i < 32; ++i)
+        {
+            const uint32_t op = random_alu(rng);
+            const_prop_step(state, op);
+            interpret(op);
+
+            REQUIRE_FALSE(state.known & (1 << 26));
+            for (size_t gpr = 0; gpr < 32; ++gpr)
+            {
+                if (state.known >> gpr & 1) REQUIRE(reg[gpr] == (int64_t)state.values[gpr]);
+            }
+        }
+    }
+}
+
+TEST_CASE("control_and_memory_instructions_forget_written_gprs", "const_prop")
+{
+    const_state state;
+    const_prop_reset(state);
+    const_prop_step(state, 0x3C011234); // LUI at, 0x1234
+    const_prop_step(state, 0x3C1F5678); // LUI ra, 0x5678
+
+    REQUIRE(state.known == ((1 << 0) | (1 << 1) | (1u << 31)));
+
+    const_prop_step(state, 0x0C000000); // JAL
+    REQUIRE(state.known == ((1 << 0) | (1 << 1)));
+
+    const_prop_step(state, 0xAC010000); // SW at, 0(zero)
+    REQUIRE(state.known == ((1 << 0) | (1 << 1)));
+
+    const_prop_step(state, 0x8C010000); // LW at, 0(zero)
+    REQUIRE(state.known == (1 << 0));
+}
+
+TEST_CASE("dead_writes_dont_change_results", "const_prop")
+{
+    std::mt19937 rng(5678);
+
+    for (size_t run = 0; run < 500; ++run)
+    {
+        int32_t code[16];
+        for (auto &op : code)
+        {
+            op = (int32_t)random_alu(rng);
+        }
+
+        randomize_gprs(rng);
+        int64_t initial[32];
+        memcpy(initial, reg, sizeof(initial));
+
+        for (const int32_t op : code)
+        {
+            interpret(op);
+        }
+        int64_t expected[32];
+        memcpy(expected, reg, sizeof(expected));
+
+        for (int32_t i = 0; i < (int32_t)std::size(code); ++i)
+        {
+            const int32_t count = std::min((int32_t)std::size(code) - i, 8);
+            if (!const_prop_is_dead(code + i, count)) continue;
+
+            memcpy(reg, initial, sizeof(initial));
+            for (int32_t j = 0; j < (int32_t)std::size(code); ++j)
+            {
+                if (j != i) interpret(code[j]);
+            }
+            REQUIRE(memcmp(reg, expected, sizeof(expected)) == 0);
+        }
+    }
+}
+
+TEST_CASE("branch_targets_are_found_in_page", "const_prop")
+{
+    int32_t code[0x1000 / 4] = {};
+    code[0] = 0x10000003;                                   // BEQ zero, zero, +3
+    code[1] = 0x08000000 | ((0x80001010 >> 2) & 0x3FFFFFF); // J 0x80001010
+    code[2] = 0x1000FFFD;                                   // BEQ zero, zero, -3
+    code[3] = 0x08000000 | ((0x80002000 >> 2) & 0x3FFFFFF); // J into the next page
+
+    uint32_t targets[0x1000 / 4 / 32];
+    const_prop_find_targets(code, 0x80001000, (int32_t)std::size(code), targets);
+
+    REQUIRE(targets[0] == ((1 << 0) | (1 << 4)));
+    for (size_t i = 1; i < std::size(targets); ++i)
+    {
+        REQUIRE(targets[i] == 0);
+    }
+}
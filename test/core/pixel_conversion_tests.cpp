@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <stdafx.h>
+#include <Common/PixelConversion.h>
+#include "test_helpers.h"
+
+using namespace PixelConversion;
+
+// Pixel counts covering empty input, pure tails, and SIMD bodies followed by every possible tail length.
+static constexpr size_t PIXEL_COUNTS[] = {0, 1, 3, 5, 6, 7, 9, 10, 11, 17, 64, 67, 1023};
+
+/**
+ * \brief Runs a check once for every instruction set level supported by the CPU.
+ */
+template <typename TFunc>
+static void for_each_level(const TFunc &func)
+{
+    for (const auto level : {Level::Scalar, Level::SSSE3, Level::AVX2})
+    {
+        set_level(level);
+        func();
+    }
+    set_level(Level::AVX2);
+}
+
+TEST_CASE("rgb24_to_rgba32_expands_and_sets_alpha", "pixel_conversion")
+{
+    for_each_level([] {
+        for (const auto pixels : PIXEL_COUNTS)
+        {
+            const auto src = make_pattern(pixels * 3);
+            std::vector<uint8_t> dst(pixels * 4 + 1, 0xCC);
+
+            rgb24_to_rgba32(src.data(), dst.data(), pixels, 0x7F);
+
+            for (size_t i = 0; i < pixels; ++i)
+            {
+                REQUIRE(dst[i * 4] == src[i * 3]);
+                REQUIRE(dst[i * 4 + 1] == src[i * 3 + 1]);
+                REQUIRE(dst[i * 4 + 2] == src[i * 3 + 2]);
+                REQUIRE(dst[i * 4 + 3] == 0x7F);
+            }
+            REQUIRE(dst[pixels * 4] == 0xCC);
+        }
+    });
+}
+
+TEST_CASE("rgba32_to_rgb24_roundtrips", "pixel_conversion")
+{
+    for_each_level([] {
+        for (const auto pixels : PIXEL_COUNTS)
+        {
+            const auto src = make_pattern(pixels * 3);
+            std::vector<uint8_t> rgba(pixels * 4);
+            std::vector<uint8_t> dst(pixels * 3 + 1, 0xCC);
+
+            rgb24_to_rgba32(src.data(), rgba.data(), pixels);
+            rgba32_to_rgb24(rgba.data(), dst.data(), pixels);
+
+            REQUIRE(std::equal(src.begin(), src.end(), dst.begin()));
+            REQUIRE(dst[pixels * 3] == 0xCC);
+        }
+    });
+}
+
+TEST_CASE("swap_rb24_swaps_in_place_and_out_of_place", "pixel_conversion")
+{
+    for_each_level([] {
+        for (const auto pixels : PIXEL_COUNTS)
+        {
+            const auto src = make_pattern(pixels * 3);
+            std::vector<uint8_t> dst(pixels * 3 + 1, 0xCC);
+            auto in_place = src;
+
+            swap_rb24(src.data(), dst.data(), pixels);
+            swap_rb24(in_place.data(), in_place.data(), pixels);
+
+            for (size_t i = 0; i < pixels; ++i)
+            {
+                REQUIRE(dst[i * 3] == src[i * 3 + 2]);
+                REQUIRE(dst[i * 3 + 1] == src[i * 3 + 1]);
+                REQUIRE(dst[i * 3 + 2] == src[i * 3]);
+            }
+            REQUIRE(std::equal(in_place.begin(), in_place.end(), dst.begin()));
+            REQUIRE(dst[pixels * 3] == 0xCC);
+        }
+    });
+}
+
+TEST_CASE("flip_vertical_reverses_rows", "pixel_conversion")
+{
+    for (const size_t height : {0, 1, 2, 5})
+    {
+        const size_t stride = 7;
+        const auto src = make_pattern(stride * height);
+        auto buf = src;
+
+        flip_vertical(buf.data(), stride, height);
+
+        for (size_t y = 0; y < height; ++y)
+        {
+            REQUIRE(std::equal(buf.begin() + y * stride, buf.begin() + (y + 1) * stride,
+                               src.begin() + (height - 1 - y) * stride));
+        }
+    }
+}
+
+TEST_CASE("rgb24_to_i420_matches_bt601_reference", "pixel_conversion")
+{
+    // 2x2 white and black blocks side by side, in BGR order.
+    const uint8_t src[] = {
+        255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, //
+        255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, //
+    };
+    uint8_t y[8]{}, u[2]{}, v[2]{};
+
+    rgb24_to_i420(src, 4, 2, ByteOrder::BGR, false, y, u, v);
+
+    for (size_t row = 0; row < 2; ++row)
+    {
+        REQUIRE(y[row * 4] == 235);
+        REQUIRE(y[row * 4 + 1] == 235);
+        REQUIRE(y[row * 4 + 2] == 16);
+        REQUIRE(y[row * 4 + 3] == 16);
+    }
+    REQUIRE(u[0] == 128);
+    REQUIRE(v[0] == 128);
+    REQUIRE(u[1] == 128);
+    REQUIRE(v[1] == 128);
+}
+
+TEST_CASE("rgb24_to_nv12_interleaves_i420_chroma", "pixel_conversion")
+{
+    for (const auto order : {ByteOrder::RGB, ByteOrder::BGR})
+    {
+        // Odd dimensions exercise the edge replication.
+        const size_t width = 5, height = 3;
+        const size_t chroma_size = ((width + 1) / 2) * ((height + 1) / 2);
+        const auto src = make_pattern(width * height * 3);
+
+        std::vector<uint8_t> y_i420(width * height), u(chroma_size), v(chroma_size);
+        std::vector<uint8_t> y_nv12(width * height), uv(chroma_size * 2);
+
+        rgb24_to_i420(src.data(), width, height, order, false, y_i420.data(), u.data(), v.data());
+        rgb24_to_nv12(src.data(), width, height, order, false, y_nv12.data(), uv.data());
+
+        REQUIRE(y_i420 == y_nv12);
+        for (size_t i = 0; i < chroma_size; ++i)
+        {
+            REQUIRE(uv[i * 2] == u[i]);
+            REQUIRE(uv[i * 2 + 1] == v[i]);
+        }
+    }
+}
+
+TEST_CASE("rgb24_to_yuv420_flips_bottom_up_sources", "pixel_conversion")
+{
+    for (const auto [width, height] : {std::pair<size_t, size_t>{4, 4}, {5, 3}, {7, 1}})
+    {
+        const size_t chroma_size = ((width + 1) / 2) * ((height + 1) / 2);
+        const auto src = make_pattern(width * height * 3);
+        auto flipped = src;
+        flip_vertical(flipped.data(), width * 3, height);
+
+        std::vector<uint8_t> y(width * height), u(chroma_size), v(chroma_size), uv(chroma_size * 2);
+        std::vector<uint8_t> y_ref(width * height), u_ref(chroma_size), v_ref(chroma_size), uv_ref(chroma_size * 2);
+
+        rgb24_to_i420(src.data(), width, height, ByteOrder::BGR, true, y.data(), u.data(), v.data());
+        rgb24_to_i420(flipped.data(), width, height, ByteOrder::BGR, false, y_ref.data(), u_ref.data(), v_ref.data());
+
+        REQUIRE(y == y_ref);
+        REQUIRE(u == u_ref);
+        REQUIRE(v == v_ref);
+
+        rgb24_to_nv12(src.data(), width, height, ByteOrder::BGR, true, y.data(), uv.data());
+        rgb24_to_nv12(flipped.data(), width, height, ByteOrder::BGR, false, y_ref.data(), uv_ref.data());
+
+        REQUIRE(y == y_ref);
+        REQUIRE(uv == uv_ref);
+    }
+}
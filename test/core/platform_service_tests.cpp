@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <stdafx.h>
+#include <Common/PlatformService.h>
+#include "test_helpers.h"
+
+static std::filesystem::path temp_file(const std::wstring &name, std::vector<uint8_t> data)
+{
+    const auto path = std::filesystem::temp_directory_path() / name;
+    PlatformService().write_file_buffer(path, data);
+    return path;
+}
+
+TEST_CASE("xxh64_stream_matches_single_shot_hash", "platform_service")
+{
+    const auto data = make_pattern(1000);
+
+    for (const size_t size : {0, 1, 7, 31, 32, 33, 100, 1000})
+    {
+        for (const size_t piece : {1, 5, 32, 64})
+        {
+            XXH64Stream hasher(42);
+            for (size_t i = 0; i < size; i += piece)
+            {
+                hasher.update(data.data() + i, std::min(piece, size - i));
+            }
+            REQUIRE(hasher.digest() == xxh64::hash((const char *)data.data(), size, 42));
+        }
+    }
+}
+
+TEST_CASE("find_first_difference_reports_offset", "platform_service")
+{
+    PlatformService service;
+
+    // Spans several chunks so differences past the first chunk boundary are exercised.
+    const size_t size = PlatformService::FILE_CHUNK_SIZE * 2 + 123;
+    const auto data = make_pattern(size);
+
+    auto changed = data;
+    changed[PlatformService::FILE_CHUNK_SIZE + 5] ^= 0xFF;
+
+    auto truncated = data;
+    truncated.resize(size - 10);
+
+    const auto a = temp_file(L"m64p_cmp_a.bin", data);
+    const auto b = temp_file(L"m64p_cmp_b.bin", data);
+    const auto c = temp_file(L"m64p_cmp_c.bin", changed);
+    const auto d = temp_file(L"m64p_cmp_d.bin", truncated);
+
+    REQUIRE_FALSE(service.find_first_difference(a, b).has_value());
+    REQUIRE(service.files_are_equal(a, b));
+    REQUIRE(service.find_first_difference(a, c) == PlatformService::FILE_CHUNK_SIZE + 5);
+    REQUIRE_FALSE(service.files_are_equal(a, c));
+    REQUIRE(service.find_first_difference(a, d) == size - 10);
+    REQUIRE(service.find_first_difference(d, a) == size - 10);
+    REQUIRE(service.find_first_difference(a, L"m64p_cmp_missing.bin") == 0);
+
+    XXH64Stream hasher;
+    hasher.update(data.data(), data.size());
+    REQUIRE(service.hash_file(a) == hasher.digest());
+    REQUIRE(service.hash_file(a) != service.hash_file(c));
+    REQUIRE_FALSE(service.hash_file(L"m64p_cmp_missing.bin").has_value());
+
+    for (const auto &path : {a, b, c, d})
+    {
+        std::filesystem::remove(path);
+    }
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <stdafx.h>
+#include <Core/memory/memory.h>
+#include <Core/r4300/synclog.h>
+#include <Core/r4300/vcr.h>
+
+static core_cfg cfg{};
+static core_params params{};
+static core_ctx *ctx = nullptr;
+static PlatformService io_helper_service{};
+
+/**
+ * \brief Initializes the core parameters sl_load depends on.
+ */
+static void prepare_test()
+{
+    cfg = {};
+    params.cfg = &cfg;
+    params.io_service = &io_helper_service;
+    core_create(&params, &ctx);
+}
+
+/**
+ * \brief Builds a log with one checkpoint every 10 samples. The first checkpoint contains every section, later ones
+ * change the CPU section and one RDRAM page.
+ */
+static core_sl_log make_log(const size_t count)
+{
+    core_sl_log log{.interval = 10};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        core_sl_entry entry{.sample = i * 10};
+        if (i == 0)
+        {
+            for (uint16_t section = 0; section < core_sl_section_count; ++section)
+            {
+                entry.changes.emplace_back(section, section);
+            }
+        }
+        else
+        {
+            entry.changes.emplace_back(core_sl_section_cpu, 1000 + i);
+            entry.changes.emplace_back((uint16_t)i, 2000 + i);
+        }
+        log.entries.emplace_back(std::move(entry));
+    }
+    return log;
+}
+
+template <typename T> static void append(std::vector<uint8_t> &buf, const T &value)
+{
+    const auto bytes = (const uint8_t *)&value;
+    buf.insert(buf.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * \brief Serializes a log in the sync log file format.
+ */
+static std::vector<uint8_t> serialize(const core_sl_log &log)
+{
+    std::vector<uint8_t> buf;
+    append(buf, (uint32_t)0x474F4C53);
+    append(buf, (uint32_t)1);
+    append(buf, log.interval);
+    append(buf, (uint32_t)log.entries.size());
+    for (const auto &entry : log.entries)
+    {
+        append(buf, entry.sample);
+        append(buf, (uint32_t)entry.changes.size());
+        for (const auto &[section, hash] : entry.changes)
+        {
+            append(buf, section);
+            append(buf, hash);
+        }
+    }
+    return buf;
+}
+
+/**
+ * \brief Takes a checkpoint at the specified sample of a movie being played back.
+ */
+static void take_checkpoint(const uint32_t sample)
+{
+    vcr.task = task_playback;
+    vcr.current_sample = sample;
+    sl_on_input_poll();
+}
+
+static std::filesystem::path temp_file(const std::wstring &name, std::vector<uint8_t> data)
+{
+    const auto path = std::filesystem::temp_directory_path() / name;
+    PlatformService().write_file_buffer(path, data);
+    return path;
+}
+
+TEST_CASE("identical_logs_dont_diverge", "sl_find_divergence")
+{
+    const auto log = make_log(8);
+    const auto divergence = sl_find_divergence(log, log);
+
+    REQUIRE(divergence.sample == SIZE_MAX);
+    REQUIRE(divergence.sections.empty());
+}
+
+TEST_CASE("first_divergent_entry_is_reported", "sl_find_divergence")
+{
+    const auto first = make_log(8);
+    auto second = make_log(8);
+
+    // The change is only recorded in the entry's delta, so it must carry over to all later checkpoints. Only the first
+    // one is reported.
+    second.entries[3].changes[1].second ^= 1;
+    second.entries[5].changes[0].second ^= 1;
+
+    const auto divergence = sl_find_divergence(first, second);
+
+    REQUIRE(divergence.sample == 30);
+    REQUIRE(divergence.sections == std::vector<uint16_t>{3});
+}
+
+TEST_CASE("every_differing_section_is_reported", "sl_find_divergence")
+{
+    const auto first = make_log(4);
+    auto second = make_log(4);
+
+    second.entries[2].changes[0].second ^= 1;
+    second.entries[2].changes[1].second ^= 1;
+
+    const auto divergence = sl_find_divergence(first, second);
+
+    REQUIRE(divergence.sample == 20);
+    REQUIRE(divergence.sections == std::vector<uint16_t>{2, core_sl_section_cpu});
+}
+
+TEST_CASE("length_mismatch_only_compares_common_samples", "sl_find_divergence")
+{
+    const auto longer = make_log(8);
+    auto shorter = make_log(4);
+
+    REQUIRE(sl_find_divergence(longer, shorter).sample == SIZE_MAX);
+    REQUIRE(sl_find_divergence(shorter, longer).sample == SIZE_MAX);
+
+    shorter.entries.back().changes[0].second ^= 1;
+
+    REQUIRE(sl_find_divergence(longer, shorter).sample == 30);
+    REQUIRE(sl_find_divergence(shorter, longer).sample == 30);
+}
+
+TEST_CASE("samples_missing_from_one_log_still_apply", "sl_find_divergence")
+{
+    const auto first = make_log(8);
+
+    // A log with half the entries, whose skipped entries are merged into the next one.
+    core_sl_log second{.interval = 20};
+    for (size_t i = 0; i < first.entries.size(); i += 2)
+    {
+        auto entry = first.entries[i];
+        if (i > 0)
+        {
+            const auto &skipped = first.entries[i - 1].changes;
+            entry.changes.insert(entry.changes.begin(), skipped.begin(), skipped.end());
+        }
+        second.entries.emplace_back(std::move(entry));
+    }
+
+    REQUIRE(sl_find_divergence(first, second).sample == SIZE_MAX);
+
+    // Sample 50 isn't in the second log, so a change there first shows up at sample 60.
+    auto changed = first;
+    changed.entries[5].changes[1].second ^= 1;
+
+    const auto divergence = sl_find_divergence(changed, second);
+    REQUIRE(divergence.sample == 60);
+    REQUIRE(divergence.sections == std::vector<uint16_t>{5});
+}
+
+TEST_CASE("load_reads_serialized_log", "sl_load")
+{
+    prepare_test();
+
+    const auto expected = make_log(5);
+    const auto path = temp_file(L"m64p_sl_valid.bin", serialize(expected));
+
+    core_sl_log log{};
+    REQUIRE(sl_load(path, log));
+
+    REQUIRE(log.interval == expected.interval);
+    REQUIRE(log.entries.size() == expected.entries.size());
+    for (size_t i = 0; i < log.entries.size(); ++i)
+    {
+        REQUIRE(log.entries[i].sample == expected.entries[i].sample);
+        REQUIRE(log.entries[i].changes == expected.entries[i].changes);
+    }
+    REQUIRE(sl_find_divergence(log, expected).sample == SIZE_MAX);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("load_rejects_invalid_files", "sl_load")
+{
+    prepare_test();
+
+    const auto valid = serialize(make_log(3));
+
+    auto bad_magic = valid;
+    bad_magic[0] ^= 0xFF;
+
+    auto bad_version = valid;
+    bad_version[4] ^= 0xFF;
+
+    auto truncated = valid;
+    truncated.resize(truncated.size() - 1);
+
+    // Claims far more changes than the file holds.
+    auto bad_change_count = valid;
+    bad_change_count[20] = 0xFF;
+    bad_change_count[21] = 0xFF;
+
+    for (const auto &data : {std::vector<uint8_t>{}, bad_magic, bad_version, truncated, bad_change_count})
+    {
+        const auto path = temp_file(L"m64p_sl_invalid.bin", data);
+
+        core_sl_log log{.interval = 123};
+        REQUIRE_FALSE(sl_load(path, log));
+        REQUIRE(log.interval == 123);
+        REQUIRE(log.entries.empty());
+
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("reference_divergence_is_found_when_taken", "sl_set_reference")
+{
+    prepare_test();
+
+    sl_start(1);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        take_checkpoint(i);
+    }
+    core_sl_log reference{};
+    sl_get_log(reference);
+
+    sl_start(1);
+    sl_set_reference(reference);
+    take_checkpoint(0);
+    take_checkpoint(1);
+    REQUIRE(sl_get_divergence().sample == SIZE_MAX);
+
+    rdram[0] ^= 1;
+    take_checkpoint(2);
+
+    const auto divergence = sl_get_divergence();
+    REQUIRE(divergence.sample == 2);
+    REQUIRE(divergence.sections == std::vector<uint16_t>{0});
+
+    // Rewinding before the divergence discards it, so it isn't reported once the state matches again.
+    rdram[0] ^= 1;
+    take_checkpoint(1);
+    REQUIRE(sl_get_divergence().sample == SIZE_MAX);
+    take_checkpoint(2);
+    take_checkpoint(3);
+    REQUIRE(sl_get_divergence().sample == SIZE_MAX);
+
+    sl_stop();
+    vcr.task = task_idle;
+}
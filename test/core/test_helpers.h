@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#pragma once
+
+/**
+ * \brief Builds a buffer filled with a byte pattern that doesn't repeat within 256 bytes.
+ */
+inline std::vector<uint8_t> make_pattern(const size_t size)
+{
+    std::vector<uint8_t> buf(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        buf[i] = (uint8_t)(i * 37 + 11);
+    }
+    return buf;
+}
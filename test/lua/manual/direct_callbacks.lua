@@ -0,0 +1,59 @@
+--
+-- Copyright (c) 2025, Mupen64 maintainers, contributors, and original authors (Hacktarux, ShadowPrince, linker).
+--
+-- SPDX-License-Identifier: GPL-2.0-or-later
+--
+
+-- Start a ROM, then start the script, and ensure that:
+-- 1. "atvi dispatched" and "atinput dispatched" are each printed once
+-- 2. "input count advances" is printed once
+-- 3. "ui function blocked" is printed once
+-- 4. "ui callback dispatched" is printed once
+-- 5. No other errors are printed and the script keeps running
+
+dofile(debug.getinfo(1).source:sub(2):gsub("\\[^\\]+\\[^\\]+$", "") .. '\\test_prelude.lua')
+
+emu.set_direct_callbacks(true)
+
+local vi_seen = false
+local input_seen = false
+local first_input_count
+local ui_checked = false
+
+emu.atvi(function()
+    if not vi_seen then
+        vi_seen = true
+        print("atvi dispatched")
+    end
+
+    if not ui_checked then
+        ui_checked = true
+        local ok = pcall(function() input.get_key_name_text(string.byte('W')) end)
+        if not ok then
+            print("ui function blocked")
+        end
+    end
+end)
+
+emu.atinput(function()
+    if not input_seen then
+        input_seen = true
+        first_input_count = emu.inputcount()
+        print("atinput dispatched")
+        return
+    end
+
+    if first_input_count and emu.inputcount() > first_input_count then
+        first_input_count = nil
+        print("input count advances")
+    end
+end)
+
+-- Callbacks which can't run directly still run on the UI thread.
+local interval_seen = false
+emu.atinterval(function()
+    if not interval_seen then
+        interval_seen = true
+        print("ui callback dispatched")
+    end
+end)
@@ -236,6 +236,148 @@ lust.describe('mupen64', function()
         end)
     end)
 
+    lust.describe('emu', function()
+        lust.describe('set_direct_callbacks', function()
+            lust.after(function()
+                emu.set_direct_callbacks(false)
+            end)
+            lust.it('accepts_booleans', function()
+                lust.expect(function() emu.set_direct_callbacks(true) end).to_not.fail()
+                lust.expect(function() emu.set_direct_callbacks(true) end).to_not.fail()
+                lust.expect(function() emu.set_direct_callbacks(false) end).to_not.fail()
+            end)
+            lust.it('errors_if_argument_not_boolean', function()
+                lust.expect(function() emu.set_direct_callbacks(nil) end).to.fail()
+                lust.expect(function() emu.set_direct_callbacks(1) end).to.fail()
+                lust.expect(function() emu.set_direct_callbacks("true") end).to.fail()
+            end)
+            lust.it('keeps_callbacks_registered_across_toggles', function()
+                local func = function() end
+                emu.atvi(func)
+                emu.atinput(func)
+                emu.set_direct_callbacks(true)
+                emu.atloadstate(func)
+                emu.set_direct_callbacks(false)
+
+                lust.expect(function() emu.atvi(func, true) end).to_not.fail()
+                lust.expect(function() emu.atinput(func, true) end).to_not.fail()
+                lust.expect(function() emu.atloadstate(func, true) end).to_not.fail()
+            end)
+            lust.it('unregistering_with_direct_callbacks_enabled_works', function()
+                local func = function() end
+                emu.atvi(func)
+                emu.set_direct_callbacks(true)
+                lust.expect(function() emu.atvi(func, true) end).to_not.fail()
+            end)
+            lust.it('ui_functions_callable_on_ui_thread', function()
+                emu.set_direct_callbacks(true)
+                lust.expect(input.get_key_name_text(string.byte('W'))).to.equal("W")
+            end)
+            lust.it('non_ui_functions_unchanged', function()
+                emu.set_direct_callbacks(true)
+                lust.expect(type(emu.inputcount())).to.equal("number")
+                lust.expect(type(emu.framecount())).to.equal("number")
+            end)
+        end)
+    end)
+
+    lust.describe('memory', function()
+        local address = 0x80100000
+
+        lust.describe('readrange', function()
+            lust.it('returns_written_bytes', function()
+                memory.writerange(address + 1, "\x01\x02\x03\x04\x05\x06")
+                lust.expect(memory.readrange(address + 1, 6)).to.equal("\x01\x02\x03\x04\x05\x06")
+            end)
+            lust.it('returns_bytes_in_big_endian_order', function()
+                memory.writedword(address, 0x11223344)
+                lust.expect(memory.readrange(address, 4)).to.equal("\x11\x22\x33\x44")
+            end)
+            lust.it('returns_empty_string_for_zero_length', function()
+                lust.expect(memory.readrange(address, 0)).to.equal("")
+            end)
+            lust.it('errors_if_length_negative', function()
+                lust.expect(function() memory.readrange(address, -1) end).to.fail()
+            end)
+            lust.it('errors_if_length_too_large', function()
+                lust.expect(function() memory.readrange(address, 0x800001) end).to.fail()
+                lust.expect(function() memory.readrange(address, 0x100000001) end).to.fail()
+            end)
+        end)
+        lust.describe('readarray', function()
+            lust.it('returns_values', function()
+                memory.writerange(address, "\xFF\x01\x80\x00")
+                local values = memory.readarray(address, "b", 4)
+                lust.expect(#values).to.equal(4)
+                lust.expect(values[1]).to.equal(-1)
+                lust.expect(values[2]).to.equal(1)
+                lust.expect(values[3]).to.equal(-128)
+                lust.expect(values[4]).to.equal(0)
+            end)
+            lust.it('respects_stride', function()
+                memory.writerange(address, "\x00\x01\x00\x02\x00\x03\x00\x04")
+                local values = memory.readarray(address, "H", 2, 4)
+                lust.expect(values[1]).to.equal(1)
+                lust.expect(values[2]).to.equal(3)
+            end)
+            lust.it('returns_empty_table_for_zero_count', function()
+                lust.expect(#memory.readarray(address, "I", 0)).to.equal(0)
+            end)
+            lust.it('errors_if_type_invalid', function()
+                lust.expect(function() memory.readarray(address, "x", 1) end).to.fail()
+                lust.expect(function() memory.readarray(address, "bb", 1) end).to.fail()
+            end)
+            lust.it('errors_if_count_negative', function()
+                lust.expect(function() memory.readarray(address, "B", -1) end).to.fail()
+            end)
+            lust.it('errors_if_count_too_large', function()
+                lust.expect(function() memory.readarray(address, "Q", 0x100001) end).to.fail()
+            end)
+            lust.it('errors_if_count_times_size_overflows', function()
+                lust.expect(function() memory.readarray(address, "Q", 0x20000000) end).to.fail()
+                lust.expect(function() memory.readarray(address, "B", 0x100000001) end).to.fail()
+            end)
+        end)
+        lust.describe('readstruct', function()
+            lust.it('returns_fields_and_skips_padding', function()
+                memory.writerange(address, "\xFF\x00\x00\x12\x34\x00\x00\x00\x05")
+                local fields = memory.readstruct(address, "b2xHI")
+                lust.expect(#fields).to.equal(3)
+                lust.expect(fields[1]).to.equal(-1)
+                lust.expect(fields[2]).to.equal(0x1234)
+                lust.expect(fields[3]).to.equal(5)
+            end)
+            lust.it('returns_array_of_structs_with_count', function()
+                memory.writerange(address, "\x01\x02\x03\x04")
+                local structs = memory.readstruct(address, "BB", 2)
+                lust.expect(#structs).to.equal(2)
+                lust.expect(structs[1][1]).to.equal(1)
+                lust.expect(structs[1][2]).to.equal(2)
+                lust.expect(structs[2][1]).to.equal(3)
+                lust.expect(structs[2][2]).to.equal(4)
+            end)
+            lust.it('respects_stride', function()
+                memory.writerange(address, "\x01\x02\x03\x04")
+                local structs = memory.readstruct(address, "B", 2, 3)
+                lust.expect(structs[1][1]).to.equal(1)
+                lust.expect(structs[2][1]).to.equal(4)
+            end)
+            lust.it('errors_if_format_invalid', function()
+                lust.expect(function() memory.readstruct(address, "") end).to.fail()
+                lust.expect(function() memory.readstruct(address, "z") end).to.fail()
+                lust.expect(function() memory.readstruct(address, "0B") end).to.fail()
+                lust.expect(function() memory.readstruct(address, "8388609B") end).to.fail()
+            end)
+            lust.it('errors_if_count_negative', function()
+                lust.expect(function() memory.readstruct(address, "B", -1) end).to.fail()
+            end)
+            lust.it('errors_if_count_times_size_overflows', function()
+                lust.expect(function() memory.readstruct(address, "QQ", 0x10000000) end).to.fail()
+                lust.expect(function() memory.readstruct(address, "B", 0x100000001) end).to.fail()
+            end)
+        end)
+    end)
+
     lust.describe('input', function()
         lust.describe('get_key_name_text', function()
             -- NOTE: This test only works on an en-us locale.